@@ -0,0 +1,49 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include "lc_actionmodifybreakatintersections.h"
+#include "rs_debug.h"
+#include "rs_dialogfactory.h"
+#include "rs_modification.h"
+
+LC_ActionModifyBreakAtIntersections::LC_ActionModifyBreakAtIntersections(RS_EntityContainer& container,
+                                                                         RS_GraphicView& graphicView)
+    :RS_ActionInterface("Break at intersections", container, graphicView)
+{
+}
+
+void LC_ActionModifyBreakAtIntersections::trigger() {
+    RS_DEBUG->print("LC_ActionModifyBreakAtIntersections::trigger");
+
+    RS_Modification m(*container, graphicView);
+    if (!m.breakAtIntersections())
+        RS_DIALOGFACTORY->commandMessage(tr("No intersections found between the selected entities"));
+    finish(false);
+}
+
+void LC_ActionModifyBreakAtIntersections::init(int status) {
+    RS_ActionInterface::init(status);
+    trigger();
+}
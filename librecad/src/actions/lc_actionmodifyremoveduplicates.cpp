@@ -0,0 +1,70 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <QElapsedTimer>
+
+#include "lc_actionmodifyremoveduplicates.h"
+#include "rs_debug.h"
+#include "rs_dialogfactory.h"
+#include "rs_modification.h"
+#include "rs_settings.h"
+
+LC_ActionModifyRemoveDuplicates::LC_ActionModifyRemoveDuplicates(RS_EntityContainer& container,
+                                                                 RS_GraphicView& graphicView)
+    :RS_ActionInterface("Remove duplicates", container, graphicView)
+{
+}
+
+void LC_ActionModifyRemoveDuplicates::trigger() {
+    RS_DEBUG->print("LC_ActionModifyRemoveDuplicates::trigger");
+
+    RS_SETTINGS->beginGroup("/Modify");
+    bool ok = false;
+    double tolerance = RS_SETTINGS->readEntry("/DuplicatesTolerance", "1.0e-6").toDouble(&ok);
+    RS_SETTINGS->endGroup();
+    if (!ok || tolerance <= 0.)
+        tolerance = 1.0e-6;
+
+    QElapsedTimer timer;
+    timer.start();
+    RS_Modification m(*container, graphicView);
+    const LC_GeometryCleanup::Result result = m.removeDuplicates(tolerance, container->countSelected() > 0);
+
+    if (result.removed.empty()) {
+        RS_DIALOGFACTORY->commandMessage(tr("No duplicate or overlapping geometry found"));
+    } else {
+        RS_DIALOGFACTORY->commandMessage(tr("Removed %1 duplicates and %2 overlapping lines and arcs, added %3 merged entities (%4 ms)")
+                                         .arg(result.duplicates)
+                                         .arg(result.removed.size() - result.duplicates)
+                                         .arg(result.added.size())
+                                         .arg(timer.elapsed()));
+    }
+    finish(false);
+}
+
+void LC_ActionModifyRemoveDuplicates::init(int status) {
+    RS_ActionInterface::init(status);
+    trigger();
+}
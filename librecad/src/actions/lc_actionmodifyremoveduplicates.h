@@ -0,0 +1,46 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_ACTIONMODIFYREMOVEDUPLICATES_H
+#define LC_ACTIONMODIFYREMOVEDUPLICATES_H
+
+#include "rs_actioninterface.h"
+
+/**
+ * Removes duplicate geometry and merges overlapping lines and arcs of the
+ * selected entities, or of the whole drawing if nothing is selected.
+ * The tolerance is read from the setting /Modify/DuplicatesTolerance.
+ */
+class LC_ActionModifyRemoveDuplicates : public RS_ActionInterface {
+    Q_OBJECT
+public:
+    LC_ActionModifyRemoveDuplicates(RS_EntityContainer& container,
+                                    RS_GraphicView& graphicView);
+
+    void init(int status=0) override;
+    void trigger() override;
+};
+
+#endif // LC_ACTIONMODIFYREMOVEDUPLICATES_H
@@ -296,7 +296,7 @@ void RS_ActionDefault::mouseMoveEvent(QMouseEvent* e) {
         }
 
         deletePreview();
-        preview->addSelectionFrom(*container);
+        preview->addSelectionReferencesFrom(*container);
 		preview->move(pPoints->v2 - pPoints->v1);
 
         if (e->modifiers() & Qt::ShiftModifier) {
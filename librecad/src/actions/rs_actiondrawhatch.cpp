@@ -34,6 +34,7 @@
 #include "rs_graphicview.h"
 #include "rs_information.h"
 #include "rs_hatch.h"
+#include "rs_spline.h"
 #include "rs_debug.h"
 
 namespace {
@@ -128,18 +129,19 @@ void RS_ActionDrawHatch::trigger() {
 
         if (e->isSelected()) {
             e->setSelected(false);
-            // entity is part of a complex entity (spline, polyline, ..):
-            if (e->getParent() &&
-                    // RVT - Don't de-delect the parent EntityPolyline, this is messing up the getFirst and getNext iterators
-                    //			    (e->getParent()->rtti()==RS2::EntitySpline ||
-                    //				 e->getParent()->rtti()==RS2::EntityPolyline)) {
-                    (e->getParent()->rtti()==RS2::EntitySpline)) {
-                e->getParent()->setSelected(false);
+            // splines are added by the lines of their tessellation:
+            std::vector<RS_Entity*> parts;
+            if (e->rtti()==RS2::EntitySpline) {
+                static_cast<RS_Spline*>(e)->createEntities(loop, parts);
+            } else {
+                RS_Entity* cp = e->clone();
+                cp->reparent(loop);
+                parts.push_back(cp);
+            }
+            for (RS_Entity* cp: parts) {
+                cp->setPen(RS_Pen(RS2::FlagInvalid));
+                loop->addEntity(cp);
             }
-            RS_Entity* cp = e->clone();
-            cp->setPen(RS_Pen(RS2::FlagInvalid));
-            cp->reparent(loop);
-            loop->addEntity(cp);
         }
     }
 
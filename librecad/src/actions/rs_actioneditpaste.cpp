@@ -78,7 +78,7 @@ void RS_ActionEditPaste::mouseMoveEvent(QMouseEvent* e) {
 		*targetPoint = snapPoint(e);
 
         deletePreview();
-        preview->addAllFrom(*RS_CLIPBOARD->getGraphic());
+        preview->addAllReferencesFrom(*RS_CLIPBOARD->getGraphic());
 		preview->move(*targetPoint);
 
 		if (graphic) {
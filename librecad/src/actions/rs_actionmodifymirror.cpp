@@ -61,6 +61,8 @@ void RS_ActionModifyMirror::trigger() {
 
     RS_DEBUG->print("RS_ActionModifyMirror::trigger()");
 
+    // the preview refers to the selected entities
+    deletePreview();
     RS_Modification m(*container, graphicView);
     m.mirror(pPoints->data);
 
@@ -88,7 +90,7 @@ void RS_ActionModifyMirror::mouseMoveEvent(QMouseEvent* e) {
                 pPoints->axisPoint2 = mouse;
 
                 deletePreview();
-                preview->addSelectionFrom(*container);
+                preview->addSelectionReferencesFrom(*container);
                 preview->mirror(pPoints->axisPoint1, pPoints->axisPoint2);
 
                 preview->addEntity(new RS_Line{preview.get(),
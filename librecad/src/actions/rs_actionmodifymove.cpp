@@ -60,6 +60,8 @@ void RS_ActionModifyMove::trigger() {
 
     RS_DEBUG->print("RS_ActionModifyMove::trigger()");
 
+    // the preview refers to the selected entities
+    deletePreview();
     RS_Modification m(*container, graphicView);
 	m.move(pPoints->data);
 
@@ -87,7 +89,7 @@ void RS_ActionModifyMove::mouseMoveEvent(QMouseEvent* e) {
 				pPoints->targetPoint = mouse;
 
                 deletePreview();
-                preview->addSelectionFrom(*container);
+                preview->addSelectionReferencesFrom(*container);
 				preview->move(pPoints->targetPoint-pPoints->referencePoint);
 
                 if (e->modifiers() & Qt::ShiftModifier) {
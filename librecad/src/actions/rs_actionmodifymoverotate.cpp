@@ -63,6 +63,8 @@ void RS_ActionModifyMoveRotate::trigger() {
 
     RS_DEBUG->print("RS_ActionModifyMoveRotate::trigger()");
 
+    // the preview refers to the selected entities
+    deletePreview();
     RS_Modification m(*container, graphicView);
 	m.moveRotate(pPoints->data);
 
@@ -91,7 +93,7 @@ void RS_ActionModifyMoveRotate::mouseMoveEvent(QMouseEvent* e) {
 				pPoints->data.offset = pPoints->targetPoint-pPoints->data.referencePoint;
 
                 deletePreview();
-                preview->addSelectionFrom(*container);
+                preview->addSelectionReferencesFrom(*container);
 				preview->rotate(pPoints->data.referencePoint, pPoints->data.angle);
 				preview->move(pPoints->data.offset);
                 drawPreview();
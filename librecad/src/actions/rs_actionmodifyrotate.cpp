@@ -56,6 +56,8 @@ void RS_ActionModifyRotate::trigger() {
 
     RS_DEBUG->print("RS_ActionModifyRotate::trigger()");
 
+    // the preview refers to the selected entities
+    deletePreview();
     RS_Modification m(*container, graphicView);
 	m.rotate(*data);
 
@@ -73,7 +75,7 @@ void RS_ActionModifyRotate::mouseMoveEvent(QMouseEvent* e) {
     case setTargetPoint:
         if( ! mouse.valid ) return;
         deletePreview();
-        preview->addSelectionFrom(*container);
+        preview->addSelectionReferencesFrom(*container);
 		preview->rotate(data->center,RS_Math::correctAngle((mouse - data->center).angle() - data->angle));
         drawPreview();
     }
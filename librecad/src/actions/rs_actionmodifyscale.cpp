@@ -134,18 +134,10 @@ RS_Vector RS_ActionModifyScale::getTargetPoint(QMouseEvent* e)
 void RS_ActionModifyScale::showPreview()
 {
     deletePreview();
-    preview->addSelectionFrom(*container);
+    preview->addSelectionReferencesFrom(*container);
     findFactor();
-
-    // RS_Modification only considers selected
-    for(auto* entity: *preview)
-        entity->setSelected(true);
-
-    RS_Modification m(*preview, graphicView);
-    m.scale(pPoints->data);
-
-    for(auto* entity: *preview)
-        entity->setSelected(false);
+    if (pPoints->data.factor.valid)
+        preview->scale(pPoints->data.referencePoint, pPoints->data.factor);
     drawPreview();
 }
 
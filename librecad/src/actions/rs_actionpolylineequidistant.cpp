@@ -25,6 +25,7 @@
 **********************************************************************/
 
 #include<cmath>
+#include <vector>
 
 #include <QAction>
 #include <QMouseEvent>
@@ -36,6 +37,7 @@
 #include "rs_graphicview.h"
 #include "rs_information.h"
 #include "rs_line.h"
+#include "rs_modification.h"
 #include "rs_polyline.h"
 
 RS_ActionPolylineEquidistant::RS_ActionPolylineEquidistant(RS_EntityContainer& container,
@@ -122,6 +124,29 @@ RS_Vector RS_ActionPolylineEquidistant::calculateIntersection(RS_Entity* first,R
     return vsol.get(0);
 }
 
+/**
+ * Helper function for makeContour
+ * Offsets closed polylines with LC_ContourOffset, which joins the segments
+ * with arcs and removes self-intersections. If the chosen polyline is
+ * selected, all selected closed polylines and circles are offset to the
+ * same side, inside or outside.
+ */
+bool RS_ActionPolylineEquidistant::makeClosedContours(RS_Polyline* polyline) {
+    std::vector<RS_Entity*> contours;
+    if (polyline->isSelected()) {
+        for (RS_Entity* e: *container) {
+            if (e->isSelected() && e->isVisible())
+                contours.push_back(e);
+        }
+    } else {
+        contours.push_back(polyline);
+    }
+
+    const bool inside = RS_Information::isPointInsideContour(*targetPoint, polyline);
+    RS_Modification m(*container, graphicView);
+    return m.offsetContours(contours, inside ? -dist : dist, number) > 0;
+}
+
 bool RS_ActionPolylineEquidistant::makeContour() {
 	if (!container) {
         RS_DEBUG->print(RS_Debug::D_WARNING,
@@ -130,6 +155,9 @@ bool RS_ActionPolylineEquidistant::makeContour() {
     }
 
     RS_Polyline* originalPolyline = (RS_Polyline*)originalEntity;
+    if (originalPolyline->isClosed() && roundCorners) {
+        return makeClosedContours(originalPolyline);
+    }
 //create a list of entities to offset without length = 0
 	QList<RS_Entity*> entities;
 	for(auto en: *originalPolyline){
@@ -28,6 +28,8 @@
 
 #include "rs_previewactioninterface.h"
 
+class RS_Polyline;
+
 /**
  * This action class can handle user events to move entities.
  *
@@ -77,11 +79,24 @@ public:
 		return number;
 	}
 
+	/**
+	 * Closed polylines are offset with round corners and without
+	 * self-intersections, see LC_ContourOffset.
+	 */
+	void setRoundCorners(bool r) {
+		roundCorners = r;
+	}
+
+	bool isRoundCorners() const{
+		return roundCorners;
+	}
+
 	bool makeContour();
 
 private:
     RS_Entity* calculateOffset(RS_Entity* newEntity,RS_Entity* orgEntity, double dist);
     RS_Vector calculateIntersection(RS_Entity* first,RS_Entity* last);
+    bool makeClosedContours(RS_Polyline* polyline);
 
 private:
     RS_Entity* originalEntity = nullptr;
@@ -89,6 +104,7 @@ private:
     double dist = 0.;
     int number = 0;
     bool bRightSide = false;
+    bool roundCorners = false;
 };
 
 #endif
@@ -103,6 +103,9 @@ void RS_ActionSelect::updateMouseButtonHints() {
 	case RS2::ActionModifyRevertDirectionNoSelect:
 		RS_DIALOGFACTORY->updateMouseWidget(tr("Select to revert direction"), tr("Cancel"));
 		break;
+    case RS2::ActionModifyBreakAtIntersectionsNoSelect:
+        RS_DIALOGFACTORY->updateMouseWidget(tr("Select to break at intersections"), tr("Cancel"));
+        break;
 	case RS2::ActionModifyRotateNoSelect:
         RS_DIALOGFACTORY->updateMouseWidget(tr("Select to rotate"), tr("Cancel"));
         break;
@@ -28,6 +28,8 @@
 #include "rs_graphicview.h"
 #include "rs_information.h"
 #include "rs_line.h"
+#include "rs_painter.h"
+#include "rs_pen.h"
 #include "rs_preview.h"
 #include "rs_settings.h"
 
@@ -55,39 +57,8 @@ void RS_Preview::addEntity(RS_Entity* entity) {
     }
 
     // only border preview for complex entities:
-
-    bool addBorder = false;
-
-    if (entity->rtti()==RS2::EntityImage || entity->rtti()==RS2::EntityHatch ||
-                entity->rtti()==RS2::EntityInsert) {
-
-        addBorder = true;
-    } else {
-        if (entity->isContainer() && entity->rtti()!=RS2::EntitySpline) {
-            if (entity->countDeep() > maxEntities-countDeep()) {
-                addBorder = true;
-            }
-        }
-    }
-
-    if (addBorder) {
-        RS_Vector min = entity->getMin();
-        RS_Vector max = entity->getMax();
-
-        RS_Line* l1 =
-			new RS_Line(this, {min.x, min.y}, {max.x, min.y});
-        RS_Line* l2 =
-			new RS_Line(this, {max.x, min.y}, {max.x, max.y});
-        RS_Line* l3 =
-			new RS_Line(this, {max.x, max.y}, {min.x, max.y});
-        RS_Line* l4 =
-			new RS_Line(this, {min.x, max.y}, {min.x, min.y});
-
-        RS_EntityContainer::addEntity(l1);
-        RS_EntityContainer::addEntity(l2);
-        RS_EntityContainer::addEntity(l3);
-        RS_EntityContainer::addEntity(l4);
-
+    if (needsBorder(entity)) {
+        addBorderOf(entity);
         delete entity;
     } else {
         entity->setLayer(nullptr);
@@ -98,6 +69,51 @@ void RS_Preview::addEntity(RS_Entity* entity) {
     }
 }
 
+/**
+ * @return true for entities which are only previewed by their bounding box
+ * when they are cloned into the preview.
+ */
+bool RS_Preview::needsBorder(RS_Entity* entity) const {
+    switch (entity->rtti()) {
+    case RS2::EntityImage:
+    case RS2::EntityHatch:
+    case RS2::EntityInsert:
+        return true;
+    case RS2::EntitySpline:
+        return false;
+    default:
+        return entity->isContainer() && entity->countDeep() > maxEntities-countDeep();
+    }
+}
+
+/**
+ * Adds the bounding box of the given entity as lines to the preview.
+ */
+void RS_Preview::addBorderOf(RS_Entity* entity) {
+    RS_Vector min = entity->getMin();
+    RS_Vector max = entity->getMax();
+
+    RS_EntityContainer::addEntity(new RS_Line(this, {min.x, min.y}, {max.x, min.y}));
+    RS_EntityContainer::addEntity(new RS_Line(this, {max.x, min.y}, {max.x, max.y}));
+    RS_EntityContainer::addEntity(new RS_Line(this, {max.x, max.y}, {min.x, max.y}));
+    RS_EntityContainer::addEntity(new RS_Line(this, {min.x, max.y}, {min.x, min.y}));
+}
+
+/**
+ * Adds an entity of the document to be drawn by reference, or its border
+ * for images. Nothing is cloned here, so the size of the entity does not
+ * matter: containers, inserts and hatches are drawn through the
+ * transformation as well.
+ */
+void RS_Preview::addReference(RS_Entity* entity) {
+    if (entity == nullptr || !entity->isVisible() || entity->isUndone())
+        return;
+    if (entity->rtti() == RS2::EntityImage)
+        addBorderOf(entity);
+    else
+        m_references.push_back(entity);
+}
+
 /**
  * Clones the given entity and adds the clone to the preview.
  */
@@ -177,6 +193,57 @@ void RS_Preview::addStretchablesFrom(RS_EntityContainer& container,
     }
 }
 
+/**
+ * Adds all selected entities from 'container' to the preview by reference.
+ * The entities are not copied, modifications of the preview only change
+ * the transformation they are drawn with.
+ */
+void RS_Preview::addSelectionReferencesFrom(RS_EntityContainer& container) {
+    for(auto e: container){
+        if (e->isSelected())
+            addReference(e);
+    }
+}
+
+/**
+ * Adds all entities from 'container' to the preview by reference.
+ */
+void RS_Preview::addAllReferencesFrom(RS_EntityContainer& container) {
+    for(auto e: container)
+        addReference(e);
+}
+
+void RS_Preview::clear() {
+    m_references.clear();
+    m_transform = {};
+    RS_EntityContainer::clear();
+}
+
+void RS_Preview::move(const RS_Vector& offset) {
+    RS_EntityContainer::move(offset);
+    m_transform = m_transform.then(LC_AffineTransform::translation(offset));
+}
+
+void RS_Preview::rotate(const RS_Vector& center, const double& angle) {
+    RS_EntityContainer::rotate(center, angle);
+    m_transform = m_transform.then(LC_AffineTransform::rotation(center, angle));
+}
+
+void RS_Preview::rotate(const RS_Vector& center, const RS_Vector& angleVector) {
+    RS_EntityContainer::rotate(center, angleVector);
+    m_transform = m_transform.then(LC_AffineTransform::rotation(center, angleVector.angle()));
+}
+
+void RS_Preview::scale(const RS_Vector& center, const RS_Vector& factor) {
+    RS_EntityContainer::scale(center, factor);
+    m_transform = m_transform.then(LC_AffineTransform::scaling(center, factor));
+}
+
+void RS_Preview::mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2) {
+    RS_EntityContainer::mirror(axisPoint1, axisPoint2);
+    m_transform = m_transform.then(LC_AffineTransform::mirroring(axisPoint1, axisPoint2));
+}
+
 void RS_Preview::draw(RS_Painter* painter, RS_GraphicView* view,
                               double& patternOffset) {
 
@@ -184,8 +251,13 @@ void RS_Preview::draw(RS_Painter* painter, RS_GraphicView* view,
         return;
     }
 
+    // the pen set up for the preview, entities drawn by reference use it too
+    const RS_Pen pen = painter->getPen();
+
     foreach (auto e, entities)
     {
         e->draw(painter, view, patternOffset);
     }
+
+    view->drawTransformed(painter, m_references, m_transform, pen, patternOffset);
 }
@@ -28,6 +28,9 @@
 #ifndef RS_PREVIEW_H
 #define RS_PREVIEW_H
 
+#include <vector>
+
+#include "lc_affinetransform.h"
 #include "rs_entitycontainer.h"
 
 /**
@@ -35,6 +38,10 @@
  * an instance of RS_Preview to preview entities, ranges, 
  * lines, arcs, ... on the fly.
  *
+ * Entities of the document can also be previewed by reference: they are
+ * drawn through the transformation accumulated by move(), rotate(),
+ * scale() and mirror() instead of being cloned and modified.
+ *
  * @author Andrew Mustun
  */
 class RS_Preview : public RS_EntityContainer {
@@ -49,11 +56,28 @@ public:
     virtual void addAllFrom(RS_EntityContainer& container);
     virtual void addStretchablesFrom(RS_EntityContainer& container,
                                      const RS_Vector& v1, const RS_Vector& v2);
+    virtual void addSelectionReferencesFrom(RS_EntityContainer& container);
+    virtual void addAllReferencesFrom(RS_EntityContainer& container);
+
+    void clear() override;
+    void move(const RS_Vector& offset) override;
+    void rotate(const RS_Vector& center, const double& angle) override;
+    void rotate(const RS_Vector& center, const RS_Vector& angleVector) override;
+    void scale(const RS_Vector& center, const RS_Vector& factor) override;
+    void mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2) override;
 
     void draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset) override;
 
 private:
+    bool needsBorder(RS_Entity* entity) const;
+    void addBorderOf(RS_Entity* entity);
+    void addReference(RS_Entity* entity);
+
     int maxEntities = 0;
+    //! document entities drawn through m_transform, not owned
+    std::vector<RS_Entity*> m_references;
+    //! transformation applied to the preview since the references were added
+    LC_AffineTransform m_transform;
 };
 
 #endif
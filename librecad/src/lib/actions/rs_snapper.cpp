@@ -29,6 +29,8 @@
 
 #include<QMouseEvent>
 
+#include "lc_containertraverser.h"
+#include "lc_profiler.h"
 #include "rs_circle.h"
 #include "rs_debug.h"
 #include "rs_dialogfactory.h"
@@ -284,6 +286,7 @@ RS_Vector RS_Snapper::snapFree(QMouseEvent* e) {
  */
 RS_Vector RS_Snapper::snapPoint(QMouseEvent* e)
 {
+    LC_PROFILE_SCOPE("RS_Snapper::snapPoint");
 	pImpData->snapSpot = RS_Vector(false);
     RS_Vector t(false);
 
@@ -691,7 +694,8 @@ RS_Entity* RS_Snapper::catchEntity(const RS_Vector& pos, RS2::EntityType enType,
 		break;
 	}
 
-	for(RS_Entity* en= container->firstEntity(level);en;en=container->nextEntity(level)){
+	LC_ContainerTraverser traverser{*container, level};
+	for(RS_Entity* en= traverser.first();en;en=traverser.next()){
         if(en->isVisible()==false) continue;
 		if(en->rtti() != enType && isContainer){
             //whether this entity is a member of member of the type enType
@@ -0,0 +1,207 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+
+#include <QFile>
+#include <QTextStream>
+
+#include "lc_profiler.h"
+#include "rs_debug.h"
+
+namespace {
+
+//! limits the memory used by a long trace, about 32 bytes per event
+constexpr size_t MaxEvents = 4000000;
+//! number of frames averaged for the overlay
+constexpr size_t AveragedFrames = 30;
+
+/** @return a small number identifying the calling thread in traces */
+int threadIndex()
+{
+    static std::atomic<int> threads{0};
+    thread_local int index = ++threads;
+    return index;
+}
+
+QString jsonString(const char* text)
+{
+    QString escaped = QString::fromUtf8(text);
+    escaped.replace('\\', "\\\\");
+    escaped.replace('"', "\\\"");
+    return '"' + escaped + '"';
+}
+
+/** @return nanoseconds as microseconds, the time unit of trace files */
+QString microseconds(std::int64_t ns)
+{
+    return QString::number(ns / 1000.0, 'f', 3);
+}
+}
+
+std::atomic<bool> LC_Profiler::active{false};
+
+LC_Profiler* LC_Profiler::instance()
+{
+    static LC_Profiler* uniqueInstance = new LC_Profiler();
+    return uniqueInstance;
+}
+
+void LC_Profiler::updateActive()
+{
+    active.store(m_statistics || m_tracing, std::memory_order_relaxed);
+}
+
+void LC_Profiler::setStatisticsEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_statistics = enabled;
+    updateActive();
+}
+
+bool LC_Profiler::isStatisticsEnabled() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+void LC_Profiler::resetStatistics()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_statisticMap.clear();
+    m_frameTimes.clear();
+    m_lastFrame = Frame();
+}
+
+LC_Profiler::Statistic LC_Profiler::getStatistic(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_statisticMap.find(name);
+    return it != m_statisticMap.end() ? it->second : Statistic();
+}
+
+LC_Profiler::Frame LC_Profiler::getLastFrame() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastFrame;
+}
+
+void LC_Profiler::startTrace()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.clear();
+    m_traceStart = now();
+    m_tracing = true;
+    updateActive();
+}
+
+bool LC_Profiler::isTracing() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tracing;
+}
+
+bool LC_Profiler::stopTrace(const QString& fileName)
+{
+    std::vector<Event> events;
+    std::int64_t traceStart = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tracing = false;
+        updateActive();
+        events.swap(m_events);
+        traceStart = m_traceStart;
+    }
+    if (fileName.isEmpty())
+        return true;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        RS_DEBUG->print(RS_Debug::D_WARNING, "LC_Profiler::stopTrace: cannot write '%s'",
+                        fileName.toLocal8Bit().constData());
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+           "\"args\":{\"name\":\"LibreCAD\"}}";
+    for (const Event& event: events) {
+        out << ",\n{\"name\":" << jsonString(event.name) << ",\"cat\":\"librecad\",\"pid\":1"
+            << ",\"tid\":" << event.thread
+            << ",\"ts\":" << microseconds(event.start - traceStart);
+        if (event.counter)
+            out << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+        else
+            out << ",\"ph\":\"X\",\"dur\":" << microseconds(event.value) << '}';
+    }
+    out << "\n]}\n";
+    out.flush();
+    if (events.size() >= MaxEvents)
+        RS_DEBUG->print(RS_Debug::D_WARNING, "LC_Profiler::stopTrace: trace truncated");
+    return file.error() == QFile::NoError;
+}
+
+void LC_Profiler::record(const char* name, std::int64_t start, std::int64_t end)
+{
+    const std::int64_t duration = end - start;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_statistics) {
+        Statistic& statistic = m_statisticMap[name];
+        ++statistic.calls;
+        statistic.totalNs += duration;
+        statistic.maxNs = std::max(statistic.maxNs, duration);
+        statistic.lastNs = duration;
+    }
+    if (m_tracing && m_events.size() < MaxEvents)
+        m_events.push_back({name, start, duration, threadIndex(), false});
+}
+
+void LC_Profiler::count(const char* name, std::int64_t value)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_tracing && m_events.size() < MaxEvents)
+        m_events.push_back({name, now(), value, threadIndex(), true});
+}
+
+void LC_Profiler::frame(std::int64_t start, std::int64_t end, int drawn, int culled)
+{
+    record("frame", start, end);
+    count("entities drawn", drawn);
+    count("entities culled", culled);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frameTimes.push_back(end - start);
+    if (m_frameTimes.size() > AveragedFrames)
+        m_frameTimes.pop_front();
+    std::int64_t total = 0;
+    for (std::int64_t frameTime: m_frameTimes)
+        total += frameTime;
+
+    m_lastFrame.durationNs = end - start;
+    m_lastFrame.averageNs = total / static_cast<std::int64_t>(m_frameTimes.size());
+    m_lastFrame.drawn = drawn;
+    m_lastFrame.culled = culled;
+}
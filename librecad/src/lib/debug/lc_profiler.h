@@ -0,0 +1,180 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_PROFILER_H
+#define LC_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class QString;
+
+/**
+ * Lightweight timers and counters for the hot paths of LibreCAD.
+ *
+ * Nothing is recorded unless statistics are enabled (for the profiler
+ * overlay) or a trace is being recorded. When disabled, a profiled scope
+ * costs one relaxed atomic load.
+ *
+ * A recorded trace is written in the Chrome trace event format, which
+ * can be opened with chrome://tracing or https://ui.perfetto.dev
+ *
+ * Use the macros:
+ * @code
+ * void RS_Foo::update() {
+ *     LC_PROFILE_SCOPE("RS_Foo::update");
+ *     ...
+ *     LC_PROFILE_COUNT("entities", count);
+ * }
+ * @endcode
+ */
+class LC_Profiler {
+public:
+    /** Accumulated times of a profiled scope. */
+    struct Statistic {
+        std::int64_t calls = 0;
+        std::int64_t totalNs = 0;
+        std::int64_t maxNs = 0;
+        //! duration of the last call
+        std::int64_t lastNs = 0;
+    };
+
+    /** Summary of the last painted frame, for the overlay. */
+    struct Frame {
+        std::int64_t durationNs = 0;
+        //! mean frame time of the last frames
+        std::int64_t averageNs = 0;
+        int drawn = 0;
+        int culled = 0;
+    };
+
+    static LC_Profiler* instance();
+
+    static bool isActive() {
+        return active.load(std::memory_order_relaxed);
+    }
+
+    /** Monotonic clock in nanoseconds. */
+    static std::int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void setStatisticsEnabled(bool enabled);
+    bool isStatisticsEnabled() const;
+    /** Clears the statistics of all scopes and frames. */
+    void resetStatistics();
+    Statistic getStatistic(const std::string& name) const;
+    Frame getLastFrame() const;
+
+    /** Starts recording trace events, discarding a previous trace. */
+    void startTrace();
+    bool isTracing() const;
+    /**
+     * Stops recording and writes the events to a Chrome trace file,
+     * or discards them if the file name is empty.
+     * @return false if the file couldn't be written
+     */
+    bool stopTrace(const QString& fileName);
+
+    /** Records a finished scope, called by LC_ProfileScope. */
+    void record(const char* name, std::int64_t start, std::int64_t end);
+    /** Records the value of a counter. */
+    void count(const char* name, std::int64_t value);
+    /** Records a painted frame. */
+    void frame(std::int64_t start, std::int64_t end, int drawn, int culled);
+
+private:
+    LC_Profiler() = default;
+    LC_Profiler(const LC_Profiler&) = delete;
+    LC_Profiler& operator = (const LC_Profiler&) = delete;
+
+    void updateActive();
+
+    struct Event {
+        const char* name = nullptr;
+        std::int64_t start = 0;
+        //! duration of a scope, or the value of a counter
+        std::int64_t value = 0;
+        int thread = 0;
+        bool counter = false;
+    };
+
+    static std::atomic<bool> active;
+
+    mutable std::mutex m_mutex;
+    bool m_statistics = false;
+    bool m_tracing = false;
+    std::int64_t m_traceStart = 0;
+    std::vector<Event> m_events;
+    std::unordered_map<std::string, Statistic> m_statisticMap;
+    std::deque<std::int64_t> m_frameTimes;
+    Frame m_lastFrame;
+};
+
+/**
+ * Times the enclosing scope if the profiler is active.
+ * The name must be a string literal, or outlive the trace.
+ */
+class LC_ProfileScope {
+public:
+    explicit LC_ProfileScope(const char* name):
+        m_name(LC_Profiler::isActive() ? name : nullptr)
+      , m_start(m_name != nullptr ? LC_Profiler::now() : 0)
+    {}
+
+    ~LC_ProfileScope()
+    {
+        if (m_name != nullptr)
+            LC_Profiler::instance()->record(m_name, m_start, LC_Profiler::now());
+    }
+
+    LC_ProfileScope(const LC_ProfileScope&) = delete;
+    LC_ProfileScope& operator = (const LC_ProfileScope&) = delete;
+
+private:
+    const char* m_name = nullptr;
+    std::int64_t m_start = 0;
+};
+
+#define LC_PROFILE_CONCAT_IMPL(a, b) a##b
+#define LC_PROFILE_CONCAT(a, b) LC_PROFILE_CONCAT_IMPL(a, b)
+
+#define LC_PROFILE_SCOPE(name) \
+    LC_ProfileScope LC_PROFILE_CONCAT(lcProfileScope, __LINE__)(name)
+
+#define LC_PROFILE_COUNT(name, value) \
+    do { \
+        if (LC_Profiler::isActive()) \
+            LC_Profiler::instance()->count(name, value); \
+    } while (false)
+
+#endif // LC_PROFILER_H
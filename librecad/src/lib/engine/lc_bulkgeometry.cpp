@@ -0,0 +1,710 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "lc_bulkgeometry.h"
+
+#include "dxf_format.h"
+#include "lc_defaults.h"
+#include "lc_rect.h"
+#include "lc_segmentdistance.h"
+#include "rs_debug.h"
+#include "rs_graphic.h"
+#include "rs_graphicview.h"
+#include "rs_layer.h"
+#include "rs_line.h"
+#include "rs_painter.h"
+#include "rs_point.h"
+
+namespace {
+
+// maximum number of entries in the layer and pen tables
+constexpr size_t g_maxTableSize = std::numeric_limits<std::uint16_t>::max();
+
+bool isLayerFrozen(const RS_Layer* layer)
+{
+    return layer != nullptr && layer->isFrozen();
+}
+}
+
+/**
+ * Constructor.
+ */
+LC_BulkGeometry::LC_BulkGeometry(RS_EntityContainer* parent):
+    RS_EntityContainer(parent, true)
+{
+    // the elements carry their own layers, the container itself must not
+    // depend on the layer that happens to be active
+    setLayer(nullptr);
+}
+
+RS_Entity* LC_BulkGeometry::clone() const
+{
+    auto* bulk = new LC_BulkGeometry(*this);
+    bulk->initId();
+    return bulk;
+}
+
+/**
+ * @return true, if the entity can be stored in a bulk container without
+ * losing information: lines and points not on construction layers
+ */
+bool LC_BulkGeometry::isPlainEntity(const RS_Entity* entity)
+{
+    if (entity == nullptr || entity->isConstruction())
+        return false;
+    return entity->rtti() == RS2::EntityLine || entity->rtti() == RS2::EntityPoint;
+}
+
+/**
+ * Finds or adds the table entries for the layer and pen.
+ * @return false, if the tables are full
+ */
+bool LC_BulkGeometry::findStyle(RS_Layer* layer, const RS_Pen& pen,
+                                std::uint16_t& layerIndex, std::uint16_t& penIndex)
+{
+    auto layerIt = std::find(m_layers.cbegin(), m_layers.cend(), layer);
+    auto penIt = std::find(m_pens.cbegin(), m_pens.cend(), pen);
+    if ((layerIt == m_layers.cend() && m_layers.size() >= g_maxTableSize)
+            || (penIt == m_pens.cend() && m_pens.size() >= g_maxTableSize))
+        return false;
+
+    layerIndex = static_cast<std::uint16_t>(layerIt - m_layers.cbegin());
+    if (layerIt == m_layers.cend())
+        m_layers.push_back(layer);
+    penIndex = static_cast<std::uint16_t>(penIt - m_pens.cbegin());
+    if (penIt == m_pens.cend())
+        m_pens.push_back(pen);
+    return true;
+}
+
+/**
+ * Adds a line.
+ * @return false, if the line could not be added, because the layer or pen
+ * tables are full
+ */
+bool LC_BulkGeometry::addLine(const RS_Vector& start, const RS_Vector& end,
+                              RS_Layer* layer, const RS_Pen& pen)
+{
+    std::uint16_t layerIndex = 0;
+    std::uint16_t penIndex = 0;
+    if (!findStyle(layer, pen, layerIndex, penIndex))
+        return false;
+
+    m_startX.push_back(start.x);
+    m_startY.push_back(start.y);
+    m_endX.push_back(end.x);
+    m_endY.push_back(end.y);
+    m_lineLayer.push_back(layerIndex);
+    m_linePen.push_back(penIndex);
+
+    minV = RS_Vector::minimum(minV, RS_Vector::minimum(start, end));
+    maxV = RS_Vector::maximum(maxV, RS_Vector::maximum(start, end));
+    return true;
+}
+
+/**
+ * Adds a point.
+ * @return false, if the point could not be added, because the layer or pen
+ * tables are full
+ */
+bool LC_BulkGeometry::addPoint(const RS_Vector& position, RS_Layer* layer, const RS_Pen& pen)
+{
+    std::uint16_t layerIndex = 0;
+    std::uint16_t penIndex = 0;
+    if (!findStyle(layer, pen, layerIndex, penIndex))
+        return false;
+
+    m_pointX.push_back(position.x);
+    m_pointY.push_back(position.y);
+    m_pointLayer.push_back(layerIndex);
+    m_pointPen.push_back(penIndex);
+
+    minV = RS_Vector::minimum(minV, position);
+    maxV = RS_Vector::maximum(maxV, position);
+    return true;
+}
+
+/**
+ * Adds the geometry, layer and pen of a plain line or point entity.
+ * The entity itself is not taken over.
+ * @return false, if the entity is not plain or the tables are full
+ */
+bool LC_BulkGeometry::addEntityData(const RS_Entity* entity)
+{
+    if (!isPlainEntity(entity))
+        return false;
+    if (entity->rtti() == RS2::EntityLine)
+        return addLine(entity->getStartpoint(), entity->getEndpoint(),
+                       entity->getLayer(), entity->getPen(false));
+    return addPoint(static_cast<const RS_Point*>(entity)->getPos(),
+                    entity->getLayer(), entity->getPen(false));
+}
+
+void LC_BulkGeometry::reserve(size_t lines, size_t points)
+{
+    for (auto* coords: {&m_startX, &m_startY, &m_endX, &m_endY})
+        coords->reserve(lines);
+    m_lineLayer.reserve(lines);
+    m_linePen.reserve(lines);
+    m_pointX.reserve(points);
+    m_pointY.reserve(points);
+    m_pointLayer.reserve(points);
+    m_pointPen.reserve(points);
+}
+
+RS_Vector LC_BulkGeometry::getLineStart(size_t index) const
+{
+    return {m_startX[index], m_startY[index]};
+}
+
+RS_Vector LC_BulkGeometry::getLineEnd(size_t index) const
+{
+    return {m_endX[index], m_endY[index]};
+}
+
+RS_Vector LC_BulkGeometry::getPoint(size_t index) const
+{
+    return {m_pointX[index], m_pointY[index]};
+}
+
+RS_Layer* LC_BulkGeometry::getElementLayer(const Element& element) const
+{
+    switch (element.kind) {
+    case Element::Line:
+        return m_layers[m_lineLayer[element.index]];
+    case Element::Point:
+        return m_layers[m_pointLayer[element.index]];
+    default:
+        return nullptr;
+    }
+}
+
+RS_Pen LC_BulkGeometry::getElementPen(const Element& element) const
+{
+    switch (element.kind) {
+    case Element::Line:
+        return m_pens[m_linePen[element.index]];
+    case Element::Point:
+        return m_pens[m_pointPen[element.index]];
+    default:
+        return {};
+    }
+}
+
+/**
+ * @return for every entry of the layer table whether the layer is frozen
+ * @param anyFrozen set to true if any of the layers is frozen
+ */
+std::vector<bool> LC_BulkGeometry::getFrozenLayers(bool& anyFrozen) const
+{
+    std::vector<bool> frozen(m_layers.size());
+    anyFrozen = false;
+    for (size_t i = 0; i < m_layers.size(); ++i) {
+        frozen[i] = isLayerFrozen(m_layers[i]);
+        anyFrozen = anyFrozen || frozen[i];
+    }
+    return frozen;
+}
+
+/**
+ * Finds the line or point closest to the given coordinate. Elements on
+ * frozen layers are ignored.
+ *
+ * @param coord Coordinate (typically a mouse coordinate)
+ * @param dist distance from coord to the element found
+ * @return the nearest element, or an invalid element, if there is none
+ */
+LC_BulkGeometry::Element LC_BulkGeometry::getNearestElement(const RS_Vector& coord,
+                                                            double* dist) const
+{
+    bool anyFrozen = false;
+    const std::vector<bool> frozen = getFrozenLayers(anyFrozen);
+
+    Element nearest;
+    double minDist2 = RS_MAXDOUBLE;
+    if (!anyFrozen) {
+        // all elements are candidates: use the batch kernels
+        const LC_SegmentDistance::Result line = LC_SegmentDistance::nearestSegment(
+                    coord.x, coord.y, startX(), startY(), endX(), endY(), lineCount());
+        if (line.index < lineCount() && line.distance2 < minDist2) {
+            minDist2 = line.distance2;
+            nearest = {Element::Line, line.index};
+        }
+        const LC_SegmentDistance::Result point = LC_SegmentDistance::nearestPoint(
+                    coord.x, coord.y, m_pointX.data(), m_pointY.data(), pointCount());
+        if (point.index < pointCount() && point.distance2 < minDist2) {
+            minDist2 = point.distance2;
+            nearest = {Element::Point, point.index};
+        }
+    } else {
+        for (size_t i = 0; i < lineCount(); ++i) {
+            if (frozen[m_lineLayer[i]])
+                continue;
+            const double d2 = LC_SegmentDistance::segmentDistance2(coord.x, coord.y,
+                                                                   m_startX[i], m_startY[i],
+                                                                   m_endX[i], m_endY[i]);
+            if (d2 < minDist2) {
+                minDist2 = d2;
+                nearest = {Element::Line, i};
+            }
+        }
+        for (size_t i = 0; i < pointCount(); ++i) {
+            if (frozen[m_pointLayer[i]])
+                continue;
+            const double dx = m_pointX[i] - coord.x;
+            const double dy = m_pointY[i] - coord.y;
+            const double d2 = dx * dx + dy * dy;
+            if (d2 < minDist2) {
+                minDist2 = d2;
+                nearest = {Element::Point, i};
+            }
+        }
+    }
+
+    if (dist != nullptr)
+        *dist = nearest.isValid() ? std::sqrt(minDist2) : RS_MAXDOUBLE;
+    return nearest;
+}
+
+/**
+ * @return a new regular entity for the given element, with the element's
+ * layer and pen, or nullptr for an invalid element
+ */
+RS_Entity* LC_BulkGeometry::createEntity(const Element& element, RS_EntityContainer* parent) const
+{
+    RS_Entity* entity = nullptr;
+    switch (element.kind) {
+    case Element::Line:
+        entity = new RS_Line{parent, getLineStart(element.index), getLineEnd(element.index)};
+        break;
+    case Element::Point:
+        entity = new RS_Point{parent, RS_PointData{getPoint(element.index)}};
+        break;
+    default:
+        return nullptr;
+    }
+    entity->setLayer(getElementLayer(element));
+    entity->setPen(getElementPen(element));
+    return entity;
+}
+
+/**
+ * Creates regular entities for all elements, e.g. for exploding.
+ * The new entities are appended to the given list.
+ */
+void LC_BulkGeometry::createEntities(RS_EntityContainer* parent,
+                                     std::vector<RS_Entity*>& entities) const
+{
+    entities.reserve(entities.size() + lineCount() + pointCount());
+    for (size_t i = 0; i < lineCount(); ++i)
+        entities.push_back(createEntity({Element::Line, i}, parent));
+    for (size_t i = 0; i < pointCount(); ++i)
+        entities.push_back(createEntity({Element::Point, i}, parent));
+}
+
+/**
+ * @return true, if any element is on the given layer
+ */
+bool LC_BulkGeometry::hasElementsOnLayer(const RS_Layer* layer) const
+{
+    return std::find(m_layers.cbegin(), m_layers.cend(), layer) != m_layers.cend();
+}
+
+/**
+ * @return a copy of this container without the elements on the given layer.
+ * Used when the layer is removed from the graphic.
+ */
+LC_BulkGeometry* LC_BulkGeometry::cloneWithoutLayer(const RS_Layer* layer) const
+{
+    auto* bulk = new LC_BulkGeometry(parent);
+    bulk->setPen(getPen(false));
+    bulk->reserve(lineCount(), pointCount());
+    for (size_t i = 0; i < lineCount(); ++i) {
+        RS_Layer* lineLayer = m_layers[m_lineLayer[i]];
+        if (lineLayer != layer)
+            bulk->addLine(getLineStart(i), getLineEnd(i), lineLayer, m_pens[m_linePen[i]]);
+    }
+    for (size_t i = 0; i < pointCount(); ++i) {
+        RS_Layer* pointLayer = m_layers[m_pointLayer[i]];
+        if (pointLayer != layer)
+            bulk->addPoint(getPoint(i), pointLayer, m_pens[m_pointPen[i]]);
+    }
+    bulk->calculateBorders();
+    return bulk;
+}
+
+/**
+ * Replaces the layers of the layer table by the layers of the same name in
+ * the given graphic, e.g. after copying to or pasting from the clipboard.
+ * Missing layers are replaced by layer "0".
+ */
+void LC_BulkGeometry::remapLayers(RS_Graphic& graphic)
+{
+    for (RS_Layer*& tableLayer: m_layers) {
+        RS_Layer* found = (tableLayer != nullptr) ? graphic.findLayer(tableLayer->getName()) : nullptr;
+        tableLayer = (found != nullptr) ? found : graphic.findLayer("0");
+    }
+}
+
+bool LC_BulkGeometry::isEmpty() const
+{
+    return lineCount() == 0 && pointCount() == 0 && RS_EntityContainer::isEmpty();
+}
+
+/**
+ * @return number of lines and points
+ */
+unsigned LC_BulkGeometry::countDeep() const
+{
+    return static_cast<unsigned>(lineCount() + pointCount());
+}
+
+/**
+ * @return total length of all lines
+ */
+double LC_BulkGeometry::getLength() const
+{
+    double length = 0.;
+    for (size_t i = 0; i < lineCount(); ++i)
+        length += std::hypot(m_endX[i] - m_startX[i], m_endY[i] - m_startY[i]);
+    return length;
+}
+
+void LC_BulkGeometry::calculateBorders()
+{
+    resetBorders();
+    for (size_t i = 0; i < lineCount(); ++i) {
+        minV.x = std::min({minV.x, m_startX[i], m_endX[i]});
+        minV.y = std::min({minV.y, m_startY[i], m_endY[i]});
+        maxV.x = std::max({maxV.x, m_startX[i], m_endX[i]});
+        maxV.y = std::max({maxV.y, m_startY[i], m_endY[i]});
+    }
+    for (size_t i = 0; i < pointCount(); ++i) {
+        minV.x = std::min(minV.x, m_pointX[i]);
+        minV.y = std::min(minV.y, m_pointY[i]);
+        maxV.x = std::max(maxV.x, m_pointX[i]);
+        maxV.y = std::max(maxV.y, m_pointY[i]);
+    }
+}
+
+void LC_BulkGeometry::clear()
+{
+    RS_EntityContainer::clear();
+    for (auto* coords: {&m_startX, &m_startY, &m_endX, &m_endY, &m_pointX, &m_pointY})
+        coords->clear();
+    for (auto* indices: {&m_lineLayer, &m_linePen, &m_pointLayer, &m_pointPen})
+        indices->clear();
+    m_layers.clear();
+    m_pens.clear();
+    resetBorders();
+}
+
+/**
+ * Candidates are checked in the order start points, end points, points.
+ * Among equal distances the first candidate wins. Elements on frozen
+ * layers are ignored.
+ */
+RS_Vector LC_BulkGeometry::getNearestEndpoint(const RS_Vector& coord, double* dist) const
+{
+    bool anyFrozen = false;
+    const std::vector<bool> frozen = getFrozenLayers(anyFrozen);
+
+    RS_Vector nearest{false};
+    double minDist2 = RS_MAXDOUBLE;
+    auto check = [&](const double* x, const double* y, const std::vector<std::uint16_t>& layers, size_t count) {
+        if (!anyFrozen) {
+            const LC_SegmentDistance::Result result = LC_SegmentDistance::nearestPoint(coord.x, coord.y, x, y, count);
+            if (result.index < count && result.distance2 < minDist2) {
+                minDist2 = result.distance2;
+                nearest = {x[result.index], y[result.index]};
+            }
+            return;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (frozen[layers[i]])
+                continue;
+            const double dx = x[i] - coord.x;
+            const double dy = y[i] - coord.y;
+            const double d2 = dx * dx + dy * dy;
+            if (d2 < minDist2) {
+                minDist2 = d2;
+                nearest = {x[i], y[i]};
+            }
+        }
+    };
+    check(startX(), startY(), m_lineLayer, lineCount());
+    check(endX(), endY(), m_lineLayer, lineCount());
+    check(m_pointX.data(), m_pointY.data(), m_pointLayer, pointCount());
+
+    if (dist != nullptr)
+        *dist = nearest.valid ? std::sqrt(minDist2) : RS_MAXDOUBLE;
+    return nearest;
+}
+
+RS_Vector LC_BulkGeometry::getNearestPointOnEntity(const RS_Vector& coord,
+                                                   bool onEntity,
+                                                   double* dist,
+                                                   RS_Entity** entity) const
+{
+    if (entity != nullptr)
+        *entity = const_cast<LC_BulkGeometry*>(this);
+
+    const Element nearest = getNearestElement(coord);
+    switch (nearest.kind) {
+    case Element::Line: {
+        const RS_Line line{getLineStart(nearest.index), getLineEnd(nearest.index)};
+        return line.getNearestPointOnEntity(coord, onEntity, dist);
+    }
+    case Element::Point: {
+        const RS_Vector position = getPoint(nearest.index);
+        if (dist != nullptr)
+            *dist = position.distanceTo(coord);
+        return position;
+    }
+    default:
+        if (dist != nullptr)
+            *dist = RS_MAXDOUBLE;
+        return RS_Vector{false};
+    }
+}
+
+RS_Vector LC_BulkGeometry::getNearestCenter(const RS_Vector& /*coord*/, double* dist) const
+{
+    if (dist != nullptr)
+        *dist = RS_MAXDOUBLE;
+    return RS_Vector{false};
+}
+
+RS_Vector LC_BulkGeometry::getNearestMiddle(const RS_Vector& coord, double* dist,
+                                            int middlePoints) const
+{
+    const Element nearest = getNearestElement(coord);
+    if (nearest.kind != Element::Line) {
+        if (dist != nullptr)
+            *dist = RS_MAXDOUBLE;
+        return RS_Vector{false};
+    }
+    const RS_Line line{getLineStart(nearest.index), getLineEnd(nearest.index)};
+    return line.getNearestMiddle(coord, dist, middlePoints);
+}
+
+RS_Vector LC_BulkGeometry::getNearestDist(double distance, const RS_Vector& coord,
+                                          double* dist) const
+{
+    const Element nearest = getNearestElement(coord);
+    if (nearest.kind != Element::Line) {
+        if (dist != nullptr)
+            *dist = RS_MAXDOUBLE;
+        return RS_Vector{false};
+    }
+    const RS_Line line{getLineStart(nearest.index), getLineEnd(nearest.index)};
+    return line.getNearestDist(distance, coord, dist);
+}
+
+RS_Vector LC_BulkGeometry::getNearestRef(const RS_Vector& coord, double* dist) const
+{
+    return getNearestEndpoint(coord, dist);
+}
+
+/**
+ * Reference points of single elements can not be moved, explode the
+ * container first.
+ */
+RS_Vector LC_BulkGeometry::getNearestSelectedRef(const RS_Vector& /*coord*/, double* dist) const
+{
+    if (dist != nullptr)
+        *dist = RS_MAXDOUBLE;
+    return RS_Vector{false};
+}
+
+double LC_BulkGeometry::getDistanceToPoint(const RS_Vector& coord,
+                                           RS_Entity** entity,
+                                           RS2::ResolveLevel /*level*/,
+                                           double /*solidDist*/) const
+{
+    if (entity != nullptr)
+        *entity = const_cast<LC_BulkGeometry*>(this);
+    double dist = RS_MAXDOUBLE;
+    getNearestElement(coord, &dist);
+    return dist;
+}
+
+/**
+ * Applies func(RS_Vector&) to all line endpoints and points and updates
+ * the borders.
+ */
+template<typename Func>
+void LC_BulkGeometry::transformVertices(Func func)
+{
+    auto apply = [&func](double& x, double& y) {
+        RS_Vector vertex{x, y};
+        func(vertex);
+        x = vertex.x;
+        y = vertex.y;
+    };
+    for (size_t i = 0; i < lineCount(); ++i) {
+        apply(m_startX[i], m_startY[i]);
+        apply(m_endX[i], m_endY[i]);
+    }
+    for (size_t i = 0; i < pointCount(); ++i)
+        apply(m_pointX[i], m_pointY[i]);
+    calculateBorders();
+}
+
+void LC_BulkGeometry::move(const RS_Vector& offset)
+{
+    transformVertices([&offset](RS_Vector& vertex) {
+        vertex.move(offset);
+    });
+}
+
+void LC_BulkGeometry::rotate(const RS_Vector& center, const double& angle)
+{
+    rotate(center, RS_Vector{angle});
+}
+
+void LC_BulkGeometry::rotate(const RS_Vector& center, const RS_Vector& angleVector)
+{
+    transformVertices([&center, &angleVector](RS_Vector& vertex) {
+        vertex.rotate(center, angleVector);
+    });
+}
+
+void LC_BulkGeometry::scale(const RS_Vector& center, const RS_Vector& factor)
+{
+    transformVertices([&center, &factor](RS_Vector& vertex) {
+        vertex.scale(center, factor);
+    });
+}
+
+void LC_BulkGeometry::mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2)
+{
+    transformVertices([&axisPoint1, &axisPoint2](RS_Vector& vertex) {
+        vertex.mirror(axisPoint1, axisPoint2);
+    });
+}
+
+void LC_BulkGeometry::stretch(const RS_Vector& firstCorner,
+                              const RS_Vector& secondCorner,
+                              const RS_Vector& offset)
+{
+    transformVertices([&firstCorner, &secondCorner, &offset](RS_Vector& vertex) {
+        if (vertex.isInWindow(firstCorner, secondCorner))
+            vertex.move(offset);
+    });
+}
+
+/**
+ * Resolves the pen of an element the way RS_Entity::getPen(true) resolves
+ * the pen of an entity on the layer of the element.
+ */
+RS_Pen LC_BulkGeometry::resolveElementPen(std::uint16_t layerIndex, std::uint16_t penIndex) const
+{
+    RS_Pen resolved = m_pens[penIndex];
+    if (parent != nullptr) {
+        const RS_Pen parentPen = parent->getPen();
+        if (!resolved.isValid())
+            resolved = parentPen;
+        if (resolved.getColor().isByBlock())
+            resolved.setColor(parentPen.getColor());
+        if (resolved.getWidth() == RS2::WidthByBlock)
+            resolved.setWidth(parentPen.getWidth());
+        if (resolved.getLineType() == RS2::LineByBlock)
+            resolved.setLineType(parentPen.getLineType());
+    }
+    const RS_Layer* elementLayer = m_layers[layerIndex] != nullptr ? m_layers[layerIndex] : getLayer(true);
+    if (elementLayer != nullptr) {
+        if (resolved.getColor().isByLayer())
+            resolved.setColor(elementLayer->getPen().getColor());
+        if (resolved.getWidth() == RS2::WidthByLayer)
+            resolved.setWidth(elementLayer->getPen().getWidth());
+        if (resolved.getLineType() == RS2::LineByLayer)
+            resolved.setLineType(elementLayer->getPen().getLineType());
+    }
+    return resolved;
+}
+
+/**
+ * Draws all elements. The pen is prepared by the view whenever layer or
+ * pen change between consecutive elements, elements outside of the
+ * visible area are skipped.
+ */
+void LC_BulkGeometry::draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset)
+{
+    if (painter == nullptr || view == nullptr)
+        return;
+
+    int currentLayer = -1;
+    int currentPen = -1;
+    bool frozen = false;
+    auto setStyle = [&](std::uint16_t layerIndex, std::uint16_t penIndex) {
+        if (layerIndex == currentLayer && penIndex == currentPen)
+            return;
+        currentLayer = layerIndex;
+        currentPen = penIndex;
+        frozen = isLayerFrozen(m_layers[layerIndex]);
+        if (!frozen)
+            view->setPenForEntity(painter, this, resolveElementPen(layerIndex, penIndex), patternOffset);
+    };
+
+    // culled in drawing coordinates, the view may draw a transformed preview
+    const LC_Rect visibleArea = view->getVisibleArea();
+    const RS_Vector vpMin = visibleArea.minP();
+    const RS_Vector vpMax = visibleArea.maxP();
+    for (size_t i = 0; i < lineCount(); ++i) {
+        if (std::max(m_startX[i], m_endX[i]) < vpMin.x || std::min(m_startX[i], m_endX[i]) > vpMax.x
+                || std::max(m_startY[i], m_endY[i]) < vpMin.y || std::min(m_startY[i], m_endY[i]) > vpMax.y)
+            continue;
+        setStyle(m_lineLayer[i], m_linePen[i]);
+        if (!frozen)
+            painter->drawLine(view->toGui(getLineStart(i)), view->toGui(getLineEnd(i)));
+    }
+
+    if (pointCount() > 0) {
+        const int pdmode = getGraphicVariableInt("$PDMODE", LC_DEFAULTS_PDMode);
+        const double pdsize = getGraphicVariableDouble("$PDSIZE", LC_DEFAULTS_PDSize);
+        int screenPDSize = 0;
+        if (pdsize == 0)
+            screenPDSize = painter->getHeight() / 20;
+        else if (DXF_FORMAT_PDSize_isPercent(pdsize))
+            screenPDSize = (painter->getHeight() * DXF_FORMAT_PDSize_Percent(pdsize)) / 100;
+        else
+            screenPDSize = view->toGuiDY(pdsize);
+
+        const LC_Rect pointArea = visibleArea.increaseBy(std::abs(view->toGraphDX(screenPDSize)));
+        for (size_t i = 0; i < pointCount(); ++i) {
+            const RS_Vector position = getPoint(i);
+            if (!pointArea.inArea(position))
+                continue;
+            setStyle(m_pointLayer[i], m_pointPen[i]);
+            if (!frozen)
+                painter->drawPoint(view->toGui(position), pdmode, screenPDSize);
+        }
+    }
+}
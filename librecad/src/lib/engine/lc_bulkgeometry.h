@@ -0,0 +1,184 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_BULKGEOMETRY_H
+#define LC_BULKGEOMETRY_H
+
+#include <cstdint>
+#include <vector>
+
+#include "rs_entitycontainer.h"
+
+class RS_Graphic;
+
+/**
+ * Compact storage for large numbers of plain lines and points, typically
+ * imported survey or GIS data.
+ *
+ * Instead of one polymorphic entity per line or point, the coordinates are
+ * kept in contiguous arrays together with an index into a layer table and
+ * an index into a pen table. A line takes 36 bytes.
+ *
+ * The container has no child entities. Drawing, snapping, picking and
+ * borders are computed directly from the arrays, and transformations are
+ * applied to the arrays. For editing single elements, the container can be
+ * exploded into regular RS_Line and RS_Point entities.
+ */
+class LC_BulkGeometry : public RS_EntityContainer {
+public:
+    /**
+     * Identifies a single line or point of the container.
+     */
+    struct Element {
+        enum Kind {
+            None,
+            Line,
+            Point
+        };
+        Kind kind = None;
+        size_t index = 0;
+
+        bool isValid() const {
+            return kind != None;
+        }
+    };
+
+    explicit LC_BulkGeometry(RS_EntityContainer* parent = nullptr);
+
+    RS_Entity* clone() const override;
+
+    /** @return RS2::EntityBulkGeometry */
+    RS2::EntityType rtti() const override {
+        return RS2::EntityBulkGeometry;
+    }
+
+    static bool isPlainEntity(const RS_Entity* entity);
+
+    bool addLine(const RS_Vector& start, const RS_Vector& end,
+                 RS_Layer* layer, const RS_Pen& pen);
+    bool addPoint(const RS_Vector& position, RS_Layer* layer, const RS_Pen& pen);
+    bool addEntityData(const RS_Entity* entity);
+    void reserve(size_t lines, size_t points);
+
+    /** @return number of lines */
+    size_t lineCount() const {
+        return m_startX.size();
+    }
+    /** @return number of points */
+    size_t pointCount() const {
+        return m_pointX.size();
+    }
+    RS_Vector getLineStart(size_t index) const;
+    RS_Vector getLineEnd(size_t index) const;
+    RS_Vector getPoint(size_t index) const;
+    RS_Layer* getElementLayer(const Element& element) const;
+    RS_Pen getElementPen(const Element& element) const;
+
+    //! \{ raw coordinate arrays for batch kernels
+    const double* startX() const { return m_startX.data(); }
+    const double* startY() const { return m_startY.data(); }
+    const double* endX() const { return m_endX.data(); }
+    const double* endY() const { return m_endY.data(); }
+    //! \}
+
+    Element getNearestElement(const RS_Vector& coord, double* dist = nullptr) const;
+    RS_Entity* createEntity(const Element& element, RS_EntityContainer* parent) const;
+    void createEntities(RS_EntityContainer* parent, std::vector<RS_Entity*>& entities) const;
+
+    bool hasElementsOnLayer(const RS_Layer* layer) const;
+    LC_BulkGeometry* cloneWithoutLayer(const RS_Layer* layer) const;
+    void remapLayers(RS_Graphic& graphic);
+    const std::vector<RS_Layer*>& getLayerTable() const {
+        return m_layers;
+    }
+
+    bool isEmpty() const override;
+    unsigned countDeep() const override;
+    double getLength() const override;
+    void calculateBorders() override;
+    void clear() override;
+
+    RS_Vector getNearestEndpoint(const RS_Vector& coord,
+                                 double* dist = nullptr) const override;
+    RS_Vector getNearestPointOnEntity(const RS_Vector& coord,
+                                      bool onEntity = true,
+                                      double* dist = nullptr,
+                                      RS_Entity** entity = nullptr) const override;
+    RS_Vector getNearestCenter(const RS_Vector& coord,
+                               double* dist = nullptr) const override;
+    RS_Vector getNearestMiddle(const RS_Vector& coord,
+                               double* dist = nullptr,
+                               int middlePoints = 1) const override;
+    RS_Vector getNearestDist(double distance,
+                             const RS_Vector& coord,
+                             double* dist = nullptr) const override;
+    RS_Vector getNearestRef(const RS_Vector& coord,
+                            double* dist = nullptr) const override;
+    RS_Vector getNearestSelectedRef(const RS_Vector& coord,
+                                    double* dist = nullptr) const override;
+    double getDistanceToPoint(const RS_Vector& coord,
+                              RS_Entity** entity,
+                              RS2::ResolveLevel level = RS2::ResolveNone,
+                              double solidDist = RS_MAXDOUBLE) const override;
+
+    void move(const RS_Vector& offset) override;
+    void rotate(const RS_Vector& center, const double& angle) override;
+    void rotate(const RS_Vector& center, const RS_Vector& angleVector) override;
+    void scale(const RS_Vector& center, const RS_Vector& factor) override;
+    void mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2) override;
+    void stretch(const RS_Vector& firstCorner,
+                 const RS_Vector& secondCorner,
+                 const RS_Vector& offset) override;
+
+    void draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset) override;
+
+private:
+    bool findStyle(RS_Layer* layer, const RS_Pen& pen,
+                   std::uint16_t& layerIndex, std::uint16_t& penIndex);
+    RS_Pen resolveElementPen(std::uint16_t layerIndex, std::uint16_t penIndex) const;
+    std::vector<bool> getFrozenLayers(bool& anyFrozen) const;
+    template<typename Func>
+    void transformVertices(Func func);
+
+    //! line coordinates
+    std::vector<double> m_startX;
+    std::vector<double> m_startY;
+    std::vector<double> m_endX;
+    std::vector<double> m_endY;
+    std::vector<std::uint16_t> m_lineLayer;
+    std::vector<std::uint16_t> m_linePen;
+
+    //! point coordinates
+    std::vector<double> m_pointX;
+    std::vector<double> m_pointY;
+    std::vector<std::uint16_t> m_pointLayer;
+    std::vector<std::uint16_t> m_pointPen;
+
+    //! layer and pen tables referenced by the elements
+    std::vector<RS_Layer*> m_layers;
+    std::vector<RS_Pen> m_pens;
+};
+
+#endif // LC_BULKGEOMETRY_H
@@ -0,0 +1,99 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include "lc_containertraverser.h"
+#include "rs_entitycontainer.h"
+
+LC_ContainerTraverser::LC_ContainerTraverser(const RS_EntityContainer& container,
+                                             RS2::ResolveLevel level):
+    m_container(container)
+  , m_level(level)
+{}
+
+RS_Entity* LC_ContainerTraverser::first()
+{
+    m_stack.clear();
+    m_stack.push_back({m_container.begin(), m_container.end()});
+    return current();
+}
+
+RS_Entity* LC_ContainerTraverser::next()
+{
+    if (m_stack.empty())
+        return nullptr;
+    ++m_stack.back().current;
+    return current();
+}
+
+std::vector<RS_Entity*> LC_ContainerTraverser::entities()
+{
+    std::vector<RS_Entity*> result;
+    result.reserve(m_container.count());
+    for (RS_Entity* e = first(); e != nullptr; e = next())
+        result.push_back(e);
+    return result;
+}
+
+bool LC_ContainerTraverser::isResolved(const RS_Entity* entity) const
+{
+    if (!entity->isContainer())
+        return false;
+
+    switch (m_level) {
+    case RS2::ResolveNone:
+        return false;
+    case RS2::ResolveAllButInserts:
+        return entity->rtti() != RS2::EntityInsert;
+    case RS2::ResolveAllButTextImage:
+    case RS2::ResolveAllButTexts:
+        return entity->rtti() != RS2::EntityText && entity->rtti() != RS2::EntityMText;
+    case RS2::ResolveAll:
+    default:
+        return true;
+    }
+}
+
+RS_Entity* LC_ContainerTraverser::current()
+{
+    while (!m_stack.empty()) {
+        Position& position = m_stack.back();
+        if (position.current == position.end) {
+            // done with this sub-container, continue after it
+            m_stack.pop_back();
+            if (!m_stack.empty())
+                ++m_stack.back().current;
+            continue;
+        }
+
+        RS_Entity* e = *position.current;
+        if (isResolved(e)) {
+            auto container = static_cast<const RS_EntityContainer*>(e);
+            m_stack.push_back({container->begin(), container->end()});
+            continue;
+        }
+        return e;
+    }
+    return nullptr;
+}
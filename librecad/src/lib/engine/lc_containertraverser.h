@@ -0,0 +1,84 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_CONTAINERTRAVERSER_H
+#define LC_CONTAINERTRAVERSER_H
+
+#include <vector>
+
+#include <QList>
+
+#include "rs.h"
+
+class RS_Entity;
+class RS_EntityContainer;
+
+/**
+ * Walks the entities of a container and, depending on the resolve level,
+ * of its sub-containers, like RS_EntityContainer::firstEntity() and
+ * nextEntity() do.
+ *
+ * The position of the walk is kept in the traverser instead of the
+ * containers, so traversals can be nested, and read-only traversals of the
+ * same drawing can run concurrently. The containers must not be modified
+ * while they are traversed.
+ *
+ * @code
+ * LC_ContainerTraverser traverser{*container, RS2::ResolveAll};
+ * for (RS_Entity* e = traverser.first(); e != nullptr; e = traverser.next()) {
+ *     ...
+ * }
+ * @endcode
+ */
+class LC_ContainerTraverser {
+public:
+    LC_ContainerTraverser(const RS_EntityContainer& container, RS2::ResolveLevel level);
+
+    /** @return the first entity, or nullptr if there is none */
+    RS_Entity* first();
+    /** @return the entity after the last returned one, or nullptr at the end */
+    RS_Entity* next();
+
+    /** @return all entities, in the order of first() and next() */
+    std::vector<RS_Entity*> entities();
+
+private:
+    /** @return true if the entity is a container to walk into */
+    bool isResolved(const RS_Entity* entity) const;
+    /** Moves to the next entity which is not resolved, starting at the current one. */
+    RS_Entity* current();
+
+    struct Position {
+        QList<RS_Entity*>::const_iterator current;
+        QList<RS_Entity*>::const_iterator end;
+    };
+
+    const RS_EntityContainer& m_container;
+    RS2::ResolveLevel m_level = RS2::ResolveNone;
+    //! one position for the container and each sub-container walked into
+    std::vector<Position> m_stack;
+};
+
+#endif // LC_CONTAINERTRAVERSER_H
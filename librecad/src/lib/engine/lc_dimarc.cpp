@@ -88,33 +88,7 @@ RS_Entity* LC_DimArc::clone() const
 
 QString LC_DimArc::getMeasuredLabel()
 {
-    RS_Graphic* currentGraphic = getGraphic();
-
-    QString measuredLabel;
-
-    if (currentGraphic)
-    {
-        const int dimlunit { getGraphicVariableInt (QStringLiteral("$DIMLUNIT"), 2) };
-        const int dimdec   { getGraphicVariableInt (QStringLiteral("$DIMDEC"),   4) };
-        const int dimzin   { getGraphicVariableInt (QStringLiteral("$DIMZIN"),   1) };
-
-        RS2::LinearFormat format = currentGraphic->getLinearFormat(dimlunit);
-
-        measuredLabel = RS_Units::formatLinear(dimArcData.arcLength, getGraphicUnit(), format, dimdec);
-
-        if (format == RS2::Decimal) measuredLabel = stripZerosLinear(measuredLabel, dimzin);
-
-        if ((format == RS2::Decimal) || (format == RS2::ArchitecturalMetric))
-        {
-            if (getGraphicVariableInt("$DIMDSEP", 0) == 44) measuredLabel.replace(QChar('.'), QChar(','));
-        }
-    }
-    else
-    {
-        measuredLabel = QString("%1").arg(dimArcData.arcLength);
-    }
-
-    return measuredLabel;
+    return formatLinearLabel(dimArcData.arcLength, false);
 }
 
 
@@ -0,0 +1,97 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+
+#include "lc_entitypool.h"
+
+namespace {
+// blocks are aligned for any entity member
+constexpr std::size_t g_blockAlignment = alignof(std::max_align_t);
+}
+
+/**
+ * Constructor.
+ *
+ * @param blockSize size of an entity in bytes
+ * @param blocksPerSlab number of entities reserved at once
+ */
+LC_EntityPool::LC_EntityPool(std::size_t blockSize, std::size_t blocksPerSlab):
+    m_blockSize{(std::max(blockSize, sizeof(FreeBlock)) + g_blockAlignment - 1)
+                / g_blockAlignment * g_blockAlignment}
+  , m_blocksPerSlab{std::max<std::size_t>(blocksPerSlab, 1)}
+{
+}
+
+/**
+ * @return storage for a single entity, taken from the free list
+ */
+void* LC_EntityPool::allocate()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_freeList == nullptr)
+        addSlab();
+    FreeBlock* block = m_freeList;
+    m_freeList = block->next;
+    ++m_used;
+    return block;
+}
+
+/**
+ * Returns the storage of a deleted entity to the free list.
+ */
+void LC_EntityPool::deallocate(void* block)
+{
+    if (block == nullptr)
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FreeBlock* freeBlock = new(block) FreeBlock{m_freeList};
+    m_freeList = freeBlock;
+    --m_used;
+}
+
+std::size_t LC_EntityPool::usedBlocks() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_used;
+}
+
+std::size_t LC_EntityPool::reservedBlocks() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slabs.size() * m_blocksPerSlab;
+}
+
+/**
+ * Reserves a new slab and links its blocks into the free list. Blocks are
+ * linked in address order, so consecutive allocations are contiguous.
+ */
+void LC_EntityPool::addSlab()
+{
+    m_slabs.emplace_back(new char[m_blockSize * m_blocksPerSlab]);
+    char* slab = m_slabs.back().get();
+    for (std::size_t i = m_blocksPerSlab; i > 0; --i)
+        m_freeList = new(slab + (i - 1) * m_blockSize) FreeBlock{m_freeList};
+}
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_ENTITYPOOL_H
+#define LC_ENTITYPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * Fixed size block allocator used for the most common atomic entities
+ * (RS_Line, RS_Arc, RS_Circle and RS_Point).
+ *
+ * Blocks are carved from slabs holding many entities each, which keeps
+ * entities created together, e.g. by a DXF import, close in memory.
+ * Deleted entities, including those purged from undo cycles, return their
+ * block to a free list, so the storage is reused by the next allocation
+ * instead of going back to the system allocator.
+ *
+ * The pool is thread safe, entities may be cloned on worker threads.
+ */
+class LC_EntityPool {
+public:
+    LC_EntityPool(std::size_t blockSize, std::size_t blocksPerSlab = 1024);
+    ~LC_EntityPool() = default;
+    LC_EntityPool(const LC_EntityPool&) = delete;
+    LC_EntityPool& operator = (const LC_EntityPool&) = delete;
+
+    void* allocate();
+    void deallocate(void* block);
+
+    /** @return size of a single block in bytes */
+    std::size_t blockSize() const {
+        return m_blockSize;
+    }
+    /** @return number of blocks currently in use */
+    std::size_t usedBlocks() const;
+    /** @return number of blocks reserved in slabs */
+    std::size_t reservedBlocks() const;
+
+    /**
+     * @brief allocate storage for an entity of type T. Allocations of
+     * a different size, e.g. from a class derived from T without its own
+     * allocation operators, use the global operator new.
+     */
+    template<typename T>
+    static void* allocate(std::size_t size)
+    {
+        if (size != sizeof(T))
+            return ::operator new(size);
+        return instance<T>().allocate();
+    }
+
+    /**
+     * @brief deallocate storage allocated by allocate<T>()
+     */
+    template<typename T>
+    static void deallocate(void* block, std::size_t size)
+    {
+        if (block == nullptr)
+            return;
+        if (size != sizeof(T)) {
+            ::operator delete(block);
+            return;
+        }
+        instance<T>().deallocate(block);
+    }
+
+    /**
+     * @return the pool for entities of type T
+     */
+    template<typename T>
+    static LC_EntityPool& instance()
+    {
+        // never destroyed: entities may still be deleted during static
+        // destruction, e.g. the clipboard graphic
+        static LC_EntityPool* pool = new LC_EntityPool(sizeof(T));
+        return *pool;
+    }
+
+private:
+    void addSlab();
+
+    struct FreeBlock {
+        FreeBlock* next = nullptr;
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<char[]>> m_slabs;
+    FreeBlock* m_freeList = nullptr;
+    std::size_t m_blockSize = 0;
+    std::size_t m_blocksPerSlab = 0;
+    std::size_t m_used = 0;
+};
+
+#endif // LC_ENTITYPOOL_H
@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+
+#include <QCoreApplication>
+#include <QMetaObject>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+
+#include "lc_imageloader.h"
+#include "lc_imagepyramid.h"
+
+namespace {
+
+class LoadTask: public QRunnable {
+public:
+    LoadTask(const QString& filePath, bool persistent,
+             std::function<void(std::shared_ptr<LC_ImagePyramid>)> done):
+        m_filePath(filePath)
+      , m_persistent(persistent)
+      , m_done(std::move(done))
+    {}
+
+    void run() override
+    {
+        m_done(LC_ImagePyramid::request(m_filePath, m_persistent));
+    }
+
+private:
+    QString m_filePath;
+    bool m_persistent = false;
+    std::function<void(std::shared_ptr<LC_ImagePyramid>)> m_done;
+};
+}
+
+LC_ImageLoader* LC_ImageLoader::instance()
+{
+    static LC_ImageLoader* uniqueInstance = new LC_ImageLoader();
+    return uniqueInstance;
+}
+
+LC_ImageLoader::LC_ImageLoader():
+    m_pool(std::make_unique<QThreadPool>())
+{
+    // decoding large images needs a lot of memory, keep some threads free
+    m_pool->setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+}
+
+LC_ImageLoader::~LC_ImageLoader() = default;
+
+void LC_ImageLoader::load(const QString& filePath, bool persistent, Callback callback)
+{
+    std::shared_ptr<LC_ImagePyramid> pyramid = LC_ImagePyramid::find(filePath);
+    if (pyramid) {
+        callback(pyramid);
+        return;
+    }
+
+    QCoreApplication* application = QCoreApplication::instance();
+    if (application == nullptr || QThread::currentThread() != application->thread()) {
+        callback(LC_ImagePyramid::request(filePath, persistent));
+        return;
+    }
+
+    std::vector<Callback>& callbacks = m_pending[filePath];
+    callbacks.push_back(std::move(callback));
+    if (callbacks.size() > 1)
+        return;
+
+    m_pool->start(new LoadTask(filePath, persistent,
+                               [this, filePath](std::shared_ptr<LC_ImagePyramid> result) {
+        loaded(filePath, std::move(result));
+    }));
+}
+
+/**
+ * Called on the loading thread, hands the pyramid over to the GUI thread.
+ */
+void LC_ImageLoader::loaded(const QString& filePath, std::shared_ptr<LC_ImagePyramid> pyramid)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_results.emplace_back(filePath, std::move(pyramid));
+    }
+    QMetaObject::invokeMethod(QCoreApplication::instance(), [this]() {
+        deliver();
+    }, Qt::QueuedConnection);
+}
+
+void LC_ImageLoader::deliver()
+{
+    std::vector<std::pair<QString, std::shared_ptr<LC_ImagePyramid>>> results;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        results.swap(m_results);
+    }
+    for (const auto& result: results) {
+        auto it = m_pending.find(result.first);
+        if (it == m_pending.end())
+            continue;
+        std::vector<Callback> callbacks = std::move(it->second);
+        m_pending.erase(it);
+        for (const Callback& callback: callbacks)
+            callback(result.second);
+    }
+}
+
+void LC_ImageLoader::waitForAll()
+{
+    m_pool->waitForDone();
+    deliver();
+}
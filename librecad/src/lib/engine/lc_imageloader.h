@@ -0,0 +1,77 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_IMAGELOADER_H
+#define LC_IMAGELOADER_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <QString>
+
+class LC_ImagePyramid;
+class QThreadPool;
+
+/**
+ * Loads image pyramids on background threads.
+ *
+ * Images request their pyramid with load(), the callback is called on the
+ * GUI thread once the pyramid is built, or immediately if it's already
+ * available. Requests for the same file are loaded once. Without a running
+ * application, or when called from another thread, images are loaded
+ * synchronously.
+ */
+class LC_ImageLoader {
+public:
+    using Callback = std::function<void(const std::shared_ptr<LC_ImagePyramid>&)>;
+
+    static LC_ImageLoader* instance();
+    ~LC_ImageLoader();
+
+    void load(const QString& filePath, bool persistent, Callback callback);
+    /**
+     * Waits for all pending loads and calls their callbacks, e.g. before
+     * printing.
+     */
+    void waitForAll();
+
+private:
+    LC_ImageLoader();
+    void loaded(const QString& filePath, std::shared_ptr<LC_ImagePyramid> pyramid);
+    void deliver();
+
+    std::unique_ptr<QThreadPool> m_pool;
+    //! callbacks of pending loads by file, only used on the GUI thread
+    std::map<QString, std::vector<Callback>> m_pending;
+    //! loaded pyramids not delivered yet
+    std::vector<std::pair<QString, std::shared_ptr<LC_ImagePyramid>>> m_results;
+    std::mutex m_mutex;
+};
+
+#endif // LC_IMAGELOADER_H
@@ -0,0 +1,569 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QStandardPaths>
+
+#include "lc_imagepyramid.h"
+#include "rs_debug.h"
+
+namespace {
+
+// pyramids by image file, shared by all images referring to the file
+std::mutex registryMutex;
+std::map<QString, std::weak_ptr<LC_ImagePyramid>> registry;
+
+// images with fewer pixels are built quickly and kept in memory only
+constexpr qint64 persistentPixels = 4096 * 4096;
+
+constexpr quint32 sidecarMagic = 0x4C435459; // "LCTY"
+constexpr quint32 sidecarVersion = 1;
+// magic, version, file size and time, width, height, tile size, index offset
+constexpr qint64 sidecarHeaderSize = 4 + 4 + 8 + 8 + 4 + 4 + 4 + 8;
+
+qint64 fileModified(const QString& filePath)
+{
+    return QFileInfo(filePath).lastModified().toMSecsSinceEpoch();
+}
+
+void writeHeader(QIODevice& device, qint64 fileSize, qint64 modified,
+                 const QSize& size, int tileSize, qint64 indexOffset)
+{
+    QDataStream stream(&device);
+    stream << sidecarMagic << sidecarVersion
+           << fileSize << modified
+           << qint32(size.width()) << qint32(size.height())
+           << qint32(tileSize) << indexOffset;
+}
+
+// formats whose readers decode a clipped area without decoding the rows above
+bool isRandomAccessFormat(const QByteArray& format)
+{
+    return format == "tif" || format == "tiff";
+}
+
+// copies src into dst at the given position, both ARGB32 premultiplied
+void copyPixels(QImage& dst, const QImage& src, int x, int y)
+{
+    const size_t bytes = size_t(src.width()) * 4;
+    for (int row = 0; row < src.height(); ++row)
+        std::memcpy(dst.scanLine(y + row) + size_t(x) * 4, src.constScanLine(row), bytes);
+}
+}
+
+std::shared_ptr<LC_ImagePyramid> LC_ImagePyramid::find(const QString& filePath)
+{
+    const qint64 modified = fileModified(filePath);
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto it = registry.begin(); it != registry.end();) {
+        if (it->second.expired())
+            it = registry.erase(it);
+        else
+            ++it;
+    }
+    auto it = registry.find(filePath);
+    if (it != registry.end()) {
+        std::shared_ptr<LC_ImagePyramid> pyramid = it->second.lock();
+        if (pyramid && pyramid->m_modified == modified)
+            return pyramid;
+    }
+    return nullptr;
+}
+
+std::shared_ptr<LC_ImagePyramid> LC_ImagePyramid::request(const QString& filePath,
+                                                          bool persistent)
+{
+    std::shared_ptr<LC_ImagePyramid> existing = find(filePath);
+    if (existing)
+        return existing;
+
+    auto pyramid = std::make_shared<LC_ImagePyramid>(filePath);
+    if (!pyramid->build(persistent))
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::weak_ptr<LC_ImagePyramid>& entry = registry[filePath];
+    existing = entry.lock();
+    if (existing && existing->m_modified == pyramid->m_modified)
+        return existing;
+    entry = pyramid;
+    return pyramid;
+}
+
+LC_ImagePyramid::LC_ImagePyramid(const QString& filePath):
+    m_filePath(filePath)
+{
+}
+
+LC_ImagePyramid::~LC_ImagePyramid() = default;
+
+bool LC_ImagePyramid::build(bool persistent)
+{
+    m_modified = fileModified(m_filePath);
+    if (persistent && openSidecar())
+        return true;
+
+    if (!buildBaseLevel(persistent)) {
+        discardSidecar();
+        m_levels.clear();
+        return false;
+    }
+    for (int level = 1; level < levelCount(); ++level) {
+        if (!buildLevel(level)) {
+            discardSidecar();
+            m_levels.clear();
+            return false;
+        }
+    }
+    if (m_persistent && !finishSidecar()) {
+        discardSidecar();
+        m_levels.clear();
+        return false;
+    }
+    return true;
+}
+
+void LC_ImagePyramid::initLevels()
+{
+    m_levels.clear();
+    if (m_size.isEmpty())
+        return;
+
+    QSize size = m_size;
+    size_t first = 0;
+    for (;;) {
+        Level level;
+        level.size = size;
+        level.grid = QSize((size.width() + TileSize - 1) / TileSize,
+                           (size.height() + TileSize - 1) / TileSize);
+        level.first = first;
+        first += size_t(level.grid.width()) * level.grid.height();
+        m_levels.push_back(level);
+        if (size.width() <= TileSize && size.height() <= TileSize)
+            break;
+        size = QSize((size.width() + 1) / 2, (size.height() + 1) / 2);
+    }
+}
+
+int LC_ImagePyramid::levelForScale(double scale) const
+{
+    if (!(scale > 0.) || scale >= 1.)
+        return 0;
+    const int level = static_cast<int>(std::floor(std::log2(1. / scale)));
+    return std::clamp(level, 0, std::max(levelCount() - 1, 0));
+}
+
+QSize LC_ImagePyramid::tileGrid(int level) const
+{
+    return m_levels.at(level).grid;
+}
+
+size_t LC_ImagePyramid::tileIndex(int level, int column, int row) const
+{
+    const Level& l = m_levels.at(level);
+    return l.first + size_t(row) * l.grid.width() + column;
+}
+
+QSize LC_ImagePyramid::tilePixels(int level, int column, int row) const
+{
+    const QSize& size = m_levels.at(level).size;
+    return {std::min(int(TileSize), size.width() - column * TileSize),
+            std::min(int(TileSize), size.height() - row * TileSize)};
+}
+
+QRect LC_ImagePyramid::tileArea(int level, int column, int row) const
+{
+    const int span = TileSize << level;
+    const int x = column * span;
+    const int y = row * span;
+    return {x, y,
+            std::min(span, m_size.width() - x),
+            std::min(span, m_size.height() - y)};
+}
+
+QImage LC_ImagePyramid::tile(int level, int column, int row) const
+{
+    if (level < 0 || level >= levelCount())
+        return {};
+    const QSize& grid = m_levels[level].grid;
+    if (column < 0 || row < 0 || column >= grid.width() || row >= grid.height())
+        return {};
+
+    const size_t index = tileIndex(level, column, row);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_cache.find(index);
+    if (it != m_cache.end()) {
+        m_lru.splice(m_lru.end(), m_lru, it->second.lru);
+        return it->second.image;
+    }
+
+    QImage image = loadTile(index, level, column, row);
+    if (image.isNull())
+        return image;
+    while (m_cache.size() >= MaxCachedTiles) {
+        m_cache.erase(m_lru.front());
+        m_lru.pop_front();
+    }
+    m_lru.push_back(index);
+    m_cache.emplace(index, TileEntry{image, std::prev(m_lru.end())});
+    return image;
+}
+
+/**
+ * Decodes the full resolution level. Formats with random access to
+ * clipped areas are decoded in bands of one tile row, to keep the memory
+ * use low. Other formats, e.g. JPEG or PNG, would be decoded from the top
+ * again for every band and are decoded in one pass instead.
+ */
+bool LC_ImagePyramid::buildBaseLevel(bool persistent)
+{
+    QImageReader reader(m_filePath);
+    QSize size = reader.size();
+    const bool banded = size.isValid() && size.height() > TileSize
+            && isRandomAccessFormat(reader.format())
+            && reader.supportsOption(QImageIOHandler::ClipRect);
+    QImage full;
+    if (!banded) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        // large images are the purpose of the pyramid
+        reader.setAllocationLimit(0);
+#endif
+        full = reader.read();
+        if (full.isNull()) {
+            RS_DEBUG->print(RS_Debug::D_WARNING,
+                            "LC_ImagePyramid::build: cannot read %s: %s",
+                            m_filePath.toLatin1().data(),
+                            reader.errorString().toLatin1().data());
+            return false;
+        }
+        size = full.size();
+    }
+
+    m_size = size;
+    initLevels();
+    if (m_levels.empty())
+        return false;
+    const size_t tiles = m_levels.back().first + 1;
+    m_persistent = persistent
+            && qint64(m_size.width()) * m_size.height() >= persistentPixels
+            && beginSidecar();
+    if (m_persistent) {
+        m_offsets.assign(tiles, 0);
+        m_lengths.assign(tiles, 0);
+    } else {
+        m_tiles.assign(tiles, QByteArray());
+    }
+
+    const QSize& grid = m_levels.front().grid;
+    for (int row = 0; row < grid.height(); ++row) {
+        QImage band;
+        int bandY = 0;
+        if (banded) {
+            QImageReader bandReader(m_filePath);
+            const int height = tilePixels(0, 0, row).height();
+            bandReader.setClipRect(QRect(0, row * TileSize, m_size.width(), height));
+            band = bandReader.read();
+            if (band.isNull()) {
+                RS_DEBUG->print(RS_Debug::D_WARNING,
+                                "LC_ImagePyramid::build: cannot read %s: %s",
+                                m_filePath.toLatin1().data(),
+                                bandReader.errorString().toLatin1().data());
+                return false;
+            }
+        } else {
+            bandY = row * TileSize;
+        }
+        const QImage& source = banded ? band : full;
+        for (int column = 0; column < grid.width(); ++column) {
+            const QSize pixels = tilePixels(0, column, row);
+            const QImage tileImage = source.copy(column * TileSize, bandY,
+                                                 pixels.width(), pixels.height());
+            if (!storeTile(tileIndex(0, column, row), tileImage))
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Builds a level by scaling down 2 x 2 tiles of the previous level.
+ */
+bool LC_ImagePyramid::buildLevel(int level)
+{
+    const QSize& grid = m_levels[level].grid;
+    const QSize& previousGrid = m_levels[level - 1].grid;
+    for (int row = 0; row < grid.height(); ++row) {
+        for (int column = 0; column < grid.width(); ++column) {
+            const int columns = std::min(2, previousGrid.width() - 2 * column);
+            const int rows = std::min(2, previousGrid.height() - 2 * row);
+            int width = 0;
+            int height = 0;
+            for (int i = 0; i < columns; ++i)
+                width += tilePixels(level - 1, 2 * column + i, 0).width();
+            for (int j = 0; j < rows; ++j)
+                height += tilePixels(level - 1, 0, 2 * row + j).height();
+
+            QImage combined(width, height, QImage::Format_ARGB32_Premultiplied);
+            for (int j = 0; j < rows; ++j) {
+                for (int i = 0; i < columns; ++i) {
+                    const int c = 2 * column + i;
+                    const int r = 2 * row + j;
+                    const QImage child = loadTile(tileIndex(level - 1, c, r), level - 1, c, r);
+                    if (child.isNull())
+                        return false;
+                    copyPixels(combined, child, i * TileSize, j * TileSize);
+                }
+            }
+
+            const QSize pixels = tilePixels(level, column, row);
+            const QImage scaled = combined.scaled(pixels, Qt::IgnoreAspectRatio,
+                                                  Qt::SmoothTransformation);
+            if (!storeTile(tileIndex(level, column, row), scaled))
+                return false;
+        }
+    }
+    return true;
+}
+
+bool LC_ImagePyramid::storeTile(size_t index, const QImage& image)
+{
+    const QImage pixels = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    QByteArray raw;
+    raw.reserve(pixels.width() * pixels.height() * 4);
+    for (int row = 0; row < pixels.height(); ++row)
+        raw.append(reinterpret_cast<const char*>(pixels.constScanLine(row)),
+                   pixels.width() * 4);
+    const QByteArray compressed = qCompress(raw, 1);
+
+    if (!m_persistent) {
+        m_tiles[index] = compressed;
+        return true;
+    }
+
+    const qint64 offset = m_sidecar.size();
+    if (!m_sidecar.seek(offset) || m_sidecar.write(compressed) != compressed.size()) {
+        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        "LC_ImagePyramid::storeTile: cannot write %s",
+                        m_sidecar.fileName().toLatin1().data());
+        return false;
+    }
+    m_offsets[index] = offset;
+    m_lengths[index] = compressed.size();
+    return true;
+}
+
+QImage LC_ImagePyramid::loadTile(size_t index, int level, int column, int row) const
+{
+    QByteArray compressed;
+    if (m_persistent) {
+        if (!m_sidecar.seek(m_offsets[index]))
+            return {};
+        compressed = m_sidecar.read(m_lengths[index]);
+    } else {
+        compressed = m_tiles[index];
+    }
+
+    const QByteArray raw = qUncompress(compressed);
+    const QSize pixels = tilePixels(level, column, row);
+    const qsizetype rowBytes = qsizetype(pixels.width()) * 4;
+    if (raw.size() != rowBytes * pixels.height()) {
+        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        "LC_ImagePyramid::loadTile: invalid tile %d/%d/%d of %s",
+                        level, column, row, m_filePath.toLatin1().data());
+        return {};
+    }
+
+    QImage image(pixels, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < pixels.height(); ++y)
+        std::memcpy(image.scanLine(y), raw.constData() + y * rowBytes, rowBytes);
+    return image;
+}
+
+/**
+ * @return the sidecar file in the cache directory of the application,
+ * named by a hash of the image path, or an empty string if there's no
+ * cache directory
+ */
+QString LC_ImagePyramid::sidecarPath() const
+{
+    const QString cache = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (cache.isEmpty())
+        return {};
+    const QByteArray key = QCryptographicHash::hash(QFileInfo(m_filePath).absoluteFilePath().toUtf8(),
+                                                    QCryptographicHash::Sha1).toHex();
+    return cache + "/imagetiles/" + QString::fromLatin1(key) + ".lctiles";
+}
+
+/**
+ * Opens an existing sidecar file, if it was built for the current
+ * image file.
+ */
+bool LC_ImagePyramid::openSidecar()
+{
+    if (sidecarPath().isEmpty())
+        return false;
+    m_sidecar.setFileName(sidecarPath());
+    if (!m_sidecar.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&m_sidecar);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 fileSize = 0;
+    qint64 modified = 0;
+    qint32 width = 0;
+    qint32 height = 0;
+    qint32 tileSize = 0;
+    qint64 indexOffset = 0;
+    stream >> magic >> version >> fileSize >> modified
+           >> width >> height >> tileSize >> indexOffset;
+    if (stream.status() != QDataStream::Ok || magic != sidecarMagic
+        || version != sidecarVersion || fileSize != QFileInfo(m_filePath).size()
+        || modified != m_modified || tileSize != TileSize
+        || indexOffset < sidecarHeaderSize) {
+        m_sidecar.close();
+        return false;
+    }
+
+    m_size = QSize(width, height);
+    initLevels();
+    if (m_levels.empty() || !m_sidecar.seek(indexOffset)) {
+        m_levels.clear();
+        m_sidecar.close();
+        return false;
+    }
+    const size_t tiles = m_levels.back().first + 1;
+    m_offsets.resize(tiles);
+    m_lengths.resize(tiles);
+    for (size_t i = 0; i < tiles; ++i)
+        stream >> m_offsets[i] >> m_lengths[i];
+    if (stream.status() != QDataStream::Ok) {
+        m_levels.clear();
+        m_sidecar.close();
+        return false;
+    }
+    m_persistent = true;
+    return true;
+}
+
+/**
+ * Starts writing the tiles into a temporary sidecar file.
+ */
+bool LC_ImagePyramid::beginSidecar()
+{
+    const QString path = sidecarPath();
+    if (path.isEmpty())
+        return false;
+    m_sidecar.setFileName(path + ".tmp");
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())
+            || !m_sidecar.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        "LC_ImagePyramid::build: cannot create %s, tiles are kept in memory",
+                        m_sidecar.fileName().toLatin1().data());
+        return false;
+    }
+    writeHeader(m_sidecar, QFileInfo(m_filePath).size(), m_modified,
+                m_size, TileSize, 0);
+    return true;
+}
+
+/**
+ * Writes the tile index and replaces the sidecar file by the temporary one.
+ */
+bool LC_ImagePyramid::finishSidecar()
+{
+    const qint64 indexOffset = m_sidecar.size();
+    if (!m_sidecar.seek(indexOffset))
+        return false;
+    {
+        QDataStream stream(&m_sidecar);
+        for (size_t i = 0; i < m_offsets.size(); ++i)
+            stream << m_offsets[i] << m_lengths[i];
+    }
+    if (!m_sidecar.seek(0))
+        return false;
+    writeHeader(m_sidecar, QFileInfo(m_filePath).size(), m_modified,
+                m_size, TileSize, indexOffset);
+    m_sidecar.close();
+
+    const QString temporary = m_sidecar.fileName();
+    QFile::remove(sidecarPath());
+    if (!QFile::rename(temporary, sidecarPath())) {
+        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        "LC_ImagePyramid::build: cannot create %s, tiles are kept in memory",
+                        sidecarPath().toLatin1().data());
+        // openSidecar() would never find the temporary file
+        const bool loaded = m_sidecar.open(QIODevice::ReadOnly) && loadSidecarTiles();
+        m_sidecar.close();
+        QFile::remove(temporary);
+        return loaded;
+    }
+    m_sidecar.setFileName(sidecarPath());
+    return m_sidecar.open(QIODevice::ReadOnly);
+}
+
+/**
+ * Moves the tiles from the open sidecar file into memory.
+ */
+bool LC_ImagePyramid::loadSidecarTiles()
+{
+    std::vector<QByteArray> tiles(m_offsets.size());
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        if (!m_sidecar.seek(m_offsets[i]))
+            return false;
+        tiles[i] = m_sidecar.read(m_lengths[i]);
+        if (tiles[i].size() != m_lengths[i])
+            return false;
+    }
+    m_tiles = std::move(tiles);
+    m_offsets.clear();
+    m_lengths.clear();
+    m_persistent = false;
+    return true;
+}
+
+/**
+ * Closes the sidecar file after an error, a temporary one is removed.
+ */
+void LC_ImagePyramid::discardSidecar()
+{
+    if (!m_persistent)
+        return;
+    const QString fileName = m_sidecar.fileName();
+    m_sidecar.close();
+    if (fileName.endsWith(".tmp"))
+        QFile::remove(fileName);
+    m_persistent = false;
+}
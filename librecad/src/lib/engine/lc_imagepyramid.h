@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_IMAGEPYRAMID_H
+#define LC_IMAGEPYRAMID_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QByteArray>
+#include <QFile>
+#include <QImage>
+#include <QRect>
+#include <QString>
+
+/**
+ * Tiled image pyramid of a raster image file.
+ *
+ * The image is decoded once and split into tiles of tileSize() pixels.
+ * Each further level halves the resolution of the previous one, until the
+ * whole image fits into one tile. The compressed tiles are kept in memory
+ * or, for large images, in a sidecar file in the cache directory of the
+ * application, which is reused as long as the image file is unchanged.
+ * Tiles are only decompressed when drawn, a limited number of decoded
+ * tiles is cached.
+ *
+ * Pyramids are shared by all images referring to the same file,
+ * see request().
+ */
+class LC_ImagePyramid {
+public:
+    /**
+     * @return the pyramid of the given image file, built if needed,
+     * or nullptr if the file can't be read.
+     */
+    static std::shared_ptr<LC_ImagePyramid> request(const QString& filePath,
+                                                    bool persistent);
+    /**
+     * @return the pyramid of the given image file if it's already built
+     * and up to date, nullptr otherwise.
+     */
+    static std::shared_ptr<LC_ImagePyramid> find(const QString& filePath);
+
+    explicit LC_ImagePyramid(const QString& filePath);
+    ~LC_ImagePyramid();
+
+    /**
+     * Builds the pyramid, or loads it from the sidecar cache file.
+     * @param persistent store the tiles of large images in a sidecar file
+     */
+    bool build(bool persistent);
+
+    bool isValid() const {
+        return m_levels.size() > 0;
+    }
+    const QString& getFilePath() const {
+        return m_filePath;
+    }
+    /** @return size of the image in pixels */
+    QSize size() const {
+        return m_size;
+    }
+    int levelCount() const {
+        return static_cast<int>(m_levels.size());
+    }
+    static int tileSize() {
+        return TileSize;
+    }
+
+    /**
+     * @return the coarsest level which still has at least one level pixel
+     * per screen pixel for the given number of screen pixels per image pixel.
+     */
+    int levelForScale(double scale) const;
+    /** @return number of tile columns and rows of a level */
+    QSize tileGrid(int level) const;
+    /** @return area of a tile in image pixels of the full resolution */
+    QRect tileArea(int level, int column, int row) const;
+    /** @return the decoded tile, a null image on errors */
+    QImage tile(int level, int column, int row) const;
+
+private:
+    enum {
+        TileSize = 256,
+        MaxCachedTiles = 256
+    };
+
+    struct Level {
+        QSize size;
+        QSize grid;
+        //! index of the first tile of the level
+        size_t first = 0;
+    };
+
+    struct TileEntry {
+        QImage image;
+        std::list<size_t>::iterator lru;
+    };
+
+    void initLevels();
+    size_t tileIndex(int level, int column, int row) const;
+    QSize tilePixels(int level, int column, int row) const;
+
+    bool buildBaseLevel(bool persistent);
+    bool buildLevel(int level);
+    bool storeTile(size_t index, const QImage& image);
+    QImage loadTile(size_t index, int level, int column, int row) const;
+
+    QString sidecarPath() const;
+    bool openSidecar();
+    bool beginSidecar();
+    bool finishSidecar();
+    bool loadSidecarTiles();
+    void discardSidecar();
+
+    QString m_filePath;
+    //! modification time of the image file, to detect changes
+    qint64 m_modified = 0;
+    QSize m_size;
+    std::vector<Level> m_levels;
+
+    //! compressed tiles, when not stored in the sidecar file
+    std::vector<QByteArray> m_tiles;
+    //! offsets and sizes of the compressed tiles in the sidecar file
+    std::vector<qint64> m_offsets;
+    std::vector<qint64> m_lengths;
+    mutable QFile m_sidecar;
+    bool m_persistent = false;
+
+    //! decoded tiles, least recently used first
+    mutable std::unordered_map<size_t, TileEntry> m_cache;
+    mutable std::list<size_t> m_lru;
+    mutable std::mutex m_mutex;
+};
+
+#endif // LC_IMAGEPYRAMID_H
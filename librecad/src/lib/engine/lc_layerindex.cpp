@@ -0,0 +1,117 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include "lc_bulkgeometry.h"
+#include "lc_layerindex.h"
+#include "rs_entity.h"
+
+void LC_LayerIndex::add(RS_Entity* entity)
+{
+    if (entity == nullptr)
+        return;
+    m_layers[entity->getLayer(false)].insert(entity);
+    if (entity->rtti() == RS2::EntityBulkGeometry)
+        m_bulkGeometry.insert(entity);
+}
+
+void LC_LayerIndex::remove(RS_Entity* entity)
+{
+    if (entity == nullptr)
+        return;
+    m_bulkGeometry.erase(entity);
+    auto it = m_layers.find(entity->getLayer(false));
+    if (it != m_layers.end() && it->second.erase(entity) == 1)
+        return;
+    // the layer was changed without notification, e.g. for entities
+    // which are children of other containers
+    for (auto& layerEntities: m_layers) {
+        if (layerEntities.second.erase(entity) == 1)
+            return;
+    }
+}
+
+void LC_LayerIndex::layerChanged(RS_Entity* entity, RS_Layer* previous)
+{
+    // only entities of the graphic are indexed. Clones still refer to
+    // the graphic as parent before they are added, so only lookups are
+    // done for them.
+    auto it = m_layers.find(previous);
+    if (it == m_layers.end() || it->second.count(entity) == 0)
+        return;
+    it->second.erase(entity);
+    m_layers[entity->getLayer(false)].insert(entity);
+}
+
+void LC_LayerIndex::removeLayer(RS_Layer* layer)
+{
+    auto it = m_layers.find(layer);
+    if (it != m_layers.end() && it->second.empty())
+        m_layers.erase(it);
+}
+
+void LC_LayerIndex::clear()
+{
+    m_layers.clear();
+    m_bulkGeometry.clear();
+}
+
+std::vector<RS_Entity*> LC_LayerIndex::entities(const RS_Layer* layer) const
+{
+    std::vector<RS_Entity*> result;
+    auto it = m_layers.find(layer);
+    if (it == m_layers.end())
+        return result;
+    result.reserve(it->second.size());
+    for (RS_Entity* entity: it->second) {
+        if (!entity->isUndone())
+            result.push_back(entity);
+    }
+    return result;
+}
+
+size_t LC_LayerIndex::count(const RS_Layer* layer) const
+{
+    auto it = m_layers.find(layer);
+    if (it == m_layers.end())
+        return 0;
+    size_t result = 0;
+    for (const RS_Entity* entity: it->second) {
+        if (!entity->isUndone())
+            ++result;
+    }
+    return result;
+}
+
+bool LC_LayerIndex::isEmpty(const RS_Layer* layer) const
+{
+    auto it = m_layers.find(layer);
+    if (it != m_layers.end() && !it->second.empty())
+        return false;
+    for (const RS_Entity* entity: m_bulkGeometry) {
+        if (static_cast<const LC_BulkGeometry*>(entity)->hasElementsOnLayer(layer))
+            return false;
+    }
+    return true;
+}
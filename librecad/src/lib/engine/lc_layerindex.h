@@ -0,0 +1,79 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_LAYERINDEX_H
+#define LC_LAYERINDEX_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class RS_Entity;
+class RS_Layer;
+
+/**
+ * Index of the top level entities of a graphic by their layer.
+ *
+ * The index is kept up to date by the graphic when entities are added,
+ * removed or moved to another layer. Undone entities stay in the index,
+ * queries skip them, so undo and redo need no updates. Queries run in
+ * time proportional to the number of entities on the layer.
+ *
+ * Bulk geometry containers are indexed by their own layer and in addition
+ * checked for elements on a layer, as their elements have separate layers.
+ */
+class LC_LayerIndex {
+public:
+    void add(RS_Entity* entity);
+    void remove(RS_Entity* entity);
+    void layerChanged(RS_Entity* entity, RS_Layer* previous);
+    void removeLayer(RS_Layer* layer);
+    void clear();
+
+    /**
+     * @return the entities on the given layer which are not undone.
+     * Changing the layer of the returned entities doesn't affect the list.
+     */
+    std::vector<RS_Entity*> entities(const RS_Layer* layer) const;
+    /**
+     * @return number of entities on the given layer which are not undone.
+     */
+    size_t count(const RS_Layer* layer) const;
+    /**
+     * @return true if no entity or bulk geometry element refers to the
+     * given layer. Undone entities, which may be restored, count as well.
+     */
+    bool isEmpty(const RS_Layer* layer) const;
+
+private:
+    using EntitySet = std::unordered_set<RS_Entity*>;
+
+    std::unordered_map<const RS_Layer*, EntitySet> m_layers;
+    //! bulk geometry containers, whose elements may be on any layer
+    EntitySet m_bulkGeometry;
+};
+
+#endif // LC_LAYERINDEX_H
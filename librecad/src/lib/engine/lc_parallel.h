@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_PARALLEL_H
+#define LC_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * Small helpers to split an index range over worker threads.
+ *
+ * Ranges are only split when they are large enough to pay for starting
+ * threads, small ranges are processed on the calling thread.
+ * The callers are responsible for the thread safety of the work done
+ * per item, in particular no document state may be modified.
+ */
+namespace LC_Parallel {
+
+/**
+ * @return number of threads to use for parallel work, at least 1
+ */
+inline size_t threadCount()
+{
+    const unsigned count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+/**
+ * @brief forEachRange calls func(begin, end) for consecutive sub-ranges
+ * of [0, count). Sub-ranges may be processed concurrently.
+ * @param count - number of items
+ * @param func - callable taking (size_t begin, size_t end)
+ * @param minChunk - minimum number of items per sub-range
+ */
+template<typename Func>
+void forEachRange(size_t count, Func&& func, size_t minChunk = 512)
+{
+    if (count == 0)
+        return;
+    minChunk = std::max<size_t>(minChunk, 1);
+    const size_t threads = std::min(threadCount(), (count + minChunk - 1) / minChunk);
+    if (threads <= 1) {
+        func(size_t{0}, count);
+        return;
+    }
+
+    const size_t chunk = (count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t begin = chunk; begin < count; begin += chunk) {
+        const size_t end = std::min(count, begin + chunk);
+        workers.emplace_back([&func, begin, end]() {
+            func(begin, end);
+        });
+    }
+    // the calling thread takes the first chunk
+    func(size_t{0}, std::min(count, chunk));
+    for (std::thread& worker: workers)
+        worker.join();
+}
+
+/**
+ * @brief forEachIndex calls func(i) for every i in [0, count),
+ * possibly concurrently.
+ */
+template<typename Func>
+void forEachIndex(size_t count, Func&& func, size_t minChunk = 512)
+{
+    forEachRange(count, [&func](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            func(i);
+    }, minChunk);
+}
+}
+
+#endif // LC_PARALLEL_H
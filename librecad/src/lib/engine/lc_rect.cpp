@@ -20,6 +20,7 @@ You should have received a copy of the GNU General Public License
 along with this program; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 **********************************************************************/
+#include <algorithm>
 #include<iostream>
 #include <QDebug>
 #include <cassert>
@@ -226,6 +227,33 @@ Area(coord, {coord.x + width, coord.y + height})
 				rhs.maxP().y + tolerance >= minP().y;
 	}
 
+	bool LC_Rect::intersects(const Coordinate& start, const Coordinate& end, double tolerance) const {
+		// clip the segment to the slabs in x and y (Liang-Barsky)
+		double t0 = 0.;
+		double t1 = 1.;
+		auto clip = [&t0, &t1](double p, double q) {
+			if (p == 0.)
+				return q >= 0.;
+			const double t = q / p;
+			if (p < 0.) {
+				if (t > t1)
+					return false;
+				t0 = std::max(t0, t);
+			} else {
+				if (t < t0)
+					return false;
+				t1 = std::min(t1, t);
+			}
+			return true;
+		};
+		const double dx = end.x - start.x;
+		const double dy = end.y - start.y;
+		return clip(-dx, start.x - (minP().x - tolerance)) &&
+				clip(dx, maxP().x + tolerance - start.x) &&
+				clip(-dy, start.y - (minP().y - tolerance)) &&
+				clip(dy, maxP().y + tolerance - start.y);
+	}
+
 	/**
 	 * @brief top
 	 * vector of this area
@@ -161,6 +161,14 @@ public:
 	 */
 	bool intersects(Area const& rhs, double tolerance = 0.) const;
 
+	/**
+	 * @brief intersects whether a line segment touches the area
+	 * @param start, end the end points of the segment
+	 * @param tolerance the area is enlarged by the tolerance on each side
+	 * @return true if a part of the segment lies within the area
+	 */
+	bool intersects(const Coordinate& start, const Coordinate& end, double tolerance = 0.) const;
+
 	/**
 		 * @brief top
 		 * vector of this area
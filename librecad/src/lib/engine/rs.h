@@ -160,7 +160,8 @@ namespace RS2 {
         EntityOverlayBox,    /**< OverlayBox */
         EntityPreview,    /**< Preview Container */
         EntityPattern,
-        EntityOverlayLine
+        EntityOverlayLine,
+        EntityBulkGeometry    /**< Compact storage of plain lines and points */
     };
 
 
@@ -343,6 +344,9 @@ namespace RS2 {
         ActionModifyMoveRotateNoSelect,
 		ActionModifyRevertDirection,
 		ActionModifyRevertDirectionNoSelect,
+        ActionModifyBreakAtIntersections,
+        ActionModifyBreakAtIntersectionsNoSelect,
+        ActionModifyRemoveDuplicates,
         ActionModifyRotate2,
         ActionModifyRotate2NoSelect,
         ActionModifyEntity,
@@ -26,6 +26,7 @@
 
 #include <cmath>
 #include "rs_arc.h"
+#include "lc_entitypool.h"
 
 #include "rs_line.h"
 #include "rs_linetypepattern.h"
@@ -90,6 +91,15 @@ RS_Entity* RS_Arc::clone() const {
 	return a;
 }
 
+void* RS_Arc::operator new(std::size_t size) {
+	return LC_EntityPool::allocate<RS_Arc>(size);
+}
+
+void RS_Arc::operator delete(void* block, std::size_t size) {
+	LC_EntityPool::deallocate<RS_Arc>(block, size);
+}
+
+
 /**
  * Creates this arc from 3 given points which define the arc line.
  *
@@ -906,8 +916,9 @@ void RS_Arc::draw(RS_Painter* painter, RS_GraphicView* view,
 	if (!( painter && view)) return;
 
     //only draw the visible portion of line
-    RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-    RS_Vector vpMax(view->toGraph(view->getWidth(),0));
+    const LC_Rect visibleArea = view->getVisibleArea();
+    RS_Vector vpMin(visibleArea.minP());
+    RS_Vector vpMax(visibleArea.maxP());
     QPolygonF visualBox(QRectF(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y));
 
     RS_Vector vpStart(isReversed()?getEndpoint():getStartpoint());
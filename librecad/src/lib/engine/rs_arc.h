@@ -27,6 +27,7 @@
 #ifndef RS_ARC_H
 #define RS_ARC_H
 
+#include <cstddef>
 #include <iosfwd>
 
 #include "rs_atomicentity.h"
@@ -71,6 +72,10 @@ public:
 
 	RS_Entity* clone() const override;
 
+	//! pooled allocation, see LC_EntityPool
+	static void* operator new(std::size_t size);
+	static void operator delete(void* block, std::size_t size);
+
     /**	@return RS2::EntityArc */
 	RS2::EntityType rtti() const override
 	{
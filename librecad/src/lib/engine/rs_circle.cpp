@@ -29,6 +29,7 @@
 #include <cfloat>
 #include <QPolygonF>
 #include "rs_circle.h"
+#include "lc_entitypool.h"
 
 #include "rs_line.h"
 #include "rs_information.h"
@@ -81,6 +82,15 @@ RS_Entity* RS_Circle::clone() const {
 	return c;
 }
 
+void* RS_Circle::operator new(std::size_t size) {
+	return LC_EntityPool::allocate<RS_Circle>(size);
+}
+
+void RS_Circle::operator delete(void* block, std::size_t size) {
+	LC_EntityPool::deallocate<RS_Circle>(block, size);
+}
+
+
 
 void RS_Circle::calculateBorders() {
     RS_Vector r{data.radius, data.radius};
@@ -759,8 +769,9 @@ RS_Entity& RS_Circle::shear(double k)
 bool RS_Circle::isVisibleInWindow(RS_GraphicView* view) const
 {
 
-    RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-    RS_Vector vpMax(view->toGraph(view->getWidth(),0));
+    const LC_Rect visibleArea = view->getVisibleArea();
+    RS_Vector vpMin(visibleArea.minP());
+    RS_Vector vpMax(visibleArea.maxP());
     QPolygonF visualBox(QRectF(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y));
 	std::vector<RS_Vector> vps;
     for(unsigned short i=0;i<4;i++){
@@ -29,6 +29,7 @@
 #ifndef RS_CIRCLE_H
 #define RS_CIRCLE_H
 
+#include <cstddef>
 #include <vector>
 #include "rs_atomicentity.h"
 
@@ -62,6 +63,10 @@ public:
 
 	RS_Entity* clone() const override;
 
+	//! pooled allocation, see LC_EntityPool
+	static void* operator new(std::size_t size);
+	static void operator delete(void* block, std::size_t size);
+
     /**	@return RS2::EntityCircle */
 	RS2::EntityType rtti() const override{
         return RS2::EntityCircle;
@@ -34,7 +34,6 @@
 #include "rs_constructionline.h"
 #include "rs_math.h"
 #include "rs_debug.h"
-#include "rs_settings.h"
 
 RS_DimAlignedData::RS_DimAlignedData():
 	extensionPoint1(false),
@@ -109,31 +108,7 @@ RS_VectorSolutions RS_DimAligned::getRefPoints() const
 QString RS_DimAligned::getMeasuredLabel() {
 	double dist = edata.extensionPoint1.distanceTo(edata.extensionPoint2) * getGeneralFactor();
 
-    RS_SETTINGS->beginGroup("/Appearance");
-    if (RS_SETTINGS->readNumEntry("/UnitlessGrid", 1) != 1) dist = RS_Units::convert(dist);
-    RS_SETTINGS->endGroup();
-
-    RS_Graphic* graphic = getGraphic();
-    QString ret;
-    if (graphic) {
-        int dimlunit = getGraphicVariableInt("$DIMLUNIT", 2);
-        int dimdec = getGraphicVariableInt("$DIMDEC", 4);
-        int dimzin = getGraphicVariableInt("$DIMZIN", 1);
-        RS2::LinearFormat format = graphic->getLinearFormat(dimlunit);
-
-        ret = RS_Units::formatLinear(dist, getGraphicUnit(), format, dimdec);
-        if (format == RS2::Decimal)
-            ret = stripZerosLinear(ret, dimzin);
-        //verify if units are decimal and comma separator
-        if (format == RS2::Decimal || format == RS2::ArchitecturalMetric){
-            if (getGraphicVariableInt("$DIMDSEP", 0) == 44)
-                ret.replace(QChar('.'), QChar(','));
-        }
-    }
-    else {
-        ret = QString("%1").arg(dist);
-    }
-    return ret;
+    return formatLinearLabel(dist);
 }
 
 
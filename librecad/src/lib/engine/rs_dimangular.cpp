@@ -141,25 +141,7 @@ RS_Entity* RS_DimAngular::clone() const
  */
 QString RS_DimAngular::getMeasuredLabel()
 {
-    int dimaunit {getGraphicVariableInt( QStringLiteral( "$DIMAUNIT"), 0)};
-    int dimadec {getGraphicVariableInt( QStringLiteral( "$DIMADEC"), 0)};
-    int dimazin {getGraphicVariableInt( QStringLiteral( "$DIMAZIN"), 0)};
-    RS2::AngleFormat format {RS_Units::numberToAngleFormat( dimaunit)};
-    QString strLabel( RS_Units::formatAngle( dimAngle, format, dimadec));
-
-    if (RS2::DegreesMinutesSeconds != format
-        && RS2::Surveyors != format) {
-        strLabel = stripZerosAngle( strLabel, dimazin);
-    }
-
-    //verify if units are decimal and comma separator
-    if (RS2::DegreesMinutesSeconds != dimaunit) {
-        if (',' == getGraphicVariableInt( QStringLiteral( "$DIMDSEP"), 0)) {
-            strLabel.replace( QChar('.'), QChar(','));
-        }
-    }
-
-    return strLabel;
+    return formatAngleLabel( dimAngle);
 }
 
 /**
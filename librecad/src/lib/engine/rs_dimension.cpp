@@ -31,6 +31,8 @@
 #include "rs_units.h"
 #include "rs_math.h"
 #include "rs_filterdxfrw.h" //for int <-> rs_color conversion
+#include "rs_graphic.h"
+#include "rs_settings.h"
 
 RS_DimensionData::RS_DimensionData():
 	definitionPoint(false),
@@ -612,6 +614,8 @@ void RS_Dimension::updateCreateDimensionLine(const RS_Vector& p1,
  * @return general factor for linear dimensions.
  */
 double RS_Dimension::getGeneralFactor() {
+    if (resolvedStyle)
+        return resolvedStyle->generalFactor;
     return getGraphicVariable("$DIMLFAC", 1.0, 40);
 }
 
@@ -619,6 +623,8 @@ double RS_Dimension::getGeneralFactor() {
  * @return general scale for dimensions.
  */
 double RS_Dimension::getGeneralScale() {
+    if (resolvedStyle)
+        return resolvedStyle->generalScale;
     return getGraphicVariable("$DIMSCALE", 1.0, 40);
 }
 
@@ -626,6 +632,8 @@ double RS_Dimension::getGeneralScale() {
  * @return arrow size in drawing units.
  */
 double RS_Dimension::getArrowSize() {
+    if (resolvedStyle)
+        return resolvedStyle->arrowSize;
     return getGraphicVariable("$DIMASZ", 2.5, 40);
 }
 
@@ -633,6 +641,8 @@ double RS_Dimension::getArrowSize() {
  * @return tick size in drawing units.
  */
 double RS_Dimension::getTickSize() {
+    if (resolvedStyle)
+        return resolvedStyle->tickSize;
     return getGraphicVariable("$DIMTSZ", 0., 40);
 }
 
@@ -641,6 +651,8 @@ double RS_Dimension::getTickSize() {
  * @return extension line overlength in drawing units.
  */
 double RS_Dimension::getExtensionLineExtension() {
+    if (resolvedStyle)
+        return resolvedStyle->extensionLineExtension;
     return getGraphicVariable("$DIMEXE", 1.25, 40);
 }
 
@@ -650,6 +662,8 @@ double RS_Dimension::getExtensionLineExtension() {
  * @return extension line offset from entities in drawing units.
  */
 double RS_Dimension::getExtensionLineOffset() {
+    if (resolvedStyle)
+        return resolvedStyle->extensionLineOffset;
     return getGraphicVariable("$DIMEXO", 0.625, 40);
 }
 
@@ -659,6 +673,8 @@ double RS_Dimension::getExtensionLineOffset() {
  * @return extension line gap to text in drawing units.
  */
 double RS_Dimension::getDimensionLineGap() {
+    if (resolvedStyle)
+        return resolvedStyle->dimensionLineGap;
     return getGraphicVariable("$DIMGAP", 0.625, 40);
 }
 
@@ -668,6 +684,8 @@ double RS_Dimension::getDimensionLineGap() {
  * @return Dimension labels text height.
  */
 double RS_Dimension::getTextHeight() {
+    if (resolvedStyle)
+        return resolvedStyle->textHeight;
     return getGraphicVariable("$DIMTXT", 2.5, 40);
 }
 
@@ -676,6 +694,8 @@ double RS_Dimension::getTextHeight() {
  * @return Dimension labels alignment text true= horizontal, false= aligned.
  */
 bool RS_Dimension::getInsideHorizontalText() {
+    if (resolvedStyle)
+        return resolvedStyle->insideHorizontalText;
     int v = getGraphicVariableInt("$DIMTIH", 1);
     if (v>0) {
         addGraphicVariable("$DIMTIH", 1, 70);
@@ -690,6 +710,8 @@ bool RS_Dimension::getInsideHorizontalText() {
  * @return Dimension fixed length for extension lines true= fixed, false= not fixed.
  */
 bool RS_Dimension::getFixedLengthOn() {
+    if (resolvedStyle)
+        return resolvedStyle->fixedLengthOn;
     int v = getGraphicVariableInt("$DIMFXLON", 0);
     if (v == 1) {
         addGraphicVariable("$DIMFXLON", 1, 70);
@@ -703,6 +725,8 @@ bool RS_Dimension::getFixedLengthOn() {
  * @return Dimension fixed length for extension lines.
  */
 double RS_Dimension::getFixedLength() {
+    if (resolvedStyle)
+        return resolvedStyle->fixedLength;
     return getGraphicVariable("$DIMFXL", 1.0, 40);
 }
 
@@ -711,6 +735,8 @@ double RS_Dimension::getFixedLength() {
  * @return extension line Width.
  */
 RS2::LineWidth RS_Dimension::getExtensionLineWidth() {
+    if (resolvedStyle)
+        return resolvedStyle->extensionLineWidth;
     return RS2::intToLineWidth( getGraphicVariableInt("$DIMLWE", -2) ); //default -2 (RS2::WidthByBlock)
 }
 
@@ -719,6 +745,8 @@ RS2::LineWidth RS_Dimension::getExtensionLineWidth() {
  * @return dimension line Width.
  */
 RS2::LineWidth RS_Dimension::getDimensionLineWidth() {
+    if (resolvedStyle)
+        return resolvedStyle->dimensionLineWidth;
     return RS2::intToLineWidth( getGraphicVariableInt("$DIMLWD", -2) ); //default -2 (RS2::WidthByBlock)
 }
 
@@ -726,6 +754,8 @@ RS2::LineWidth RS_Dimension::getDimensionLineWidth() {
  * @return dimension line Color.
  */
 RS_Color RS_Dimension::getDimensionLineColor() {
+    if (resolvedStyle)
+        return resolvedStyle->dimensionLineColor;
     return RS_FilterDXFRW::numberToColor(getGraphicVariableInt("$DIMCLRD", 0));
 }
 
@@ -734,6 +764,8 @@ RS_Color RS_Dimension::getDimensionLineColor() {
  * @return extension line Color.
  */
 RS_Color RS_Dimension::getExtensionLineColor() {
+    if (resolvedStyle)
+        return resolvedStyle->extensionLineColor;
     return RS_FilterDXFRW::numberToColor(getGraphicVariableInt("$DIMCLRE", 0));
 }
 
@@ -742,6 +774,8 @@ RS_Color RS_Dimension::getExtensionLineColor() {
  * @return dimension text Color.
  */
 RS_Color RS_Dimension::getTextColor() {
+    if (resolvedStyle)
+        return resolvedStyle->textColor;
     return RS_FilterDXFRW::numberToColor(getGraphicVariableInt("$DIMCLRT", 0));
 }
 
@@ -750,10 +784,128 @@ RS_Color RS_Dimension::getTextColor() {
  * @return text style for dimensions.
  */
 QString RS_Dimension::getTextStyle() {
+    if (resolvedStyle)
+        return resolvedStyle->textStyle;
     return getGraphicVariableString("$DIMTXSTY", "standard");
 }
 
 
+/**
+ * Resolves all dimension variables of the graphic at once. Missing
+ * variables are added with their defaults, like the getters do.
+ */
+RS_DimensionStyle RS_Dimension::resolveStyle() {
+    const RS_DimensionStyle* previous = resolvedStyle;
+    resolvedStyle = nullptr;
+
+    RS_DimensionStyle style;
+    style.generalFactor = getGeneralFactor();
+    style.generalScale = getGeneralScale();
+    style.arrowSize = getArrowSize();
+    style.tickSize = getTickSize();
+    style.extensionLineExtension = getExtensionLineExtension();
+    style.extensionLineOffset = getExtensionLineOffset();
+    style.dimensionLineGap = getDimensionLineGap();
+    style.textHeight = getTextHeight();
+    style.insideHorizontalText = getInsideHorizontalText();
+    style.fixedLengthOn = getFixedLengthOn();
+    style.fixedLength = getFixedLength();
+    style.extensionLineWidth = getExtensionLineWidth();
+    style.dimensionLineWidth = getDimensionLineWidth();
+    style.dimensionLineColor = getDimensionLineColor();
+    style.extensionLineColor = getExtensionLineColor();
+    style.textColor = getTextColor();
+    style.textStyle = getTextStyle();
+    resolveLabelStyle(style);
+
+    resolvedStyle = previous;
+    return style;
+}
+
+/**
+ * Resolves the variables used to format measured labels.
+ */
+void RS_Dimension::resolveLabelStyle(RS_DimensionStyle& style) {
+    RS_Graphic* graphic = getGraphic();
+    style.hasGraphic = graphic != nullptr;
+    style.unit = getGraphicUnit();
+    style.dimlunit = getGraphicVariableInt("$DIMLUNIT", 2);
+    style.dimdec = getGraphicVariableInt("$DIMDEC", 4);
+    style.dimzin = getGraphicVariableInt("$DIMZIN", 1);
+    style.dimdsep = getGraphicVariableInt("$DIMDSEP", 0);
+    style.dimaunit = getGraphicVariableInt("$DIMAUNIT", 0);
+    style.dimadec = getGraphicVariableInt("$DIMADEC", 0);
+    style.dimazin = getGraphicVariableInt("$DIMAZIN", 0);
+    if (graphic)
+        style.linearFormat = graphic->getLinearFormat(style.dimlunit);
+
+    RS_SETTINGS->beginGroup("/Appearance");
+    style.unitlessGrid = RS_SETTINGS->readNumEntry("/UnitlessGrid", 1) == 1;
+    RS_SETTINGS->endGroup();
+}
+
+/**
+ * Formats a linear measurement for the label of this dimension.
+ *
+ * @param distance measured distance, already multiplied by the general factor
+ * @param gridUnits true: convert the distance to drawing units if the
+ *        grid is not unitless
+ */
+QString RS_Dimension::formatLinearLabel(double distance, bool gridUnits) {
+    RS_DimensionStyle labelStyle;
+    const RS_DimensionStyle* style = resolvedStyle;
+    if (style == nullptr) {
+        resolveLabelStyle(labelStyle);
+        style = &labelStyle;
+    }
+
+    if (gridUnits && !style->unitlessGrid)
+        distance = RS_Units::convert(distance);
+
+    if (!style->hasGraphic)
+        return QString("%1").arg(distance);
+
+    QString ret = RS_Units::formatLinear(distance, style->unit,
+                                         style->linearFormat, style->dimdec);
+    if (style->linearFormat == RS2::Decimal)
+        ret = stripZerosLinear(ret, style->dimzin);
+    //verify if units are decimal and comma separator
+    if (style->linearFormat == RS2::Decimal
+        || style->linearFormat == RS2::ArchitecturalMetric) {
+        if (style->dimdsep == 44)
+            ret.replace(QChar('.'), QChar(','));
+    }
+    return ret;
+}
+
+/**
+ * Formats an angle for the label of this dimension.
+ */
+QString RS_Dimension::formatAngleLabel(double angle) {
+    RS_DimensionStyle labelStyle;
+    const RS_DimensionStyle* style = resolvedStyle;
+    if (style == nullptr) {
+        resolveLabelStyle(labelStyle);
+        style = &labelStyle;
+    }
+
+    RS2::AngleFormat format = RS_Units::numberToAngleFormat(style->dimaunit);
+    QString ret = RS_Units::formatAngle(angle, format, style->dimadec);
+
+    if (RS2::DegreesMinutesSeconds != format
+        && RS2::Surveyors != format) {
+        ret = stripZerosAngle(ret, style->dimazin);
+    }
+
+    //verify if units are decimal and comma separator
+    if (RS2::DegreesMinutesSeconds != style->dimaunit) {
+        if (',' == style->dimdsep)
+            ret.replace(QChar('.'), QChar(','));
+    }
+    return ret;
+}
+
+
 /**
  * @return the given graphic variable or the default value given in mm
  * converted to the graphic unit.
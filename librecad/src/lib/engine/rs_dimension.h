@@ -93,6 +93,46 @@ struct RS_DimensionData : public RS_Flags {
 std::ostream& operator << (std::ostream& os,
 								  const RS_DimensionData& dd);
 
+/**
+ * Dimension variables of a graphic, resolved once so that a pass over
+ * many dimensions does not look up every variable per dimension.
+ *
+ * @see RS_Dimension::resolveStyle
+ */
+struct RS_DimensionStyle {
+    double generalFactor = 1.;
+    double generalScale = 1.;
+    double arrowSize = 2.5;
+    double tickSize = 0.;
+    double extensionLineExtension = 1.25;
+    double extensionLineOffset = 0.625;
+    double dimensionLineGap = 0.625;
+    double textHeight = 2.5;
+    bool insideHorizontalText = true;
+    bool fixedLengthOn = false;
+    double fixedLength = 1.;
+    RS2::LineWidth extensionLineWidth = RS2::WidthByBlock;
+    RS2::LineWidth dimensionLineWidth = RS2::WidthByBlock;
+    RS_Color dimensionLineColor;
+    RS_Color extensionLineColor;
+    RS_Color textColor;
+    QString textStyle;
+
+    //! \{ label formatting
+    bool hasGraphic = false;
+    bool unitlessGrid = true;
+    RS2::Unit unit = RS2::None;
+    RS2::LinearFormat linearFormat = RS2::Decimal;
+    int dimlunit = 2;
+    int dimdec = 4;
+    int dimzin = 1;
+    int dimdsep = 0;
+    int dimaunit = 0;
+    int dimadec = 0;
+    int dimazin = 0;
+    //! \}
+};
+
 /**
  * Abstract base class for dimension entity classes.
  *
@@ -187,6 +227,16 @@ public:
     RS_Color getTextColor();
     QString getTextStyle();
 
+    RS_DimensionStyle resolveStyle();
+    /**
+     * Makes the getters return the values of the given resolved style
+     * instead of looking up the graphic variables, nullptr resets.
+     * The style must outlive its use by this dimension.
+     */
+    void setResolvedStyle(const RS_DimensionStyle* style) {
+        resolvedStyle = style;
+    }
+
         double getGraphicVariable(const QString& key, double defMM, int code);
         static QString stripZerosAngle(QString angle, int zeros=0);
         static QString stripZerosLinear(QString linear, int zeros=1);
@@ -206,7 +256,12 @@ public:
     }
 
 
+protected:
+    QString formatLinearLabel(double distance, bool gridUnits = true);
+    QString formatAngleLabel(double angle);
+
 private:
+    void resolveLabelStyle(RS_DimensionStyle& style);
     static RS_VectorSolutions  getIntersectionsLineContainer(
         const RS_Line* l, const RS_EntityContainer* c, bool infiniteLine=false);
     void updateCreateHorizontalTextDimensionLine(
@@ -219,6 +274,10 @@ private:
 protected:
     /** Data common to all dimension entities. */
     RS_DimensionData data;
+
+private:
+    //! style resolved for the current regeneration pass, may be nullptr
+    const RS_DimensionStyle* resolvedStyle = nullptr;
 };
 
 #endif
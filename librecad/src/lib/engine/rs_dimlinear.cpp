@@ -32,7 +32,6 @@
 #include "rs_graphic.h"
 #include "rs_math.h"
 #include "rs_debug.h"
-#include "rs_settings.h"
 #include "rs_units.h"
 
 
@@ -115,32 +114,7 @@ QString RS_DimLinear::getMeasuredLabel() {
     // Definitive dimension line:
     double dist = dimP1.distanceTo(dimP2) * getGeneralFactor();
 
-    RS_SETTINGS->beginGroup("/Appearance");
-    if (RS_SETTINGS->readNumEntry("/UnitlessGrid", 1) != 1) dist = RS_Units::convert(dist);
-    RS_SETTINGS->endGroup();
-
-        RS_Graphic* graphic = getGraphic();
-
-    QString ret;
-        if (graphic) {
-            int dimlunit = getGraphicVariableInt("$DIMLUNIT", 2);
-            int dimdec = getGraphicVariableInt("$DIMDEC", 4);
-            int dimzin = getGraphicVariableInt("$DIMZIN", 1);
-            RS2::LinearFormat format = graphic->getLinearFormat(dimlunit);
-            ret = RS_Units::formatLinear(dist, getGraphicUnit(), format, dimdec);
-            if (format == RS2::Decimal)
-                ret = stripZerosLinear(ret, dimzin);
-            //verify if units are decimal and comma separator
-            if (format == RS2::Decimal || format == RS2::ArchitecturalMetric){
-                if (getGraphicVariableInt("$DIMDSEP", 0) == 44)
-                    ret.replace(QChar('.'), QChar(','));
-            }
-        }
-        else {
-        ret = QString("%1").arg(dist);
-        }
-
-    return ret;
+    return formatLinearLabel(dist);
 }
 
 
@@ -1642,8 +1642,9 @@ void RS_Ellipse::moveRef(const RS_Vector& ref, const RS_Vector& offset) {
 */
 bool RS_Ellipse::isVisibleInWindow(RS_GraphicView* view) const
 {
-    RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-    RS_Vector vpMax(view->toGraph(view->getWidth(),0));
+    const LC_Rect visibleArea = view->getVisibleArea();
+    RS_Vector vpMin(visibleArea.minP());
+    RS_Vector vpMax(visibleArea.maxP());
     //viewport
     QRectF visualRect(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y);
     QPolygonF visualBox(visualRect);
@@ -1807,66 +1808,60 @@ void RS_Ellipse::draw(RS_Painter* painter, RS_GraphicView* view, double& pattern
         arc.draw(painter,view,patternOffset);
         return;
     }
-    //only draw the visible portion of line
-    RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-    RS_Vector vpMax(view->toGraph(view->getWidth(),0));
-    QPolygonF visualBox(QRectF(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y));
-
-    RS_Vector vpStart(isReversed()?getEndpoint():getStartpoint());
-    RS_Vector vpEnd(isReversed()?getStartpoint():getEndpoint());
-
-	std::vector<RS_Vector> vertex(0);
-    for(unsigned short i=0;i<4;i++){
-        const QPointF& vp(visualBox.at(i));
-		vertex.emplace_back(vp.x(),vp.y());
-    }
-    /** angles at cross points */
-	std::vector<double> crossPoints(0);
-
-    double baseAngle=isReversed()?getAngle2():getAngle1();
-    for(unsigned short i=0;i<4;i++){
-		RS_Line line{vertex.at(i),vertex.at((i+1)%4)};
-		auto vpIts=RS_Information::getIntersection(
-                    this, &line, true);
-//    std::cout<<"vpIts.size()="<<vpIts.size()<<std::endl;
-        if( vpIts.size()==0) continue;
-		for(const RS_Vector& vp: vpIts){
-			auto ap1=getTangentDirection(vp).angle();
-			auto ap2=line.getTangentDirection(vp).angle();
-            //ignore tangent points, because the arc doesn't cross over
-            if( fabs( remainder(ap2 - ap1, M_PI) ) < RS_TOLERANCE_ANGLE) continue;
-            crossPoints.push_back(
-                        RS_Math::getAngleDifference(baseAngle, getEllipseAngle(vp))
-                        );
+    //only draw the visible portion of the arc
+    const LC_Rect visibleArea = view->getVisibleArea();
+    const RS_Vector center = getCenter();
+    const RS_Vector major = getMajorP();
+    const RS_Vector minor = RS_Vector{-major.y, major.x} * getRatio();
+    const double baseAngle = isReversed() ? getAngle2() : getAngle1();
+    const double angleLength = getAngleLength();
+
+    /** angles at cross points, relative to baseAngle */
+    std::vector<double> crossPoints{0., angleLength};
+    // the ellipse is center + major*cos(t) + minor*sin(t), so a border
+    // x or y = const crosses it at a*cos(t) + b*sin(t) = d
+    auto addCrossPoints = [&crossPoints, baseAngle, angleLength](double a, double b, double d) {
+        const double r = std::hypot(a, b);
+        if (r < RS_TOLERANCE || std::abs(d) >= r)
+            return;
+        const double phi = std::atan2(b, a);
+        const double delta = std::acos(d / r);
+        for (double t: {phi + delta, phi - delta}) {
+            const double angle = RS_Math::correctAngle(t - baseAngle);
+            if (angle > 0. && angle < angleLength)
+                crossPoints.push_back(angle);
         }
-    }
-    if(vpStart.isInWindowOrdered(vpMin, vpMax)) crossPoints.push_back(0.);
-    if(vpEnd.isInWindowOrdered(vpMin, vpMax)) crossPoints.push_back(
-                RS_Math::getAngleDifference(baseAngle,isReversed()?getAngle1():getAngle2())
-                );
-
+    };
+    addCrossPoints(major.x, minor.x, visibleArea.minP().x - center.x);
+    addCrossPoints(major.x, minor.x, visibleArea.maxP().x - center.x);
+    addCrossPoints(major.y, minor.y, visibleArea.minP().y - center.y);
+    addCrossPoints(major.y, minor.y, visibleArea.maxP().y - center.y);
+    std::sort(crossPoints.begin(), crossPoints.end());
 
-    //sorting
-    std::sort(crossPoints.begin(),crossPoints.end());
-    //draw visible
-//    DEBUG_HEADER
-//    std::cout<<"crossPoints.size()="<<crossPoints.size()<<std::endl;
+    //draw the runs of pieces with their middle point in the visible area
     RS_Ellipse arc(*this);
     arc.setSelected(isSelected());
     arc.setPen(getPen());
     arc.setReversed(false);
-    if( crossPoints.size() >= 2) {
-		for(size_t i=1;i<crossPoints.size();i+=2){
-			arc.setAngle1(baseAngle+crossPoints[i-1]);
-			arc.setAngle2(baseAngle+crossPoints[i]);
-            arc.drawVisible(painter,view,patternOffset);
+    auto drawRun = [&](double angle1, double angle2) {
+        arc.setAngle1(baseAngle + angle1);
+        arc.setAngle2(baseAngle + angle2);
+        arc.drawVisible(painter, view, patternOffset);
+    };
+    double runStart = -1.;
+    for (size_t i = 1; i < crossPoints.size(); ++i) {
+        const double middle = baseAngle + 0.5 * (crossPoints[i - 1] + crossPoints[i]);
+        const RS_Vector vp = center + major * std::cos(middle) + minor * std::sin(middle);
+        if (visibleArea.inArea(vp)) {
+            if (runStart < 0.)
+                runStart = crossPoints[i - 1];
+        } else if (runStart >= 0.) {
+            drawRun(runStart, crossPoints[i - 1]);
+            runStart = -1.;
         }
-        return;
-    }
-    //a workaround for buggy equation solver, can be removed, when line-ellipse equation solver is reliable
-    if(isVisibleInWindow(view)){
-        arc.drawVisible(painter,view,patternOffset);
     }
+    if (runStart >= 0.)
+        drawRun(runStart, angleLength);
 }
 
 /** directly draw the arc, assuming the whole arc is within visible window */
@@ -26,6 +26,7 @@
 **********************************************************************/
 
 
+#include <atomic>
 #include <iostream>
 #include <utility>
 #include <QPolygon>
@@ -75,6 +76,12 @@ RS_Entity::RS_Entity(RS_EntityContainer *parent)
     init();
 }
 
+RS_Entity::~RS_Entity()
+{
+    if (selectionOwner.container != nullptr)
+        selectionOwner.container->forgetEntity(this);
+}
+
 
 /**
  * Copy constructor.
@@ -107,9 +114,10 @@ void RS_Entity::init() {
 
 /**
  * Gives this entity a new unique id.
+ * The counter is atomic, entities may be cloned from worker threads.
  */
 void RS_Entity::initId() {
-    static unsigned long long idCounter=0;
+    static std::atomic<unsigned long long> idCounter{0};
     id = idCounter++;
 }
 
@@ -147,12 +155,16 @@ bool RS_Entity::setSelected(bool select) {
         return false;
     }
 
+    const bool wasSelected = getFlag(RS2::FlagSelected);
     if (select) {
         setFlag(RS2::FlagSelected);
     } else {
         delFlag(RS2::FlagSelected);
     }
 
+    if (wasSelected != select && selectionOwner.container != nullptr)
+        selectionOwner.container->updateSelection(this);
+
     return true;
 }
 
@@ -229,10 +241,39 @@ bool RS_Entity::isProcessed() const {
  * @param undone true: entity has become invisible.
  *               false: entity has become visible.
  */
-void RS_Entity::undoStateChanged([[maybe_unused]] bool undone)
+void RS_Entity::undoStateChanged(bool undone)
 {
     setSelected(false);
     update();
+
+    // undone entities don't count for the borders of the parent
+    if (parent) {
+        if (undone) {
+            parent->invalidateBorders(this);
+        } else if (countsForBorders()) {
+            parent->adjustBorders(this);
+        }
+    }
+}
+
+/**
+ * @return true, if this entity counts for the borders of its parent,
+ * see RS_EntityContainer::calculateBorders()
+ */
+bool RS_Entity::countsForBorders() const
+{
+    const RS_Layer* l = getLayer();
+    return isVisible() && !(l && l->isFrozen());
+}
+
+/**
+ * @return true, if the parent lists this entity. Clones and entities being
+ * built point to a parent which doesn't list them (yet), possibly on worker
+ * threads, so they must not change the parent.
+ */
+bool RS_Entity::isListedInParent() const
+{
+    return parent != nullptr && selectionOwner.container == parent;
 }
 
 
@@ -301,8 +342,9 @@ bool RS_Entity::isArc() const
 /** whether the entity's bounding box intersects with visible portion of graphic view */
 bool RS_Entity::isVisibleInWindow(RS_GraphicView* view) const
 {
-    RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-    RS_Vector vpMax(view->toGraph(view->getWidth(),0));
+    const LC_Rect visibleArea = view->getVisibleArea();
+    RS_Vector vpMin(visibleArea.minP());
+    RS_Vector vpMax(visibleArea.maxP());
     if( getStartpoint().isInWindowOrdered(vpMin, vpMax) ) return true;
     if( getEndpoint().isInWindowOrdered(vpMin, vpMax) ) return true;
     QPolygonF visualBox(QRectF(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y));
@@ -429,11 +471,18 @@ bool RS_Entity::isVisible() const{
 }
 
 void RS_Entity::setVisible(bool v) {
+	if (v == getFlag(RS2::FlagVisible))
+		return;
+	const bool listed = isListedInParent();
+	if (listed && !v)
+		parent->invalidateBorders(this);
 	if (v) {
 		setFlag(RS2::FlagVisible);
 	} else {
 		delFlag(RS2::FlagVisible);
 	}
+	if (listed && v && countsForBorders())
+		parent->adjustBorders(this);
 }
 
 /**
@@ -754,11 +803,7 @@ RS_Layer* RS_Entity::getLayer(bool resolve) const {
  */
 void RS_Entity::setLayer(const QString& name) {
     RS_Graphic* graphic = getGraphic();
-    if (graphic) {
-        layer = graphic->findLayer(name);
-    } else {
-		layer = nullptr;
-    }
+    setLayer(graphic ? graphic->findLayer(name) : nullptr);
 }
 
 
@@ -767,7 +812,20 @@ void RS_Entity::setLayer(const QString& name) {
  * Sets the layer of this entity to the layer given.
  */
 void RS_Entity::setLayer(RS_Layer* l) {
+    if (layer == l)
+        return;
+    invalidateResolvedPen();
+    // the new layer may be frozen, or the old one
+    const bool listed = isListedInParent();
+    if (listed)
+        parent->invalidateBorders(this);
+    RS_Layer* previous = layer;
     layer = l;
+    if (listed) {
+        parent->entityLayerChanged(this, previous);
+        if (countsForBorders())
+            parent->adjustBorders(this);
+    }
 }
 
 
@@ -779,12 +837,7 @@ void RS_Entity::setLayer(RS_Layer* l) {
  */
 void RS_Entity::setLayerToActive() {
     RS_Graphic* graphic = getGraphic();
-
-    if (graphic) {
-        layer = graphic->getActiveLayer();
-    } else {
-		layer = nullptr;
-    }
+    setLayer(graphic ? graphic->getActiveLayer() : nullptr);
 }
 
 
@@ -866,6 +919,48 @@ RS_Pen RS_Entity::getPen(bool resolve) const {
     }
 }
 
+void RS_Entity::setPen(const RS_Pen& p) {
+    if (pen != p || pen.getFlags() != p.getFlags())
+        invalidateResolvedPen();
+    pen = p;
+}
+
+namespace {
+// generation of the layer attributes used to resolve pens, 0 marks invalid caches
+std::atomic<unsigned> resolvedPensGeneration{1};
+}
+
+/**
+ * Same as getPen(true), but the result is cached until the pen, layer or
+ * parent of this entity or of a parent, or the attributes of a layer
+ * change. Only used while drawing, on the GUI thread.
+ */
+const RS_Pen& RS_Entity::getResolvedPen() const {
+    const unsigned generation = resolvedPensGeneration.load(std::memory_order_relaxed);
+    if (resolvedPen.generation != generation) {
+        resolvedPen.pen = getPen(true);
+        resolvedPen.generation = generation;
+    }
+    return resolvedPen.pen;
+}
+
+void RS_Entity::invalidateResolvedPen() const {
+    resolvedPen.generation = 0;
+    if (isContainer()) {
+        for (const RS_Entity* e: *static_cast<const RS_EntityContainer*>(this)) {
+            if (e != nullptr)
+                e->invalidateResolvedPen();
+        }
+    }
+}
+
+void RS_Entity::invalidateResolvedPens() {
+    unsigned generation = resolvedPensGeneration.fetch_add(1, std::memory_order_relaxed) + 1;
+    // skip the value reserved for invalid caches on wrap around
+    if (generation == 0)
+        resolvedPensGeneration.compare_exchange_strong(generation, 1, std::memory_order_relaxed);
+}
+
 
 
 /**
@@ -876,7 +971,7 @@ RS_Pen RS_Entity::getPen(bool resolve) const {
 void RS_Entity::setPenToActive() {
     RS_Document* doc = getDocument();
     if (doc) {
-        pen = doc->getActivePen();
+        setPen(doc->getActivePen());
     } else {
         //RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Entity::setPenToActive(): "
         //                "No document / active pen linked to this entity.");
@@ -61,6 +61,7 @@ class QString;
 class RS_Entity : public RS_Undoable {
 public:
 	RS_Entity(RS_EntityContainer* parent=nullptr);
+    ~RS_Entity() override;
 
     void init();
     virtual void initId();
@@ -68,6 +69,8 @@ public:
 	virtual RS_Entity* clone() const = 0;
 
 	virtual void reparent(RS_EntityContainer* parent) {
+		if (this->parent != parent)
+			invalidateResolvedPen();
 		this->parent = parent;
 	}
 
@@ -130,6 +133,8 @@ public:
      * Reparents this entity.
      */
     void setParent(RS_EntityContainer* p) {
+        if (parent != p)
+            invalidateResolvedPen();
         parent = p;
     }
     /** @return The center point (x) of this arc */
@@ -151,13 +156,20 @@ public:
      * Sets the explicit pen for this entity or a pen with special
      * attributes such as BY_LAYER, ..
      */
-    void setPen(const RS_Pen& pen) {
-        this->pen = pen;
-    }
+    void setPen(const RS_Pen& pen);
 
 
     void setPenToActive();
     RS_Pen getPen(bool resolve = true) const;
+    const RS_Pen& getResolvedPen() const;
+
+    /**
+     * Invalidates the resolved pens cached by getResolvedPen() of all
+     * entities. Must be called whenever a layer attribute changes which
+     * is used to resolve ByLayer attributes. Changes of entities only
+     * invalidate the pens depending on them, see invalidateResolvedPen().
+     */
+    static void invalidateResolvedPens();
 
     /**
      * Must be overwritten to return true if an entity type
@@ -207,6 +219,8 @@ public:
 
 	void undoStateChanged(bool undone) override;
     virtual bool isUndone() const;
+    bool countsForBorders() const;
+    bool isListedInParent() const;
 
     /**
      * Can be implemented by child classes to update the entities
@@ -619,8 +633,48 @@ protected:
     //! auto updating enabled?
     bool updateEnabled = false;
 
+    /**
+     * Drops the resolved pen cached for this entity and, for containers,
+     * for all entities below, which resolve ByBlock attributes from it.
+     */
+    void invalidateResolvedPen() const;
+
 private:
+    friend class RS_EntityContainer;
+
+    /**
+     * The container tracking the selection of this entity, see
+     * RS_EntityContainer::getSelectedEntities(). Not copied with the entity,
+     * a copy isn't listed anywhere yet.
+     */
+    struct SelectionOwner {
+        RS_EntityContainer* container = nullptr;
+
+        SelectionOwner() = default;
+        SelectionOwner(const SelectionOwner&) {}
+        SelectionOwner& operator = (const SelectionOwner&) {
+            return *this;
+        }
+    } selectionOwner;
+
     std::map<QString, QString> varList;
+
+    /**
+     * Cached result of getPen(true), valid for the generation. Not copied
+     * with the entity, a copy may be resolved in another parent.
+     */
+    struct ResolvedPen {
+        RS_Pen pen;
+        unsigned generation = 0;
+
+        ResolvedPen() = default;
+        ResolvedPen(const ResolvedPen&) {}
+        ResolvedPen& operator = (const ResolvedPen&) {
+            generation = 0;
+            return *this;
+        }
+    };
+    mutable ResolvedPen resolvedPen;
 };
 
 #endif
@@ -24,12 +24,16 @@
 **
 **********************************************************************/
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <set>
 
 #include <QtGlobal>
+#include "lc_containertraverser.h"
 #include "lc_looputils.h"
+#include "lc_parallel.h"
+#include "lc_rect.h"
 
 #include "qg_dialogfactory.h"
 
@@ -39,6 +43,8 @@
 #include "rs_dialogfactory.h"
 #include "rs_ellipse.h"
 #include "rs_entitycontainer.h"
+#include "rs_font.h"
+#include "rs_fontlist.h"
 #include "rs_graphicview.h"
 #include "rs_information.h"
 #include "rs_insert.h"
@@ -74,6 +80,33 @@ double endPointDistance(const RS_Vector& point, const RS_Entity& entity)
     entity.getNearestEndpoint(point, &distance);
     return distance;
 }
+
+// Whether an atomic entity within the given entity crosses the border of
+// the window, given by its edges. Entities and sub-containers whose borders
+// are away from the window are skipped without intersection tests.
+bool crossesWindow(RS_Entity* entity, const LC_Rect& window, const RS_EntityContainer& border)
+{
+    // construction lines are infinite, their borders don't tell
+    if (entity->rtti() != RS2::EntityConstructionLine
+        && !window.intersects(LC_Rect{entity->getMin(), entity->getMax()}, RS_TOLERANCE))
+        return false;
+
+    if (entity->isContainer()) {
+        for (RS_Entity* se: *static_cast<RS_EntityContainer*>(entity)) {
+            if (se != nullptr && crossesWindow(se, window, border))
+                return true;
+        }
+        return false;
+    }
+    if (entity->rtti() == RS2::EntitySolid) {
+        return static_cast<RS_Solid*>(entity)->isInCrossWindow(window.minP(), window.maxP());
+    }
+    for (auto line: border) {
+        if (RS_Information::getIntersection(entity, line, true).hasValid())
+            return true;
+    }
+    return false;
+}
 }
 
 /**
@@ -110,6 +143,7 @@ RS_EntityContainer::RS_EntityContainer(const RS_EntityContainer& ec)
  * Destructor.
  */
 RS_EntityContainer::~RS_EntityContainer() {
+    untrackAll();
     if (autoDelete) {
         while (!entities.isEmpty())
             delete entities.takeFirst();
@@ -162,6 +196,8 @@ void RS_EntityContainer::detach() {
     }
 
     // clear shared pointers:
+    const bool hadSelection = hasSelection();
+    untrackAll();
     entities.clear();
     setOwner(autoDel);
 
@@ -169,7 +205,9 @@ void RS_EntityContainer::detach() {
     for(auto e: tmp){
         entities.append(e);
         e->reparent(this);
+        trackEntity(e);
     }
+    notifySelection(hadSelection);
 }
 
 
@@ -282,6 +320,10 @@ void RS_EntityContainer::selectWindow(enum RS2::EntityType typeToSelect,RS_Vecto
                                       bool select, bool cross) {
 
     bool included;
+    const LC_Rect window{v1, v2};
+    RS_EntityContainer l;
+    if (cross)
+        l.addRectangle(v1, v2);
 
     for(auto e: entities){
 
@@ -291,40 +333,7 @@ void RS_EntityContainer::selectWindow(enum RS2::EntityType typeToSelect,RS_Vecto
                 //e->setSelected(select);
                 included = true;
             } else if (cross) {
-                RS_EntityContainer l;
-                l.addRectangle(v1, v2);
-                RS_VectorSolutions sol;
-
-                if (e->isContainer()) {
-                    RS_EntityContainer* ec = (RS_EntityContainer*)e;
-                    for (RS_Entity* se=ec->firstEntity(RS2::ResolveAll);
-                         se && included==false;
-                         se=ec->nextEntity(RS2::ResolveAll)) {
-
-                        if (se->rtti() == RS2::EntitySolid){
-                            included = static_cast<RS_Solid*>(se)->isInCrossWindow(v1,v2);
-                        } else {
-                            for (auto line: l) {
-                                sol = RS_Information::getIntersection(
-                                            se, line, true);
-                                if (sol.hasValid()) {
-                                    included = true;
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                } else if (e->rtti() == RS2::EntitySolid){
-                    included = static_cast<RS_Solid*>(e)->isInCrossWindow(v1,v2);
-                } else {
-                    for (auto line: l) {
-                        sol = RS_Information::getIntersection(e, line, true);
-                        if (sol.hasValid()) {
-                            included = true;
-                            break;
-                        }
-                    }
-                }
+                included = crossesWindow(e, window, l);
             }
         }
 
@@ -343,8 +352,6 @@ void RS_EntityContainer::selectWindow(enum RS2::EntityType typeToSelect,RS_Vecto
     }
 }
 
-
-
 /**
  * Adds a entity to this container and updates the borders of this
  * entity-container if autoUpdateBorders is true.
@@ -364,12 +371,15 @@ void RS_EntityContainer::addEntity(RS_Entity* entity) {
 
     if (!entity) return;
 
+    const bool hadSelection = hasSelection();
     if (entity->rtti()==RS2::EntityImage ||
             entity->rtti()==RS2::EntityHatch) {
         entities.prepend(entity);
     } else {
         entities.append(entity);
     }
+    trackEntity(entity);
+    notifySelection(hadSelection);
     if (autoUpdateBorders) {
         adjustBorders(entity);
     }
@@ -383,7 +393,10 @@ void RS_EntityContainer::addEntity(RS_Entity* entity) {
 void RS_EntityContainer::appendEntity(RS_Entity* entity){
     if (!entity)
         return;
+    const bool hadSelection = hasSelection();
     entities.append(entity);
+    trackEntity(entity);
+    notifySelection(hadSelection);
     if (autoUpdateBorders)
         adjustBorders(entity);
 }
@@ -394,7 +407,10 @@ void RS_EntityContainer::appendEntity(RS_Entity* entity){
  */
 void RS_EntityContainer::prependEntity(RS_Entity* entity){
     if (!entity) return;
+    const bool hadSelection = hasSelection();
     entities.prepend(entity);
+    trackEntity(entity);
+    notifySelection(hadSelection);
     if (autoUpdateBorders)
         adjustBorders(entity);
 }
@@ -441,7 +457,10 @@ void RS_EntityContainer::moveEntity(int index, QList<RS_Entity *>& entList){
 void RS_EntityContainer::insertEntity(int index, RS_Entity* entity) {
     if (!entity) return;
 
+    const bool hadSelection = hasSelection();
     entities.insert(index, entity);
+    trackEntity(entity);
+    notifySelection(hadSelection);
 
     if (autoUpdateBorders) {
         adjustBorders(entity);
@@ -479,13 +498,19 @@ bool RS_EntityContainer::removeEntity(RS_Entity* entity) {
     //RLZ TODO: in Q3PtrList if 'entity' is nullptr remove the current item-> at.(entIdx)
     //    and sets 'entIdx' in next() or last() if 'entity' is the last item in the list.
     //    in LibreCAD is never called with nullptr
+    const bool hadSelection = hasSelection();
     bool ret = entities.removeOne(entity);
 
+    if (ret) {
+        invalidateBorders(entity);
+        untrackEntity(entity);
+        notifySelection(hadSelection);
+    }
     if (autoDelete && ret) {
         delete entity;
     }
     if (autoUpdateBorders) {
-        calculateBorders();
+        updateBorders();
     }
     return ret;
 }
@@ -496,12 +521,16 @@ bool RS_EntityContainer::removeEntity(RS_Entity* entity) {
  * Erases all entities in this container and resets the borders..
  */
 void RS_EntityContainer::clear() {
+    const bool hadSelection = hasSelection();
+    untrackAll();
     if (autoDelete) {
         while (!entities.isEmpty())
             delete entities.takeFirst();
     } else
         entities.clear();
     resetBorders();
+    bordersDirty = false;
+    notifySelection(hadSelection);
 }
 
 unsigned int RS_EntityContainer::count() const{
@@ -529,7 +558,7 @@ unsigned RS_EntityContainer::countSelected(bool deep, QList<RS2::EntityType> con
     unsigned c=0;
     std::set<RS2::EntityType> type{types.cbegin(), types.cend()};
 
-    for (RS_Entity* t: entities){
+    for (RS_Entity* t: selectionCandidates()){
 
         if (t->isSelected())
 	    if (!types.size() || type.count(t->rtti()))
@@ -547,7 +576,7 @@ unsigned RS_EntityContainer::countSelected(bool deep, QList<RS2::EntityType> con
  */
 double RS_EntityContainer::totalSelectedLength() {
     double ret(0.0);
-    for (RS_Entity* e: entities){
+    for (RS_Entity* e: selectionCandidates()){
 
         if (e->isVisible() && e->isSelected()) {
             double l = e->getLength();
@@ -559,6 +588,114 @@ double RS_EntityContainer::totalSelectedLength() {
     return ret;
 }
 
+std::vector<RS_Entity*> RS_EntityContainer::getSelectedEntities() const {
+    std::vector<RS_Entity*> ordered;
+    if (!isSelectionTracked()) {
+        for (RS_Entity* e: entities) {
+            if (e != nullptr && e->isSelected())
+                ordered.push_back(e);
+        }
+        return ordered;
+    }
+
+    std::unordered_set<RS_Entity*> selected;
+    for (RS_Entity* e: selection.entities) {
+        if (e->isSelected())
+            selected.insert(e);
+    }
+    // the set has no order, pick the entities from the list in its order
+    ordered.reserve(selected.size());
+    for (RS_Entity* e: entities) {
+        if (ordered.size() == selected.size())
+            break;
+        if (selected.count(e) > 0)
+            ordered.push_back(e);
+    }
+    return ordered;
+}
+
+bool RS_EntityContainer::hasSelection() const {
+    return !selection.entities.empty() || !isSelectionTracked();
+}
+
+bool RS_EntityContainer::isSelectionTracked() const {
+    return selection.tracked == entities.size();
+}
+
+std::vector<RS_Entity*> RS_EntityContainer::selectionCandidates() const {
+    if (!isSelectionTracked()) {
+        std::vector<RS_Entity*> candidates;
+        candidates.reserve(entities.size());
+        for (RS_Entity* e: entities) {
+            if (e != nullptr)
+                candidates.push_back(e);
+        }
+        return candidates;
+    }
+    return std::vector<RS_Entity*>(selection.entities.cbegin(), selection.entities.cend());
+}
+
+bool RS_EntityContainer::isSelectionCandidate(RS_Entity* entity) {
+    return entity->getFlag(RS2::FlagSelected)
+           || (entity->isContainer() && static_cast<RS_EntityContainer*>(entity)->hasSelection());
+}
+
+void RS_EntityContainer::trackEntity(RS_Entity* entity) {
+    RS_EntityContainer* owner = entity->selectionOwner.container;
+    if (owner == this)
+        return;
+    if (owner != nullptr) {
+        // listed by another container too, e.g. a temporary one
+        if (entity->getParent() != this)
+            return;
+        const bool hadSelection = owner->hasSelection();
+        owner->untrackEntity(entity);
+        owner->notifySelection(hadSelection);
+    }
+    entity->selectionOwner.container = this;
+    selection.tracked++;
+    if (isSelectionCandidate(entity))
+        selection.entities.insert(entity);
+}
+
+void RS_EntityContainer::untrackEntity(RS_Entity* entity) {
+    if (entity->selectionOwner.container != this)
+        return;
+    entity->selectionOwner.container = nullptr;
+    selection.tracked--;
+    selection.entities.erase(entity);
+}
+
+void RS_EntityContainer::untrackAll() {
+    for (RS_Entity* e: entities) {
+        if (e != nullptr && e->selectionOwner.container == this)
+            e->selectionOwner.container = nullptr;
+    }
+    selection.entities.clear();
+    selection.tracked = 0;
+}
+
+void RS_EntityContainer::updateSelection(RS_Entity* entity) {
+    const bool hadSelection = hasSelection();
+    if (isSelectionCandidate(entity))
+        selection.entities.insert(entity);
+    else
+        selection.entities.erase(entity);
+    notifySelection(hadSelection);
+}
+
+void RS_EntityContainer::forgetEntity(RS_Entity* entity) {
+    const bool hadSelection = hasSelection();
+    untrackEntity(entity);
+    notifySelection(hadSelection);
+}
+
+void RS_EntityContainer::notifySelection(bool hadSelection) {
+    RS_EntityContainer* owner = selectionOwner.container;
+    if (owner != nullptr && hadSelection != hasSelection())
+        owner->updateSelection(this);
+}
+
 
 /**
  * Adjusts the borders of this graphic (max/min values)
@@ -591,6 +728,7 @@ void RS_EntityContainer::calculateBorders() {
     RS_DEBUG->print("RS_EntityContainer::calculateBorders");
 
     resetBorders();
+    bordersDirty = false;
     for (RS_Entity* e: entities){
 
         RS_Layer* layer = e->getLayer();
@@ -601,25 +739,16 @@ void RS_EntityContainer::calculateBorders() {
         if (e->isVisible() && !(layer && layer->isFrozen())) {
             e->calculateBorders();
             adjustBorders(e);
+        } else if (e->isContainer()) {
+            // hidden containers don't count, but must not stay outdated
+            static_cast<RS_EntityContainer*>(e)->updateBorders();
         }
     }
 
     RS_DEBUG->print("RS_EntityContainer::calculateBorders: size 1: %f,%f",
                     getSize().x, getSize().y);
 
-    // needed for correcting corrupt data (PLANS.dxf)
-    if (minV.x>maxV.x || minV.x>RS_MAXDOUBLE || maxV.x>RS_MAXDOUBLE
-            || minV.x<RS_MINDOUBLE || maxV.x<RS_MINDOUBLE) {
-
-        minV.x = 0.0;
-        maxV.x = 0.0;
-    }
-    if (minV.y>maxV.y || minV.y>RS_MAXDOUBLE || maxV.y>RS_MAXDOUBLE
-            || minV.y<RS_MINDOUBLE || maxV.y<RS_MINDOUBLE) {
-
-        minV.y = 0.0;
-        maxV.y = 0.0;
-    }
+    correctBorders();
 
     RS_DEBUG->print("RS_EntityContainer::calculateBorders: size: %f,%f",
                     getSize().x, getSize().y);
@@ -648,6 +777,7 @@ void RS_EntityContainer::forcedCalculateBorders() {
     //RS_DEBUG->print("RS_EntityContainer::calculateBorders");
 
     resetBorders();
+    bordersDirty = false;
     for (RS_Entity* e: entities){
 
         //RS_Layer* layer = e->getLayer();
@@ -660,7 +790,70 @@ void RS_EntityContainer::forcedCalculateBorders() {
         adjustBorders(e);
     }
 
-    // needed for correcting corrupt data (PLANS.dxf)
+    correctBorders();
+
+    //RS_DEBUG->print("  borders: %f/%f %f/%f", minV.x, minV.y, maxV.x, maxV.y);
+
+    //printf("borders: %lf/%lf  %lf/%lf\n", minV.x, minV.y, maxV.x, maxV.y);
+    //RS_Entity::calculateBorders();
+}
+
+/**
+ * The borders of an entity only need to be recalculated when an entity
+ * on them is removed or hidden. Entities inside the borders are removed
+ * without touching the others.
+ */
+void RS_EntityContainer::invalidateBorders(const RS_Entity* entity) {
+    if (bordersDirty || entity == nullptr
+            || (entity->isContainer() && entity->count() == 0)) {
+        return;
+    }
+
+    const RS_Vector min = entity->getMin();
+    const RS_Vector max = entity->getMax();
+    if (min.x > minV.x + RS_TOLERANCE && min.y > minV.y + RS_TOLERANCE
+            && max.x < maxV.x - RS_TOLERANCE && max.y < maxV.y - RS_TOLERANCE) {
+        return;
+    }
+
+    // an outdated container has outdated parents: recalculating a parent
+    // also updates the outdated children, hidden ones included
+    bordersDirty = true;
+    if (isListedInParent()) {
+        parent->invalidateBorders(this);
+    }
+}
+
+/**
+ * Recalculates outdated borders with the same entities as calculateBorders(),
+ * outdated sub-containers are updated first.
+ */
+void RS_EntityContainer::updateBorders() {
+    if (!bordersDirty) {
+        return;
+    }
+
+    resetBorders();
+    bordersDirty = false;
+    for (RS_Entity* e: entities){
+
+        RS_Layer* layer = e->getLayer();
+
+        if (e->isContainer()) {
+            static_cast<RS_EntityContainer*>(e)->updateBorders();
+        }
+        if (e->isVisible() && !(layer && layer->isFrozen())) {
+            adjustBorders(e);
+        }
+    }
+
+    correctBorders();
+}
+
+/**
+ * Resets invalid borders, needed for correcting corrupt data (PLANS.dxf)
+ */
+void RS_EntityContainer::correctBorders() {
     if (minV.x>maxV.x || minV.x>RS_MAXDOUBLE || maxV.x>RS_MAXDOUBLE
             || minV.x<RS_MINDOUBLE || maxV.x<RS_MINDOUBLE) {
 
@@ -673,39 +866,85 @@ void RS_EntityContainer::forcedCalculateBorders() {
         minV.y = 0.0;
         maxV.y = 0.0;
     }
-
-    //RS_DEBUG->print("  borders: %f/%f %f/%f", minV.x, minV.y, maxV.x, maxV.y);
-
-    //printf("borders: %lf/%lf  %lf/%lf\n", minV.x, minV.y, maxV.x, maxV.y);
-    //RS_Entity::calculateBorders();
 }
 
 /**
  * Updates all Dimension entities in this container and / or
  * reposition their labels.
  *
+ * The dimension style is resolved once for all dimensions and the
+ * dimensions are regenerated in parallel. Fonts are read only meanwhile,
+ * dimensions which needed to load a font or letter are regenerated
+ * again afterwards.
+ *
  * @param autoText Automatically reposition the text label bool autoText=true
  */
 void RS_EntityContainer::updateDimensions(bool autoText) {
 
     RS_DEBUG->print("RS_EntityContainer::updateDimensions()");
 
-    //for (RS_Entity* e=firstEntity(RS2::ResolveNone);
-    //        e;
-    //        e=nextEntity(RS2::ResolveNone)) {
+    std::vector<RS_Dimension*> dimensions;
+    std::vector<RS_Entity*> leaders;
+    collectDimensions(dimensions, leaders);
+
+    if (!dimensions.empty()) {
+        RS_DimensionStyle style = dimensions.front()->resolveStyle();
+        // load the font of the labels before fonts become read only
+        RS_Font* font = RS_FONTLIST->requestFont(style.textStyle);
+        if (font != nullptr) {
+            for (const QChar& c: QString("0123456789.,-+'\"%<> "))
+                font->findLetter(QString(c));
+        }
+
+        // regenerated dimensions must not notify the shared containers
+        // tracking their selection, those are updated once afterwards
+        std::vector<RS_EntityContainer*> owners(dimensions.size(), nullptr);
+        for (size_t i = 0; i < dimensions.size(); ++i) {
+            owners[i] = dimensions[i]->selectionOwner.container;
+            dimensions[i]->selectionOwner.container = nullptr;
+        }
 
+        std::vector<char> missing(dimensions.size(), 0);
+        RS_Font::setReadOnly(true);
+        LC_Parallel::forEachIndex(dimensions.size(), [&](size_t i) {
+            RS_Font::resetMissing();
+            dimensions[i]->setResolvedStyle(&style);
+            dimensions[i]->updateDim(autoText);
+            missing[i] = RS_Font::hasMissing() ? 1 : 0;
+        }, 16);
+        RS_Font::setReadOnly(false);
+
+        for (size_t i = 0; i < dimensions.size(); ++i) {
+            if (missing[i] != 0)
+                dimensions[i]->updateDim(autoText);
+            dimensions[i]->setResolvedStyle(nullptr);
+            dimensions[i]->selectionOwner.container = owners[i];
+            if (owners[i] != nullptr)
+                owners[i]->updateSelection(dimensions[i]);
+        }
+    }
+
+    for (RS_Entity* e: leaders)
+        e->update();
+
+    RS_DEBUG->print("RS_EntityContainer::updateDimensions() OK");
+}
+
+/**
+ * Collects the dimensions and leaders of this container and of all
+ * nested containers.
+ */
+void RS_EntityContainer::collectDimensions(std::vector<RS_Dimension*>& dimensions,
+                                           std::vector<RS_Entity*>& leaders) const {
     for (RS_Entity* e: entities){
         if (RS_Information::isDimension(e->rtti())) {
-            // update and reposition label:
-            ((RS_Dimension*)e)->updateDim(autoText);
+            dimensions.push_back(static_cast<RS_Dimension*>(e));
         } else if(e->rtti()==RS2::EntityDimLeader)
-            e->update();
+            leaders.push_back(e);
         else if (e->isContainer()) {
-            ((RS_EntityContainer*)e)->updateDimensions(autoText);
+            static_cast<RS_EntityContainer*>(e)->collectDimensions(dimensions, leaders);
         }
     }
-
-    RS_DEBUG->print("RS_EntityContainer::updateDimensions() OK");
 }
 
 
@@ -1155,10 +1394,17 @@ RS_Entity* RS_EntityContainer::entityAt(int index) {
 }
 
 void RS_EntityContainer::setEntityAt(int index,RS_Entity* en){
-    if(autoDelete && entities.at(index)) {
-        delete entities.at(index);
-    }
+    const bool hadSelection = hasSelection();
+    RS_Entity* old = entities.at(index);
     entities[index] = en;
+    if (old != nullptr)
+        untrackEntity(old);
+    if(autoDelete && old) {
+        delete old;
+    }
+    if (en != nullptr)
+        trackEntity(en);
+    notifySelection(hadSelection);
 }
 
 /**
@@ -1171,11 +1417,10 @@ int RS_EntityContainer::entityAt() {
 
 
 /**
- * Finds the given entity and makes it the current entity if found.
+ * @return the index of the given entity, or -1 if it isn't in this container
  */
-int RS_EntityContainer::findEntity(RS_Entity const* const entity) {
-    entIdx = entities.indexOf(const_cast<RS_Entity*>(entity));
-    return entIdx;
+int RS_EntityContainer::findEntity(RS_Entity const* const entity) const {
+    return entities.indexOf(const_cast<RS_Entity*>(entity));
 }
 
 /**
@@ -1363,9 +1608,8 @@ RS_Vector RS_EntityContainer::getNearestIntersection(const RS_Vector& coord,
     closestEntity = getNearestEntity(coord, nullptr, RS2::ResolveAllButTextImage);
 
     if (closestEntity) {
-        for (RS_Entity* en = firstEntity(RS2::ResolveAllButTextImage);
-             en;
-             en = nextEntity(RS2::ResolveAllButTextImage)) {
+        LC_ContainerTraverser traverser{*this, RS2::ResolveAllButTextImage};
+        for (RS_Entity* en = traverser.first(); en; en = traverser.next()) {
             if (
                     !en->isVisible()
                     || en->getParent()->ignoredSnap()
@@ -29,10 +29,13 @@
 #define RS_ENTITYCONTAINER_H
 
 #include <memory>
+#include <unordered_set>
 #include <vector>
 #include <QList>
 #include "rs_entity.h"
 
+class RS_Dimension;
+
 /**
  * Class representing a tree of entities.
  * Typical entity containers are graphics, polylines, groups, texts, ...)
@@ -94,6 +97,10 @@ public:
 	virtual void moveEntity(int index, QList<RS_Entity *>& entList);
     virtual void insertEntity(int index, RS_Entity* entity);
     virtual bool removeEntity(RS_Entity* entity);
+    /**
+     * Called after the layer of a child entity was changed.
+     */
+    virtual void entityLayerChanged(RS_Entity* /*entity*/, RS_Layer* /*previous*/) {}
 
 	//!
 	//! \brief addRectangle add four lines to form a rectangle by
@@ -102,6 +109,12 @@ public:
 	//!
 	void addRectangle(RS_Vector const& v0, RS_Vector const& v1);
 
+    /**
+     * The iteration with firstEntity(), nextEntity(), lastEntity() and
+     * prevEntity() keeps its position in the container and must not be
+     * nested or run concurrently. Use LC_ContainerTraverser or a range
+     * based loop in new code.
+     */
     virtual RS_Entity* firstEntity(RS2::ResolveLevel level=RS2::ResolveNone) const;
     virtual RS_Entity* lastEntity(RS2::ResolveLevel level=RS2::ResolveNone) const;
     virtual RS_Entity* nextEntity(RS2::ResolveLevel level=RS2::ResolveNone) const;
@@ -109,7 +122,7 @@ public:
     virtual RS_Entity* entityAt(int index);
 	virtual void setEntityAt(int index,RS_Entity* en);
 //RLZ unused	virtual int entityAt();
-		virtual int findEntity(RS_Entity const* const entity);
+		virtual int findEntity(RS_Entity const* const entity) const;
     virtual void clear();
 
     //virtual unsigned long int count() {
@@ -127,6 +140,13 @@ public:
 	*/
     virtual unsigned countSelected(bool deep=true, QList<RS2::EntityType> const& types = {});
     virtual double totalSelectedLength();
+    /**
+     * @return the visible selected entities of this container, without
+     * the selected entities within them. The selection is tracked by the
+     * container, the entities are returned in the order of the container,
+     * which is the drawing order.
+     */
+    std::vector<RS_Entity*> getSelectedEntities() const;
 
     /**
      * Enables / disables automatic update of borders on entity removals
@@ -138,6 +158,16 @@ public:
     virtual void adjustBorders(RS_Entity* entity);
 	void calculateBorders() override;
 	void forcedCalculateBorders();
+    /**
+     * Marks the borders as outdated if the entity, which is about to be
+     * removed or hidden, lies on them. The parents are marked as well.
+     */
+    void invalidateBorders(const RS_Entity* entity);
+    /**
+     * Recalculates outdated borders from the borders of the entities,
+     * without recalculating the entities themselves.
+     */
+    virtual void updateBorders();
 	void updateDimensions( bool autoText=true);
     virtual void updateInserts();
     virtual void updateSplines();
@@ -260,14 +290,78 @@ protected:
      */
     bool autoUpdateBorders = true;
 
+    /**
+     * An entity on the borders was removed or hidden, the borders
+     * may be too large until updateBorders() is called.
+     */
+    bool bordersDirty = false;
+
 private:
+    friend class RS_Entity;
+
+	void correctBorders();
+    /**
+     * @return false if no entity within this container is selected. True
+     * if some may be selected, e.g. if the container lists entities whose
+     * selection is tracked by another container.
+     */
+    bool hasSelection() const;
+    /**
+     * @return true if the selection of all listed entities is tracked by
+     * this container
+     */
+    bool isSelectionTracked() const;
+    /**
+     * @return the entities which are selected or may contain selected
+     * entities, in no particular order
+     */
+    std::vector<RS_Entity*> selectionCandidates() const;
+    static bool isSelectionCandidate(RS_Entity* entity);
+    /**
+     * Starts or stops tracking the selection of a listed entity. Tracking
+     * is taken over from another container only by the parent.
+     */
+    void trackEntity(RS_Entity* entity);
+    void untrackEntity(RS_Entity* entity);
+    void untrackAll();
+    /**
+     * Called after the selection of a tracked entity, or within it, changed.
+     */
+    void updateSelection(RS_Entity* entity);
+    /**
+     * Called by a tracked entity which is deleted.
+     */
+    void forgetEntity(RS_Entity* entity);
+    /**
+     * Tells the container tracking this one if hasSelection() changed.
+     */
+    void notifySelection(bool hadSelection);
 	/**
 	 * @brief ignoredSnap whether snapping is ignored
 	 * @return true when entity of this container won't be considered for snapping points
 	 */
 	bool ignoredSnap() const;
+    void collectDimensions(std::vector<RS_Dimension*>& dimensions,
+                           std::vector<RS_Entity*>& leaders) const;
     mutable int entIdx = 0;
     bool autoDelete = false;
+
+    /**
+     * Listed entities whose selection is tracked by this container and
+     * which are selected or contain selected entities. Not copied with the
+     * container, a copy starts with untracked entities.
+     */
+    struct Selection {
+        std::unordered_set<RS_Entity*> entities;
+        //! number of tracked entities
+        int tracked = 0;
+
+        Selection() = default;
+        Selection(const Selection&) {}
+        Selection& operator = (const Selection&) {
+            return *this;
+        }
+    } selection;
 };
 
 #endif
@@ -24,6 +24,7 @@
 **
 **********************************************************************/
 
+#include <atomic>
 #include <iostream>
 
 #include <QRegularExpression>
@@ -41,6 +42,11 @@
 
 namespace {
 
+// fonts are not modified while set, see RS_Font::setReadOnly()
+std::atomic<bool> fontsReadOnly{false};
+// a font or letter was missing in the calling thread while read only
+thread_local bool fontMissing = false;
+
 // Encode a unicode character from its hexdecimal string
 // "0x20" is encoded to the character '0'
 QString charFromHex(const QString& hexCode)
@@ -103,6 +109,10 @@ bool RS_Font::loadFont() {
     if (loaded) {
         return true;
     }
+    if (fontsReadOnly) {
+        fontMissing = true;
+        return false;
+    }
 
     QString path;
 
@@ -496,9 +506,29 @@ RS_Block* RS_Font::generateLffFont(const QString& key){
 RS_Block* RS_Font::findLetter(const QString& name) {
     RS_Block* ret= letterList.find(name);
     if (ret) return ret;
+    if (fontsReadOnly) {
+        fontMissing = true;
+        return nullptr;
+    }
     return generateLffFont(name);
 
 }
+
+void RS_Font::setReadOnly(bool readOnly) {
+    fontsReadOnly = readOnly;
+}
+
+void RS_Font::resetMissing() {
+    fontMissing = false;
+}
+
+/**
+ * @return true if the calling thread requested a font or letter which
+ * was not available while fonts were read only.
+ */
+bool RS_Font::hasMissing() {
+    return fontMissing;
+}
 /**
  * Dumps the fonts data to stdout.
  */
@@ -91,6 +91,16 @@ public:
 
     bool loadFont();
 
+    /**
+     * While fonts are read only, no font is loaded and no letter is
+     * generated, so that loaded fonts can be used from several threads.
+     * Requests which would have needed to change a font are recorded
+     * per thread, see hasMissing().
+     */
+    static void setReadOnly(bool readOnly);
+    static void resetMissing();
+    static bool hasMissing();
+
     void generateAllFonts();
 
     // Wrappers for block list (letters) functions
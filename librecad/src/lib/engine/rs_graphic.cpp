@@ -32,6 +32,7 @@
 #include "rs_graphic.h"
 
 #include "dxf_format.h"
+#include "lc_bulkgeometry.h"
 #include "lc_defaults.h"
 #include "rs_block.h"
 #include "rs_debug.h"
@@ -113,15 +114,11 @@ RS_Graphic::~RS_Graphic() = default;
  */
 unsigned long int RS_Graphic::countLayerEntities(RS_Layer* layer) {
 
-    int c=0;
+    unsigned long int c=0;
 
 	if (layer) {
-        for(RS_Entity* t: entities){
-
-			if (t->getLayer() &&
-                    t->getLayer()->getName()==layer->getName()) {
-                c+=t->countDeep();
-            }
+        for(RS_Entity* t: layerIndex.entities(layer)){
+            c+=t->countDeep();
         }
     }
 
@@ -138,21 +135,36 @@ void RS_Graphic::removeLayer(RS_Layer* layer) {
     if (layer && layer->getName()!="0") {
 
 		std::vector<RS_Entity*> toRemove;
+		// bulk containers with some of their elements on that layer:
+		std::vector<LC_BulkGeometry*> toReduce;
 		//find entities on layer
         for(RS_Entity* e: entities){
-			if (e->getLayer() &&
+            if (e->rtti() == RS2::EntityBulkGeometry) {
+                // only the elements on that layer are removed:
+                if (!e->isUndone()
+                        && static_cast<LC_BulkGeometry*>(e)->hasElementsOnLayer(layer))
+                    toReduce.push_back(static_cast<LC_BulkGeometry*>(e));
+            } else if (e->getLayer() &&
                     e->getLayer()->getName()==layer->getName()) {
 				toRemove.push_back(e);
             }
         }
 		// remove all entities on that layer:
-		if(toRemove.size()){
+		if(toRemove.size() || toReduce.size()){
 			startUndoCycle();
             for(RS_Entity* e: toRemove){
 				e->setUndoState(true);
 				e->setLayer("0");
 				addUndoable(e);
 			}
+            // replace bulk containers by copies without the elements on that layer
+            for(LC_BulkGeometry* bulk: toReduce){
+                RS_Entity* reduced = bulk->cloneWithoutLayer(layer);
+                addEntity(reduced);
+                addUndoable(reduced);
+                bulk->setUndoState(true);
+                addUndoable(bulk);
+            }
 			endUndoCycle();
 		}
 
@@ -174,6 +186,7 @@ void RS_Graphic::removeLayer(RS_Layer* layer) {
 			e->setLayer("0");
 		}
 
+        layerIndex.removeLayer(layer);
         layerList.remove(layer);
     }
 }
@@ -996,7 +1009,10 @@ bool RS_Graphic::isBiggerThanPaper() {
 
 void RS_Graphic::addEntity(RS_Entity* entity)
 {
+    if (entity == nullptr)
+        return;
     RS_EntityContainer::addEntity(entity);
+    layerIndex.add(entity);
     if( entity->rtti() == RS2::EntityBlock ||
             entity->rtti() == RS2::EntityContainer){
         RS_EntityContainer* e=static_cast<RS_EntityContainer*>(entity);
@@ -1007,6 +1023,56 @@ void RS_Graphic::addEntity(RS_Entity* entity)
 }
 
 
+void RS_Graphic::appendEntity(RS_Entity* entity)
+{
+    if (entity == nullptr)
+        return;
+    RS_EntityContainer::appendEntity(entity);
+    layerIndex.add(entity);
+}
+
+void RS_Graphic::prependEntity(RS_Entity* entity)
+{
+    if (entity == nullptr)
+        return;
+    RS_EntityContainer::prependEntity(entity);
+    layerIndex.add(entity);
+}
+
+void RS_Graphic::insertEntity(int index, RS_Entity* entity)
+{
+    if (entity == nullptr)
+        return;
+    RS_EntityContainer::insertEntity(index, entity);
+    layerIndex.add(entity);
+}
+
+bool RS_Graphic::removeEntity(RS_Entity* entity)
+{
+    // the entity may be deleted by the container
+    layerIndex.remove(entity);
+    return RS_EntityContainer::removeEntity(entity);
+}
+
+void RS_Graphic::setEntityAt(int index, RS_Entity* entity)
+{
+    layerIndex.remove(entityAt(index));
+    RS_EntityContainer::setEntityAt(index, entity);
+    layerIndex.add(entity);
+}
+
+void RS_Graphic::clear()
+{
+    layerIndex.clear();
+    RS_EntityContainer::clear();
+}
+
+void RS_Graphic::entityLayerChanged(RS_Entity* entity, RS_Layer* previous)
+{
+    layerIndex.layerChanged(entity, previous);
+}
+
+
 /**
  * Dumps the entities to stdout.
  */
@@ -30,6 +30,7 @@
 #define RS_GRAPHIC_H
 
 #include <QDateTime>
+#include "lc_layerindex.h"
 #include "rs_blocklist.h"
 #include "rs_layerlist.h"
 #include "rs_variabledict.h"
@@ -94,6 +95,17 @@ public:
         layerList.add(layer);
     }
     void addEntity(RS_Entity* entity) override;
+    void appendEntity(RS_Entity* entity) override;
+    void prependEntity(RS_Entity* entity) override;
+    void insertEntity(int index, RS_Entity* entity) override;
+    bool removeEntity(RS_Entity* entity) override;
+    void setEntityAt(int index, RS_Entity* entity) override;
+    void clear() override;
+    void entityLayerChanged(RS_Entity* entity, RS_Layer* previous) override;
+    /** @return index of the top level entities by layer */
+    const LC_LayerIndex& getLayerIndex() const {
+        return layerIndex;
+    }
     virtual void removeLayer(RS_Layer* layer);
     virtual void editLayer(RS_Layer* layer, const RS_Layer& source) {
         layerList.edit(layer, source);
@@ -349,6 +361,7 @@ private:
         QString currentFileName; //keep a copy of filename for the modifiedTime
 
         RS_LayerList layerList;
+        LC_LayerIndex layerIndex;
         RS_BlockList blockList;
         RS_VariableDict variableDict;
         RS2::CrosshairType crosshairType; //crosshair type used by isometric grid
@@ -33,6 +33,7 @@
 #include <QString>
 
 #include "lc_looputils.h"
+#include "lc_profiler.h"
 
 #include "rs_arc.h"
 #include "rs_circle.h"
@@ -199,6 +200,22 @@ void RS_Hatch::calculateBorders() {
 
 
 
+/**
+ * Updates outdated borders including the contour.
+ */
+void RS_Hatch::updateBorders() {
+    if (!bordersDirty) {
+        return;
+    }
+    activateContour(true);
+
+    RS_EntityContainer::updateBorders();
+
+    activateContour(false);
+}
+
+
+
 /**
  * Updates the Hatch. Called when the
  * hatch or it's data, position, alignment, .. changes.
@@ -219,6 +236,7 @@ void RS_Hatch::update() {
         RS_DEBUG->print(RS_Debug::D_NOTICE, "RS_Hatch::update: skip hatch forbidden to update");
         return;
     }
+    LC_PROFILE_SCOPE("RS_Hatch::update");
 
     if (data.solid==true) {
         RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Hatch::update: processing solid hatch");
@@ -390,11 +408,10 @@ void RS_Hatch::update() {
         }
     }
 
+    // the pattern lies within the contour, the borders don't change
     addEntity(hatch);
     //getGraphic()->addEntity(rubbish);
 
-    forcedCalculateBorders();
-
     // deactivate contour:
     activateContour(false);
 
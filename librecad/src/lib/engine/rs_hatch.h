@@ -133,6 +133,7 @@ public:
     double getTotalArea();
 
     void calculateBorders() override;
+    void updateBorders() override;
     void update() override;
     int getUpdateError() {
             return updateError;
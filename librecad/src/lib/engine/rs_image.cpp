@@ -23,13 +23,18 @@
 ** This copyright notice MUST APPEAR in all copies of the script!
 **
 **********************************************************************/
+#include <cmath>
 #include<iostream>
 #include <QDir>
 #include <QFileInfo>
 #include <QImage>
 
+#include "lc_imageloader.h"
+#include "lc_imagepyramid.h"
+#include "lc_rect.h"
 #include "rs_debug.h"
 #include "rs_document.h"
+#include "rs_graphic.h"
 #include "rs_graphicview.h"
 #include "rs_image.h"
 #include "rs_line.h"
@@ -119,6 +124,10 @@ void RS_Image::updateData(RS_Vector size, RS_Vector Uv, RS_Vector Vv) {
 }
 
 
+/**
+ * Loads the image file in the background. The image is drawn as a frame
+ * until it's loaded.
+ */
 void RS_Image::update() {
 
     RS_DEBUG->print("RS_Image::update");
@@ -126,50 +135,54 @@ void RS_Image::update() {
     // the whole image:
     QString filePathName = imageRelativePathName(data.file);
 
-    //QImage image = QImage(data.file);
-    img = std::make_shared<QImage>(filePathName);
-	if (!img->isNull()) {
-		data.size = RS_Vector(img->width(), img->height());
-		calculateBorders(); // image update need this.
-    } else {
-        LC_LOG(RS_Debug::D_ERROR)<<"RS_Image::"<<__func__<<"(): image file not found: "<<data.file<<"("<<filePathName<<")";
-    }
+    RS_SETTINGS->beginGroup("/Appearance");
+    bool persistent = RS_SETTINGS->readNumEntry("/ImageTileCache", 1) != 0;
+    RS_SETTINGS->endGroup();
+
+    pyramid.reset();
+    loadToken = std::make_shared<char>(0);
+    std::weak_ptr<char> token = loadToken;
+    LC_ImageLoader::instance()->load(filePathName, persistent,
+                                     [this, token](const std::shared_ptr<LC_ImagePyramid>& loaded) {
+        // the image was deleted or reloaded meanwhile
+        if (token.expired() || token.lock() != loadToken)
+            return;
+        imageLoaded(loaded);
+    });
 
     RS_DEBUG->print("RS_Image::update: OK");
+}
 
-    /*
-    // number of small images:
-    nx = image.width()/100;
-    ny = image.height()/100;
-
-    // create small images:
-    img = new QImage*[nx];
-    QPixmap pm;
-    int w,h;
-    for (int x = 0; x<nx; ++x) {
-        img[x] = new QImage[ny];
-        for (int y = 0; y<ny; ++y) {
-                if (x<nx-1) {
-                        w = 100;
-                }
-                else {
-                        w = image.width()%100;
-                }
-
-                if (y<ny-1) {
-                        h = 100;
-                }
-                else {
-                        h = image.height()%100;
-                }
-
-                pm = QPixmap(w, h);
-                RS_PainterQt painter(&pm);
-                painter.drawImage(-x*100, -y*100, image);
-                img[x][y] = pm.convertToImage();
+void RS_Image::imageLoaded(const std::shared_ptr<LC_ImagePyramid>& loaded) {
+    loadToken.reset();
+    pyramid = loaded;
+    if (pyramid) {
+        const RS_Vector size(pyramid->size().width(), pyramid->size().height());
+        if (size != data.size) {
+            data.size = size;
+            calculateBorders(); // image update need this.
+            if (getParent() != nullptr)
+                getParent()->adjustBorders(this);
         }
+    } else {
+        LC_LOG(RS_Debug::D_ERROR)<<"RS_Image::"<<__func__<<"(): image file not found: "<<data.file;
     }
-    */
+    redrawImage();
+}
+
+/**
+ * Redraws the area of the image in the view of its graphic.
+ */
+void RS_Image::redrawImage() {
+    RS_Graphic* graphic = getGraphic();
+    RS_GraphicView* view = graphic != nullptr ? graphic->getGraphicView() : nullptr;
+    if (view == nullptr)
+        return;
+    // images in blocks are drawn at the positions of their inserts
+    if (getParent() == graphic)
+        view->redrawArea(getMin(), getMax());
+    else
+        view->redraw(RS2::RedrawDrawing);
 }
 
 
@@ -379,22 +392,73 @@ void RS_Image::mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2)
 
 
 
+/**
+ * Draws the tiles of the image which are visible, from the pyramid level
+ * matching the current zoom.
+ */
 void RS_Image::draw(RS_Painter* painter, RS_GraphicView* view, double& /*patternOffset*/) {
-	if (!(painter && view) || !img.get() || img->isNull())
+	if (!(painter && view))
 		return;
-
-    // erase image:
-    //if (painter->getPen().getColor()==view->getBackground()) {
-    //	RS_VectorSolutions sol = getCorners();
-    //
-    //}
+    if (!pyramid && loadToken && view->isPrinting())
+        LC_ImageLoader::instance()->waitForAll();
+    if (!pyramid) {
+        if (loadToken)
+            drawPlaceholder(painter, view);
+        return;
+    }
 
 	RS_Vector scale{view->toGuiDX(data.uVector.magnitude()),
 								view->toGuiDY(data.vVector.magnitude())};
 
-    painter->drawImg(*img,
-                     view->toGui(data.insertionPoint),
-                     data.uVector, data.vVector, scale);
+    // visible area in image pixels, the v axis points up from the bottom row
+    const double det = RS_Vector::crossP(data.uVector, data.vVector).z;
+    if (std::abs(det) < RS_TOLERANCE2)
+        return;
+    const LC_Rect area = view->getVisibleArea();
+    const RS_Vector corners[4] = {
+        area.minP(), area.lowerLeftCorner(), area.maxP(), area.upperRightCorner()
+    };
+    RS_Vector minUV(RS_MAXDOUBLE, RS_MAXDOUBLE);
+    RS_Vector maxUV(-RS_MAXDOUBLE, -RS_MAXDOUBLE);
+    for (const RS_Vector& corner: corners) {
+        const RS_Vector d = corner - data.insertionPoint;
+        const RS_Vector uv{RS_Vector::crossP(d, data.vVector).z / det,
+                           RS_Vector::crossP(data.uVector, d).z / det};
+        minUV = RS_Vector::minimum(minUV, uv);
+        maxUV = RS_Vector::maximum(maxUV, uv);
+    }
+    const QSize size = pyramid->size();
+    const double left = std::max(minUV.x, 0.);
+    const double right = std::min(maxUV.x, double(size.width()));
+    const double top = std::max(size.height() - maxUV.y, 0.);
+    const double bottom = std::min(size.height() - minUV.y, double(size.height()));
+    if (left >= right || top >= bottom)
+        return;
+
+    const int level = pyramid->levelForScale(std::min(scale.x, scale.y));
+    const int span = LC_ImagePyramid::tileSize() << level;
+    const QSize grid = pyramid->tileGrid(level);
+    const int column0 = std::max(int(left / span), 0);
+    const int column1 = std::min(int(std::ceil(right / span)), grid.width());
+    const int row0 = std::max(int(top / span), 0);
+    const int row1 = std::min(int(std::ceil(bottom / span)), grid.height());
+
+    for (int row = row0; row < row1; ++row) {
+        for (int column = column0; column < column1; ++column) {
+            QImage tile = pyramid->tile(level, column, row);
+            if (tile.isNull())
+                continue;
+            // position of the lower left corner of the tile
+            const QRect tileArea = pyramid->tileArea(level, column, row);
+            const RS_Vector position = data.insertionPoint
+                    + data.uVector * tileArea.x()
+                    + data.vVector * (size.height() - tileArea.y() - tileArea.height());
+            const RS_Vector tileScale{scale.x * tileArea.width() / tile.width(),
+                                      scale.y * tileArea.height() / tile.height()};
+            painter->drawImg(tile, view->toGui(position),
+                             data.uVector, data.vVector, tileScale);
+        }
+    }
 
     if (isSelected() && !(view->isPrinting() || view->isPrintPreview())) {
         RS_VectorSolutions sol = getCorners();
@@ -407,6 +471,21 @@ void RS_Image::draw(RS_Painter* painter, RS_GraphicView* view, double& /*pattern
 
 
 
+/**
+ * Draws the frame and diagonals of an image which is being loaded.
+ */
+void RS_Image::drawPlaceholder(RS_Painter* painter, RS_GraphicView* view) {
+    RS_VectorSolutions sol = getCorners();
+    for (size_t i = 0; i < sol.size(); ++i){
+        size_t const j = (i+1)%sol.size();
+        painter->drawLine(view->toGui(sol.get(i)), view->toGui(sol.get(j)));
+    }
+    painter->drawLine(view->toGui(sol.get(0)), view->toGui(sol.get(2)));
+    painter->drawLine(view->toGui(sol.get(1)), view->toGui(sol.get(3)));
+}
+
+
+
 /**
  * Dumps the point's data to stdout.
  */
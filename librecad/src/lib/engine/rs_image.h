@@ -29,7 +29,7 @@
 #include <memory>
 #include "rs_atomicentity.h"
 
-class QImage;
+class LC_ImagePyramid;
 
 /**
  * Holds the data that defines a line.
@@ -220,10 +220,15 @@ protected:
 	// whether the point is within image
 	bool containsPoint(const RS_Vector& coord) const;
 	RS_ImageData data;
-    std::shared_ptr<QImage> img;
-        //QImage** img;
-        //int nx;
-        //int ny;
+    //! tiles of the image file, shared with other images of the same file
+    std::shared_ptr<LC_ImagePyramid> pyramid;
+    //! set while the image file is loaded, loads of replaced tokens are ignored
+    std::shared_ptr<char> loadToken;
+
+private:
+    void imageLoaded(const std::shared_ptr<LC_ImagePyramid>& loaded);
+    void drawPlaceholder(RS_Painter* painter, RS_GraphicView* view);
+    void redrawImage();
 };
 
 #endif
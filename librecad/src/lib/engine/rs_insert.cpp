@@ -32,6 +32,7 @@
 #include "rs_arc.h"
 #include "rs_block.h"
 #include "rs_circle.h"
+#include "lc_profiler.h"
 #include "rs_debug.h"
 #include "rs_ellipse.h"
 #include "rs_graphic.h"
@@ -128,6 +129,7 @@ void RS_Insert::update() {
         if (updateEnabled==false) {
                 return;
         }
+    LC_PROFILE_SCOPE("RS_Insert::update");
 
     clear();
 
@@ -226,7 +228,7 @@ void RS_Insert::update() {
                     ne->setSelected(isSelected());
 
                 // individual entities can be on indiv. layers
-                    RS_Pen tmpPen = updatePen(ne->getPen(false), getPen());
+                    RS_Pen tmpPen = resolveBlockPen(ne->getPen(false));
                 // now that we've evaluated all flags, let's strip them:
                 // TODO: strip all flags (width, line type)
                 //tmpPen.setColor(tmpPen.getColor().stripFlags());
@@ -254,6 +256,11 @@ void RS_Insert::update() {
 
 
 
+RS_Pen RS_Insert::resolveBlockPen(const RS_Pen& pen) const
+{
+    return updatePen(RS_Pen{pen}, getPen());
+}
+
 /**
  * @return Pointer to the block associated with this Insert or
  *   nullptr if the block couldn't be found. Blocks are requested
@@ -116,6 +116,11 @@ public:
 	RS_Block* getBlockForInsert() const;
 
     void update() override;
+    /**
+     * @return the pen of a block entity with the attributes "by block"
+     * replaced by those of this insert, as used by update()
+     */
+    RS_Pen resolveBlockPen(const RS_Pen& pen) const;
 
     QString getName() const {
         return data.name;
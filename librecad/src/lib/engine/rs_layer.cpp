@@ -28,6 +28,7 @@
 #include <iostream>
 #include <QString>
 #include <rs_debug.h>
+#include "rs_entity.h"
 #include "rs_layer.h"
 
 RS_LayerData::RS_LayerData(const QString& name,
@@ -66,7 +67,11 @@ QString RS_Layer::getName() const {
 
 /** sets the default pen for this layer. */
 void RS_Layer::setPen(const RS_Pen& pen) {
+	if (data.pen == pen && data.pen.getFlags() == pen.getFlags())
+		return;
 	data.pen = pen;
+	// entities on this layer resolve their pens from it
+	RS_Entity::invalidateResolvedPens();
 }
 
 /** @return default pen for this layer. */
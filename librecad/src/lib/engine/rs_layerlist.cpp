@@ -28,6 +28,7 @@
 #include<iostream>
 
 #include "rs_debug.h"
+#include "rs_entity.h"
 #include "rs_layerlist.h"
 #include "rs_layer.h"
 #include "rs_layerlistlistener.h"
@@ -231,6 +232,7 @@ void RS_LayerList::edit(RS_Layer* layer, const RS_Layer& source) {
     }
 
     *layer = source;
+    RS_Entity::invalidateResolvedPens();
 
     fireEdit(layer);
 }
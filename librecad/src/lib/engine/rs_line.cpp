@@ -27,6 +27,7 @@
 
 
 #include "rs_line.h"
+#include "lc_entitypool.h"
 
 #include "lc_rect.h"
 #include "qc_applicationwindow.h"
@@ -35,7 +36,6 @@
 #include "rs_debug.h"
 #include "rs_entitycontainer.h"
 #include "rs_graphicview.h"
-#include "rs_information.h"
 #include "rs_linetypepattern.h"
 #include <rs_units.h>
 #include <rs_graphic.h>
@@ -82,6 +82,15 @@ RS_Entity* RS_Line::clone() const {
 	return l;
 }
 
+void* RS_Line::operator new(std::size_t size) {
+	return LC_EntityPool::allocate<RS_Line>(size);
+}
+
+void RS_Line::operator delete(void* block, std::size_t size) {
+	LC_EntityPool::deallocate<RS_Line>(block, size);
+}
+
+
 
 
 void RS_Line::calculateBorders() {
@@ -645,49 +654,32 @@ void RS_Line::draw(RS_Painter* painter, RS_GraphicView* view, double& patternOff
 
 void RS_Line::drawInfinite(RS_Painter& painter, RS_GraphicView& view)
 {
-    LC_Rect viewportRect = view.getViewRect();
-    RS_VectorSolutions endPoints{{ getStartpoint(), getEndpoint()}};
-
-    RS_EntityContainer borders(nullptr, true);
-    borders.addRectangle(viewportRect.minP(), viewportRect.maxP());
-
-    RS_Vector pStart{view.toGui(endPoints.at(0))};
-    RS_Vector pEnd{view.toGui(endPoints.at(1))};
-    //    std::cout<<"draw line: "<<pStart<<" to "<<pEnd<<std::endl;
-    RS_Vector direction = pEnd-pStart;
-    if (direction.squared() < RS_TOLERANCE2)
+    const RS_Vector start = getStartpoint();
+    const RS_Vector direction = getEndpoint() - start;
+    if ((view.toGui(getEndpoint()) - view.toGui(start)).squared() < RS_TOLERANCE2)
         return;
 
-    RS_VectorSolutions vpIts;
-    for(RS_Entity* border: borders) {
-        auto const sol=RS_Information::getIntersection(this, border, false);
-        for(const RS_Vector& vp: sol) {
-            if (vpIts.getClosestDistance(vp) > RS_TOLERANCE * 10.)
-                vpIts.push_back(vp);
-        }
-    }
-
-    //draw construction lines up to viewport border
-    switch (vpIts.size()) {
-    case 2:
-        // no need to sort intersections
-        break;
-    case 3:
-    case 4: {
-        // will use the inner two points
-        size_t i{0};
-        for (size_t j = 0; j < vpIts.size(); ++j)
-            if (viewportRect.inArea(vpIts.at(j), RS_TOLERANCE * 10.))
-                std::swap(vpIts[j], vpIts[i++]);
-
-    }
-        break;
-    default:
-        //should not happen
+    // clip the infinite line start + t * direction to the viewport (Liang-Barsky)
+    const LC_Rect viewportRect = view.getVisibleArea();
+    double tMin = -RS_MAXDOUBLE;
+    double tMax = RS_MAXDOUBLE;
+    auto clip = [&tMin, &tMax](double p, double min, double max, double d) {
+        if (d == 0.)
+            return min <= p && p <= max;
+        double t0 = (min - p) / d;
+        double t1 = (max - p) / d;
+        if (t0 > t1)
+            std::swap(t0, t1);
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        return tMin < tMax;
+    };
+    if (!clip(start.x, viewportRect.minP().x, viewportRect.maxP().x, direction.x)
+            || !clip(start.y, viewportRect.minP().y, viewportRect.maxP().y, direction.y))
         return;
-    }
 
-    painter.drawLine(view.toGui(vpIts.get(0)), view.toGui(vpIts.get(1)));
+    //draw construction lines up to viewport border
+    painter.drawLine(view.toGui(start + direction * tMin), view.toGui(start + direction * tMax));
 }
 
 /**
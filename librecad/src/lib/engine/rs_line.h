@@ -28,6 +28,8 @@
 #pragma once
 
 
+#include <cstddef>
+
 #include "rs_atomicentity.h"
 
 
@@ -70,6 +72,10 @@ public:
 
     RS_Entity* clone() const override;
 
+    //! pooled allocation, see LC_EntityPool
+    static void* operator new(std::size_t size);
+    static void operator delete(void* block, std::size_t size);
+
     /** @return RS2::EntityLine */
     RS2::EntityType rtti() const override{
         return RS2::EntityLine;
@@ -26,6 +26,7 @@
 #include<iostream>
 #include<cmath>
 #include "rs_point.h"
+#include "lc_entitypool.h"
 #include "rs_circle.h"
 #include "rs_graphic.h"
 #include "rs_graphicview.h"
@@ -45,6 +46,15 @@ RS_Entity* RS_Point::clone() const {
 	return p;
 }
 
+void* RS_Point::operator new(std::size_t size) {
+	return LC_EntityPool::allocate<RS_Point>(size);
+}
+
+void RS_Point::operator delete(void* block, std::size_t size) {
+	LC_EntityPool::deallocate<RS_Point>(block, size);
+}
+
+
 RS2::EntityType RS_Point::rtti() const
 {
     return RS2::EntityPoint;
@@ -28,6 +28,8 @@
 #ifndef RS_POINT_H
 #define RS_POINT_H
 
+#include <cstddef>
+
 #include "rs_atomicentity.h"
 
 /**
@@ -54,6 +56,10 @@ public:
 
 	RS_Entity* clone() const override;
 
+	//! pooled allocation, see LC_EntityPool
+	static void* operator new(std::size_t size);
+	static void operator delete(void* block, std::size_t size);
+
     /**	@return RS_ENTITY_POINT */
 	RS2::EntityType rtti() const override;
 
@@ -25,12 +25,14 @@
 **********************************************************************/
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iostream>
 #include <numeric>
 
 #include "rs_spline.h"
 
+#include "lc_profiler.h"
 #include "rs_line.h"
 #include "rs_debug.h"
 #include "rs_graphicview.h"
@@ -82,17 +84,11 @@ RS_Entity* RS_Spline::clone() const{
 
 
 void RS_Spline::calculateBorders() {
-    /*minV = RS_Vector::minimum(data.startpoint, data.endpoint);
-    maxV = RS_Vector::maximum(data.startpoint, data.endpoint);
-
-    QList<RS_Vector>::iterator it;
-    for (it = data.controlPoints.begin();
-    it!=data.controlPoints.end(); ++it) {
-
-    minV = RS_Vector::minimum(*it, minV);
-    maxV = RS_Vector::maximum(*it, maxV);
-}
-    */
+    resetBorders();
+    for (const RS_Vector& vp: tessellation) {
+        minV = RS_Vector::minimum(vp, minV);
+        maxV = RS_Vector::maximum(vp, maxV);
+    }
 }
 
 
@@ -165,8 +161,10 @@ RS_Vector RS_Spline::getNearestSelectedRef( const RS_Vector& coord,
 void RS_Spline::update() {
 
     RS_DEBUG->print("RS_Spline::update");
+    LC_PROFILE_SCOPE("RS_Spline::update");
 
-    clear();
+    tessellation.clear();
+    resetBorders();
 
     if (isUndone()) {
         return;
@@ -183,8 +181,6 @@ void RS_Spline::update() {
         return;
     }
 
-    resetBorders();
-
     // wrap control points, if it's not wrapped yet
     std::vector<RS_Vector>& tControlPoints = data.controlPoints;
     if (data.closed && (data.degree == 2 || !hasWrappedControlPoints())) {
@@ -193,42 +189,27 @@ void RS_Spline::update() {
         RS_DEBUG->print(RS_Debug::D_NOTICE, "%s: controlPoints: size=%llu\n", __func__, data.controlPoints.size());
     }
 
-	const size_t npts = tControlPoints.size();
-    // order:
-    const size_t  k = data.degree + 1;
-    // resolution:
-	const size_t  p1 = getGraphicVariableInt("$SPLINESEGS", 8) * npts;
-
-	std::vector<double> h(npts+1, 1.);
-	std::vector<RS_Vector> p(p1, {0., 0.});
-    if (data.closed) {
-		rbsplinu(npts,k,p1,tControlPoints,h,p);
-    } else {
-		rbspline(npts,k,p1,tControlPoints,h,p);
+    // $SPLINESEGS limits the segments of a knot span, flat spans need less
+    const int maxSegments = std::max(1, getGraphicVariableInt("$SPLINESEGS", 8));
+    RS_Vector controlMin = tControlPoints.front();
+    RS_Vector controlMax = tControlPoints.front();
+    for (const RS_Vector& vp: tControlPoints) {
+        controlMin = RS_Vector::minimum(vp, controlMin);
+        controlMax = RS_Vector::maximum(vp, controlMax);
     }
-
-	RS_Vector prev{};
-	for (auto const& vp: p) {
-		if (prev.valid) {
-			RS_Line* line = new RS_Line{this, prev, vp};
-			line->setLayer(nullptr);
-			line->setPen(RS2::FlagInvalid);
-			addEntity(line);
-		}
-		prev = vp;
-		minV = RS_Vector::minimum(prev, minV);
-		maxV = RS_Vector::maximum(prev, maxV);
-	}
+    const double tolerance = std::max(RS_TOLERANCE, 1e-4 * controlMin.distanceTo(controlMax));
+    tessellation = flatten(tolerance, maxSegments);
+    calculateBorders();
 }
 
 RS_Vector RS_Spline::getStartpoint() const {
-   if (data.closed) return RS_Vector(false);
-   return static_cast<RS_Line*>(const_cast<RS_Spline*>(this)->firstEntity())->getStartpoint();
+   if (data.closed || tessellation.empty()) return RS_Vector(false);
+   return tessellation.front();
 }
 
 RS_Vector RS_Spline::getEndpoint() const {
-   if (data.closed) return RS_Vector(false);
-   return static_cast<RS_Line*>(const_cast<RS_Spline*>(this)->lastEntity())->getEndpoint();
+   if (data.closed || tessellation.empty()) return RS_Vector(false);
+   return tessellation.back();
 }
 
 
@@ -265,13 +246,82 @@ RS_Vector RS_Spline::getNearestEndpoint(const RS_Vector& coord,
 
 
 
-/*
-// The default implementation of RS_EntityContainer is inaccurate but
-//   has to do for now..
 RS_Vector RS_Spline::getNearestPointOnEntity(const RS_Vector& coord,
-        bool onEntity, double* dist, RS_Entity** entity) {
+                                             bool /*onEntity*/, double* dist,
+                                             RS_Entity** entity) const {
+    if (entity) {
+        *entity = const_cast<RS_Spline*>(this);
+    }
+
+    double minDist = RS_MAXDOUBLE;
+    RS_Vector ret(false);
+    if (tessellation.size() == 1) {
+        ret = tessellation.front();
+        minDist = ret.distanceTo(coord);
+    }
+    for (size_t i = 1; i < tessellation.size(); ++i) {
+        const RS_Vector& start = tessellation[i - 1];
+        const RS_Vector direction = tessellation[i] - start;
+        const double a = direction.squared();
+        RS_Vector vp = start;
+        if (a >= RS_TOLERANCE2) {
+            const double t = RS_Vector::dotP(coord - start, direction) / a;
+            vp = start + direction * std::min(1., std::max(0., t));
+        }
+        const double d = vp.distanceTo(coord);
+        if (d < minDist) {
+            minDist = d;
+            ret = vp;
+        }
+    }
+
+    if (dist) {
+        *dist = minDist;
+    }
+    return ret;
+}
+
+double RS_Spline::getDistanceToPoint(const RS_Vector& coord,
+                                     RS_Entity** entity,
+                                     RS2::ResolveLevel /*level*/,
+                                     double /*solidDist*/) const {
+    double dist = RS_MAXDOUBLE;
+    getNearestPointOnEntity(coord, true, &dist, entity);
+    return dist;
+}
+
+double RS_Spline::getLength() const {
+    double length = 0.;
+    for (size_t i = 1; i < tessellation.size(); ++i) {
+        length += tessellation[i - 1].distanceTo(tessellation[i]);
+    }
+    return length;
+}
+
+/**
+ * Line integral of the tessellation for the contour area, see
+ * RS_Line::areaLineIntegral().
+ */
+double RS_Spline::areaLineIntegral() const {
+    double integral = 0.;
+    for (size_t i = 1; i < tessellation.size(); ++i) {
+        const RS_Vector& start = tessellation[i - 1];
+        const RS_Vector& end = tessellation[i];
+        integral += 0.5 * (end.y - start.y) * (start.x + end.x);
+    }
+    return integral;
+}
+
+void RS_Spline::createEntities(RS_EntityContainer* parent,
+                               std::vector<RS_Entity*>& entities) const {
+    if (tessellation.size() < 2) {
+        return;
+    }
+    entities.reserve(entities.size() + tessellation.size() - 1);
+    for (size_t i = 1; i < tessellation.size(); ++i) {
+        entities.push_back(new RS_Line{parent, tessellation[i - 1], tessellation[i]});
+    }
 }
-*/
 
 
 
@@ -311,10 +361,13 @@ RS_Vector RS_Spline::getNearestDist(double /*distance*/,
 
 
 void RS_Spline::move(const RS_Vector& offset) {
-    RS_EntityContainer::move(offset);
+	moveBorders(offset);
 	for (RS_Vector& vp: data.controlPoints) {
 		vp.move(offset);
     }
+	for (RS_Vector& vp: tessellation) {
+		vp.move(offset);
+	}
 }
 
 
@@ -326,11 +379,13 @@ void RS_Spline::rotate(const RS_Vector& center, const double& angle) {
 
 
 void RS_Spline::rotate(const RS_Vector& center, const RS_Vector& angleVector) {
-	RS_EntityContainer::rotate(center, angleVector);
 	for (RS_Vector& vp: data.controlPoints) {
 		vp.rotate(center, angleVector);
 	}
-//    update();
+	for (RS_Vector& vp: tessellation) {
+		vp.rotate(center, angleVector);
+	}
+	calculateBorders();
 }
 
 void RS_Spline::scale(const RS_Vector& center, const RS_Vector& factor) {
@@ -373,6 +428,7 @@ void RS_Spline::moveRef(const RS_Vector& ref, const RS_Vector& offset) {
 
 void RS_Spline::revertDirection() {
 	std::reverse(data.controlPoints.begin(), data.controlPoints.end());
+	std::reverse(tessellation.begin(), tessellation.end());
 }
 
 
@@ -506,7 +562,6 @@ bool RS_Spline::hasWrappedControlPoints() const {
                controlPoints.cbegin() + controlPoints.size() - data.degree);
 }
 
-//TODO: private interface cleanup; de Boor's Algorithm
 /**
  * Generates B-Spline open knot vector with multiplicity
  * equal to the order at the ends.
@@ -526,88 +581,119 @@ std::vector<double> RS_Spline::knot(size_t num, size_t order) const{
 
 
 
+namespace {
 /**
- * Generates rational B-spline basis functions for an open knot vector.
+ * Flattens a B-spline knot span by knot span. Points are evaluated with
+ * de Boor's algorithm on the degree + 1 control points of their span,
+ * which needs neither the other basis functions nor allocations.
  */
-namespace{
-std::vector<double> rbasis(int c, double t, int npts,
-                                      const std::vector<double>& x,
-                                      const std::vector<double>& h) {
-
-	int const nplusc = npts + c;
-
-	std::vector<double> temp(nplusc,0.);
-
-    // calculate the first order nonrational basis functions n[i]
-	for (int i = 0; i< nplusc-1; i++)
-		if ((t >= x[i]) && (t < x[i+1])) temp[i] = 1;
-
-    /* calculate the higher order nonrational basis functions */
+class SplineFlattener {
+public:
+    SplineFlattener(const std::vector<RS_Vector>& controlPoints,
+                    const std::vector<double>& knots, size_t degree,
+                    double tolerance, int maxSegments):
+        m_controlPoints(controlPoints)
+      , m_knots(knots)
+      , m_degree(degree)
+      , m_tolerance2(tolerance * tolerance)
+    {
+        // every subdivision level doubles the segments of a span
+        while ((1 << m_maxDepth) < maxSegments && m_maxDepth < 16)
+            ++m_maxDepth;
+    }
 
-	for (int k = 2; k <= c; k++) {
-		for (int i = 0; i < nplusc-k; i++) {
-			// if the lower order basis function is zero skip the calculation
-            if (temp[i] != 0)
-				temp[i] = ((t-x[i])*temp[i])/(x[i+k-1]-x[i]);
-            // if the lower order basis function is zero skip the calculation
-            if (temp[i+1] != 0)
-				temp[i] += ((x[i+k]-t)*temp[i+1])/(x[i+k]-x[i+1]);
+    void flatten(std::vector<RS_Vector>& points, const LC_Rect* area) const
+    {
+        for (size_t span = m_degree; span < m_controlPoints.size(); ++span) {
+            const double t0 = m_knots[span];
+            const double t1 = m_knots[span + 1];
+            if (!(t1 > t0))
+                continue;
+
+            const RS_Vector p0 = evaluate(span, t0);
+            const RS_Vector p1 = evaluate(span, t1);
+            if (points.empty() || (points.back() - p0).squared() > RS_TOLERANCE2)
+                points.push_back(p0);
+            if (isCurved(span, area))
+                subdivide(span, t0, p0, t1, p1, 0, points);
+            points.push_back(p1);
         }
     }
 
-    // pick up last point
-	if (t >= x[nplusc-1]) temp[npts-1] = 1;
-
-    // calculate sum for denominator of rational basis functions
-	double sum = 0.;
-	for (int i = 0; i < npts; i++) {
-		sum += temp[i]*h[i];
+private:
+    /** Evaluates the curve at t in [knots[span], knots[span + 1]]. */
+    RS_Vector evaluate(size_t span, double t) const
+    {
+        std::array<RS_Vector, 4> d;
+        for (size_t j = 0; j <= m_degree; ++j)
+            d[j] = m_controlPoints[span - m_degree + j];
+
+        for (size_t r = 1; r <= m_degree; ++r) {
+            for (size_t j = m_degree; j >= r; --j) {
+                const double left = m_knots[span - m_degree + j];
+                const double right = m_knots[span + 1 + j - r];
+                const double alpha = right > left ? (t - left) / (right - left) : 0.;
+                d[j] = d[j - 1] * (1. - alpha) + d[j] * alpha;
+            }
+        }
+        return d[m_degree];
     }
 
-	std::vector<double> r(npts, 0);
-    // form rational basis functions and put in r vector
-	if (sum != 0) {
-		for (int i = 0; i < npts; i++)
-			r[i] = (temp[i]*h[i])/sum;
-	}
-	return r;
-}
-}
-
-
-/**
- * Generates a rational B-spline curve using a uniform open knot vector.
- */
-void RS_Spline::rbspline(size_t npts, size_t k, size_t p1,
-                         const std::vector<RS_Vector>& b,
-                         const std::vector<double>& h,
-                         std::vector<RS_Vector>& p) const{
-	size_t const nplusc = npts + k;
-
-	// generate the open knot vector
-	auto const x = knot(npts, k);
-
-    // calculate the points on the rational B-spline curve
-    double t {x[0]};
-    double const step {(x[nplusc-1] - t) / (p1-1)};
-
-	for (auto& vp: p) {
-		if (x[nplusc-1] - t < 5e-6) t = x[nplusc-1];
-
-        // generate the basis function for this value of t
-		auto const nbasis = rbasis(k, t, npts, x, h);
+    /**
+     * @return false if the chord is good enough for the span: it's linear,
+     * too small or outside of the area, by the convex hull property.
+     */
+    bool isCurved(size_t span, const LC_Rect* area) const
+    {
+        if (m_degree < 2)
+            return false;
+        RS_Vector hullMin = m_controlPoints[span - m_degree];
+        RS_Vector hullMax = hullMin;
+        for (size_t j = span - m_degree + 1; j <= span; ++j) {
+            hullMin = RS_Vector::minimum(hullMin, m_controlPoints[j]);
+            hullMax = RS_Vector::maximum(hullMax, m_controlPoints[j]);
+        }
+        if ((hullMax - hullMin).squared() <= m_tolerance2)
+            return false;
+        return area == nullptr || area->intersects(LC_Rect{hullMin, hullMax});
+    }
 
-        // generate a point on the curve
-		for (size_t i = 0; i < npts; i++)
-			vp += b[i] * nbasis[i];
+    /** Adds the points between p0 and p1. */
+    void subdivide(size_t span, double t0, const RS_Vector& p0, double t1, const RS_Vector& p1,
+                   int depth, std::vector<RS_Vector>& points) const
+    {
+        if (depth >= m_maxDepth)
+            return;
+        const double tm = 0.5 * (t0 + t1);
+        const RS_Vector pm = evaluate(span, tm);
+        // always split once, the middle of an S shaped span can be on its chord
+        if (depth > 0 && chordDistance2(pm, p0, p1) <= m_tolerance2)
+            return;
+        subdivide(span, t0, p0, tm, pm, depth + 1, points);
+        points.push_back(pm);
+        subdivide(span, tm, pm, t1, p1, depth + 1, points);
+    }
 
-		t += step;
+    /** @return the squared distance of point to the line through p0 and p1 */
+    static double chordDistance2(const RS_Vector& point, const RS_Vector& p0, const RS_Vector& p1)
+    {
+        const RS_Vector chord = p1 - p0;
+        const RS_Vector v = point - p0;
+        const double length2 = chord.squared();
+        if (length2 < RS_TOLERANCE2)
+            return v.squared();
+        const double cross = v.x * chord.y - v.y * chord.x;
+        return cross * cross / length2;
     }
 
+    const std::vector<RS_Vector>& m_controlPoints;
+    const std::vector<double>& m_knots;
+    size_t m_degree = 3;
+    double m_tolerance2 = 0.;
+    int m_maxDepth = 0;
+};
 }
 
-
-
 std::vector<double> RS_Spline::knotu(size_t num, size_t order) const{
 	if (data.knotslist.size() == num + order) {
 		//use custom knot vector
@@ -620,31 +706,24 @@ std::vector<double> RS_Spline::knotu(size_t num, size_t order) const{
 
 
 
-void RS_Spline::rbsplinu(size_t npts, size_t k, size_t p1,
-                         const std::vector<RS_Vector>& b,
-                         const std::vector<double>& h,
-                         std::vector<RS_Vector>& p) const{
-	size_t const nplusc = npts + k;
-
-	/* generate the periodic knot vector */
-	std::vector<double> const x = knotu(npts, k);
-
-    /*    calculate the points on the rational B-spline curve */
-	double t = k-1;
-	double const step = double(npts - k + 1)/(p1 - 1);
-
-	for (auto& vp: p) {
-		if (x[nplusc-1] - t < 5e-6) t = x[nplusc-1];
-
-		/* generate the basis function for this value of t */
-		auto const nbasis = rbasis(k, t, npts, x, h);
-		/* generate a point on the curve, for x, y, z */
-		for (size_t i = 0; i < npts; i++)
-			vp += b[i] * nbasis[i];
-
-		t += step;
-    }
-
+std::vector<RS_Vector> RS_Spline::flatten(double tolerance, int maxSegments,
+                                          const LC_Rect* area) const
+{
+    std::vector<RS_Vector> points;
+    const size_t npts = data.controlPoints.size();
+    if (data.degree < 1 || data.degree > 3 || npts < size_t(data.degree) + 1)
+        return points;
+
+    const size_t order = data.degree + 1;
+    const std::vector<double> knots = data.closed ? knotu(npts, order) : knot(npts, order);
+    if (knots.size() != npts + order)
+        return points;
+
+    SplineFlattener flattener{data.controlPoints, knots, size_t(data.degree),
+                              std::max(tolerance, RS_TOLERANCE), std::max(1, maxSegments)};
+    points.reserve(npts * 2);
+    flattener.flatten(points, area);
+    return points;
 }
 
 
@@ -29,6 +29,7 @@
 #define RS_SPLINE_H
 
 #include <vector>
+#include "lc_rect.h"
 #include "rs_entitycontainer.h"
 
 /**
@@ -75,6 +76,21 @@ public:
 	bool isEdge() const override{
         return false;
     }
+    /**
+     * @return false, a spline has no child entities. Drawing, snapping
+     * and borders are served from its tessellation.
+     */
+	bool isContainer() const override{
+        return false;
+    }
+	/** @return true, if the spline has no tessellation */
+	bool isEmpty() const override{
+        return tessellation.size() < 2;
+	}
+	/** @return 1 */
+	unsigned countDeep() const override{
+        return 1;
+	}
 
 	/** @return Copy of data that defines the spline. */
 	const RS_SplineData& getData() const {
@@ -120,8 +136,16 @@ public:
 
 	RS_Vector getNearestEndpoint(const RS_Vector& coord,
 										 double* dist = nullptr)const override;
-	//RS_Vector getNearestPointOnEntity(const RS_Vector& coord,
-	//        bool onEntity=true, double* dist = nullptr, RS_Entity** entity=nullptr);
+	RS_Vector getNearestPointOnEntity(const RS_Vector& coord,
+									  bool onEntity = true,
+									  double* dist = nullptr,
+									  RS_Entity** entity = nullptr) const override;
+	double getDistanceToPoint(const RS_Vector& coord,
+							  RS_Entity** entity,
+							  RS2::ResolveLevel level = RS2::ResolveNone,
+							  double solidDist = RS_MAXDOUBLE) const override;
+	double getLength() const override;
+	double areaLineIntegral() const override;
 	RS_Vector getNearestCenter(const RS_Vector& coord,
 									   double* dist = nullptr)const override;
 	RS_Vector getNearestMiddle(const RS_Vector& coord,
@@ -147,6 +171,30 @@ public:
 		void draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset) override;
 		const std::vector<RS_Vector>& getControlPoints() const;
 
+        /**
+         * Flattens the curve to a polyline. Each knot span is subdivided
+         * until the polyline is within the tolerance of the curve.
+         *
+         * @param tolerance maximum distance between curve and polyline
+         * @param maxSegments maximum number of segments of one knot span
+         * @param area if given, spans outside of it are replaced by their chords
+         */
+        std::vector<RS_Vector> flatten(double tolerance, int maxSegments,
+                                       const LC_Rect* area = nullptr) const;
+        /**
+         * @return the polyline built by update(), the segments of the
+         * spline are lines between these points.
+         */
+        const std::vector<RS_Vector>& getTessellation() const {
+            return tessellation;
+        }
+        /**
+         * Creates a line for each segment of the tessellation, used to
+         * explode the spline.
+         */
+        void createEntities(RS_EntityContainer* parent,
+                            std::vector<RS_Entity*>& entities) const;
+
         friend std::ostream& operator << (std::ostream& os, const RS_Spline& l);
 
 		void calculateBorders() override;
@@ -155,16 +203,7 @@ public:
 
 private:
 		std::vector<double> knot(size_t num, size_t order) const;
-		void rbspline(size_t npts, size_t k, size_t p1,
-		              const std::vector<RS_Vector>& b,
-		              const std::vector<double>& h,
-		              std::vector<RS_Vector>& p) const;
-
 		std::vector<double> knotu(size_t num, size_t order) const;
-		void rbsplinu(size_t npts, size_t k, size_t p1,
-		              const std::vector<RS_Vector>& b,
-		              const std::vector<double>& h,
-		              std::vector<RS_Vector>& p) const;
 
         /**
          * @brief hasWrappedControlPoints whether the control points are wrapped, needed for a closed spline.
@@ -176,6 +215,8 @@ private:
 
 protected:
 		RS_SplineData data;
+		//! points of the polyline approximation, see getTessellation()
+		std::vector<RS_Vector> tessellation;
 }
 ;
 
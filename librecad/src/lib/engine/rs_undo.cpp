@@ -30,6 +30,7 @@
 #include "rs_undocycle.h"
 #include "rs_undo.h"
 #include "rs_debug.h"
+#include "lc_profiler.h"
 
 /**
  * @return Number of Cycles that can be undone.
@@ -187,6 +188,7 @@ void RS_Undo::endUndoCycle()
  */
 bool RS_Undo::undo() {
     RS_DEBUG->print("RS_Undo::undo");
+    LC_PROFILE_SCOPE("RS_Undo::undo");
 
 	if (undoPointer < 0) return false;
 
@@ -203,6 +205,7 @@ bool RS_Undo::undo() {
  */
 bool RS_Undo::redo() {
     RS_DEBUG->print("RS_Undo::redo");
+    LC_PROFILE_SCOPE("RS_Undo::redo");
 
 	if (undoPointer+1 < int(undoList.size())) {
 
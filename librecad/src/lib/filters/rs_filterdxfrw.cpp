@@ -30,6 +30,8 @@
 
 #include "rs_filterdxfrw.h"
 
+#include "lc_bulkgeometry.h"
+#include "lc_profiler.h"
 #include "lc_parabola.h"
 #include "rs_arc.h"
 #include "rs_circle.h"
@@ -51,6 +53,7 @@
 #include "rs_solid.h"
 #include "rs_spline.h"
 #include "lc_splinepoints.h"
+#include "rs_settings.h"
 #include "rs_system.h"
 #include "rs_text.h"
 #include "rs_graphicview.h"
@@ -147,6 +150,7 @@ QString RS_FilterDXFRW::lastError() const
  */
 bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unused]] RS2::FormatType type) {
     RS_DEBUG->print("RS_FilterDXFRW::fileImport");
+    LC_PROFILE_SCOPE("DXF import");
 
     RS_DEBUG->print("DXFRW Filter: importing file '%s'...", (const char*)QFile::encodeName(file));
 
@@ -154,6 +158,11 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
     currentContainer = graphic;
 	dummyContainer = new RS_EntityContainer(nullptr, true);
 
+    RS_SETTINGS->beginGroup("/Defaults");
+    compactPrimitives = RS_SETTINGS->readNumEntry("/CompactPrimitives", 0) != 0;
+    RS_SETTINGS->endGroup();
+    bulkGeometry = nullptr;
+
     this->file = file;
     // add some variables that need to be there for DXF drawings:
     graphic->addVariable("$DIMSTYLE", "Standard", 2);
@@ -170,7 +179,11 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
         RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading DWG file");
         if (RS_DEBUG->getLevel()== RS_Debug::D_DEBUGGING)
             dwgr.setDebug(DRW::DebugLevel::Debug);
-        bool success = dwgr.read(this, true);
+        bool success = false;
+        {
+            LC_PROFILE_SCOPE("DXF import: read DWG");
+            success = dwgr.read(this, true);
+        }
         RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading DWG file: OK");
         RS_DIALOGFACTORY->commandMessage(QObject::tr("Opened dwg file version %1.").arg(printDwgVersion(dwgr.getVersion())));
         int  lastError = dwgr.getError();
@@ -189,7 +202,11 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
         if (RS_Debug::D_DEBUGGING == RS_DEBUG->getLevel()) {
             dxfR.setDebug(DRW::DebugLevel::Debug);
         }
-        bool success = dxfR.read(this, true);
+        bool success = false;
+        {
+            LC_PROFILE_SCOPE("DXF import: read DXF");
+            success = dxfR.read(this, true);
+        }
         RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading file: OK");
         //graphic->setAutoUpdateBorders(true);
 
@@ -204,6 +221,7 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
 #endif
 
     delete dummyContainer;
+    finishBulkGeometry();
     /*set current layer */
     RS_Layer* cl = graphic->findLayer(graphic->getVariableString("$CLAYER", "0"));
 	if (cl ){
@@ -211,7 +229,11 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, [[maybe_unus
         graphic->getLayerList()->activate(cl, true);
     }
     RS_DEBUG->print("RS_FilterDXFRW::fileImport: updating inserts");
-    graphic->updateInserts();
+    {
+        LC_PROFILE_SCOPE("DXF import: update inserts");
+        graphic->updateInserts();
+    }
+    LC_PROFILE_COUNT("DXF import: entities", graphic->count());
 
     RS_DEBUG->print("RS_FilterDXFRW::fileImport OK");
 
@@ -390,11 +412,58 @@ void RS_FilterDXFRW::addPoint(const DRW_Point& data) {
                                     RS_PointData(v));
     setEntityAttributes(entity, &data);
 
+    if (addToBulkGeometry(entity))
+        return;
     currentContainer->addEntity(entity);
 }
 
 
 
+/**
+ * Stores plain lines and points of the model space in a compact bulk
+ * container, if enabled in the settings (/Defaults/CompactPrimitives).
+ * The container is added to the drawing at the position of its first
+ * element. Other entities in between start a new container, so the
+ * drawing order of the file is kept.
+ *
+ * @return true, if the entity data was taken over and the entity deleted
+ */
+bool RS_FilterDXFRW::addToBulkGeometry(RS_Entity* entity) {
+    if (!compactPrimitives || currentContainer != graphic
+            || !LC_BulkGeometry::isPlainEntity(entity))
+        return false;
+
+    if (bulkGeometry != nullptr && graphic->count() != bulkGeometryPosition)
+        finishBulkGeometry();
+    if (bulkGeometry == nullptr) {
+        bulkGeometry = new LC_BulkGeometry(graphic);
+        graphic->addEntity(bulkGeometry);
+    }
+    if (!bulkGeometry->addEntityData(entity))
+        return false;
+    bulkGeometryPosition = graphic->count();
+    delete entity;
+    return true;
+}
+
+
+
+/**
+ * Completes the current bulk container, no more elements are added to it.
+ */
+void RS_FilterDXFRW::finishBulkGeometry() {
+    if (bulkGeometry == nullptr)
+        return;
+    LC_PROFILE_SCOPE("DXF import: bulk geometry");
+    if (bulkGeometry->isEmpty())
+        graphic->removeEntity(bulkGeometry);
+    else
+        bulkGeometry->calculateBorders();
+    bulkGeometry = nullptr;
+}
+
+
+
 /**
  * Implementation of the method which handles line entities.
  */
@@ -416,6 +485,8 @@ void RS_FilterDXFRW::addLine(const DRW_Line& data) {
 
     RS_DEBUG->print("RS_FilterDXF::addLine: add entity");
 
+    if (addToBulkGeometry(entity))
+        return;
 	if (currentContainer) currentContainer->addEntity(entity);
 
     RS_DEBUG->print("RS_FilterDXF::addLine: OK");
@@ -1287,8 +1358,7 @@ void RS_FilterDXFRW::linkImage(const DRW_ImageDef *data) {
     }
 
     // Also link images in subcontainers (e.g. inserts):
-    for (RS_Entity* e=graphic->firstEntity(RS2::ResolveNone);
-            e; e=graphic->nextEntity(RS2::ResolveNone)) {
+    for (RS_Entity* e: *graphic) {
         if (e->rtti()==RS2::EntityImage) {
             RS_Image* img = (RS_Image*)e;
             if (img->getHandle()==handle) {
@@ -1302,8 +1372,7 @@ void RS_FilterDXFRW::linkImage(const DRW_ImageDef *data) {
     // update images in blocks:
     for (unsigned i=0; i<graphic->countBlocks(); ++i) {
         RS_Block* b = graphic->blockAt(i);
-        for (RS_Entity* e=b->firstEntity(RS2::ResolveNone);
-                e; e=b->nextEntity(RS2::ResolveNone)) {
+        for (RS_Entity* e: *b) {
             if (e->rtti()==RS2::EntityImage) {
                 RS_Image* img = (RS_Image*)e;
                 if (img->getHandle()==handle) {
@@ -1507,8 +1576,7 @@ void RS_FilterDXFRW::prepareBlocks() {
         }
     }
     //Add a name to each dimension, in dxfR12 also for hatches
-    for (RS_Entity *e = graphic->firstEntity(RS2::ResolveNone);
-		 e ; e = graphic->nextEntity(RS2::ResolveNone)) {
+    for (RS_Entity* e: *graphic) {
         if ( !(e->getFlag(RS2::FlagUndone)) ) {
             switch (e->rtti()) {
             case RS2::EntityDimLinear:
@@ -1575,8 +1643,7 @@ void RS_FilterDXFRW::writeBlocks() {
         block.flags = 1;//flag for unnamed block
         dxfW->writeBlock(&block);
         RS_EntityContainer *ct = (RS_EntityContainer *)it.key();
-        for (RS_Entity* e=ct->firstEntity(RS2::ResolveNone);
-             e; e=ct->nextEntity(RS2::ResolveNone)) {
+        for (RS_Entity* e: *ct) {
             if ( !(e->getFlag(RS2::FlagUndone)) ) {
                 writeEntity(e);
             }
@@ -1596,8 +1663,7 @@ void RS_FilterDXFRW::writeBlocks() {
             block.basePoint.y = blk->getBasePoint().y;
             block.basePoint.z = blk->getBasePoint().z;
             dxfW->writeBlock(&block);
-            for (RS_Entity* e=blk->firstEntity(RS2::ResolveNone);
-                 e; e=blk->nextEntity(RS2::ResolveNone)) {
+            for (RS_Entity* e: *blk) {
                 if ( !(e->getFlag(RS2::FlagUndone)) ) {
                     writeEntity(e);
                 }
@@ -1954,8 +2020,7 @@ void RS_FilterDXFRW::writeTextstyles(){
     QHash<QString, QString> styles;
     QString sty;
     //Find fonts used by text entities in drawing
-    for (RS_Entity *e = graphic->firstEntity(RS2::ResolveNone);
-		 e ; e = graphic->nextEntity(RS2::ResolveNone)) {
+    for (RS_Entity* e: *graphic) {
         if ( !(e->getFlag(RS2::FlagUndone)) ) {
             switch (e->rtti()) {
             case RS2::EntityMText:
@@ -1976,8 +2041,7 @@ void RS_FilterDXFRW::writeTextstyles(){
     RS_Block *blk;
     for (unsigned i = 0; i < graphic->countBlocks(); i++) {
         blk = graphic->blockAt(i);
-        for (RS_Entity *e = blk->firstEntity(RS2::ResolveNone);
-			 e ; e = blk->nextEntity(RS2::ResolveNone)) {
+        for (RS_Entity* e: *blk) {
             if ( !(e->getFlag(RS2::FlagUndone)) ) {
                 switch (e->rtti()) {
                 case RS2::EntityMText:
@@ -2089,8 +2153,7 @@ void RS_FilterDXFRW::writeAppId(){
 }
 
 void RS_FilterDXFRW::writeEntities(){
-    for (RS_Entity *e = graphic->firstEntity(RS2::ResolveNone);
-		 e ; e = graphic->nextEntity(RS2::ResolveNone)) {
+    for (RS_Entity* e: *graphic) {
         if ( !(e->getFlag(RS2::FlagUndone)) ) {
             writeEntity(e);
         }
@@ -2154,6 +2217,9 @@ void RS_FilterDXFRW::writeEntity(RS_Entity* e){
     case RS2::EntityImage:
         writeImage((RS_Image*)e);
         break;
+    case RS2::EntityBulkGeometry:
+        writeBulkGeometry((LC_BulkGeometry*)e);
+        break;
     default:
         break;
     }
@@ -2172,6 +2238,33 @@ void RS_FilterDXFRW::writePoint(RS_Point* p) {
 }
 
 
+/**
+ * Writes the lines and points of the given bulk container as
+ * single Line and Point entities to the file.
+ */
+void RS_FilterDXFRW::writeBulkGeometry(LC_BulkGeometry* b) {
+    for (size_t i = 0; i < b->lineCount(); ++i) {
+        DRW_Line line;
+        const LC_BulkGeometry::Element element{LC_BulkGeometry::Element::Line, i};
+        getEntityAttributes(&line, b->getElementLayer(element), b->getElementPen(element));
+        line.basePoint.x = b->startX()[i];
+        line.basePoint.y = b->startY()[i];
+        line.secPoint.x = b->endX()[i];
+        line.secPoint.y = b->endY()[i];
+        dxfW->writeLine(&line);
+    }
+    for (size_t i = 0; i < b->pointCount(); ++i) {
+        DRW_Point point;
+        const LC_BulkGeometry::Element element{LC_BulkGeometry::Element::Point, i};
+        getEntityAttributes(&point, b->getElementLayer(element), b->getElementPen(element));
+        const RS_Vector position = b->getPoint(i);
+        point.basePoint.x = position.x;
+        point.basePoint.y = position.y;
+        dxfW->writePoint(&point);
+    }
+}
+
+
 /**
  * Writes the given Line( entity to the file.
  */
@@ -2233,15 +2326,12 @@ void RS_FilterDXFRW::writeLWPolyline(RS_Polyline* l) {
     }
     DRW_LWPolyline pol;
     RS_Entity* currEntity = 0;
-    RS_Entity* nextEntity = 0;
 	RS_AtomicEntity* ae = nullptr;
     double bulge=0.0;
 
-    for (RS_Entity* e=l->firstEntity(RS2::ResolveNone);
-         e; e=nextEntity) {
+    for (RS_Entity* e: *l) {
 
         currEntity = e;
-        nextEntity = l->nextEntity(RS2::ResolveNone);
 
         if (!e->isAtomic()) {
             continue;
@@ -2277,15 +2367,12 @@ void RS_FilterDXFRW::writeLWPolyline(RS_Polyline* l) {
 void RS_FilterDXFRW::writePolyline(RS_Polyline* p) {
     DRW_Polyline pol;
     RS_Entity* currEntity = 0;
-    RS_Entity* nextEntity = 0;
 	RS_AtomicEntity* ae = nullptr;
     double bulge=0.0;
 
-    for (RS_Entity* e=p->firstEntity(RS2::ResolveNone);
-         e; e=nextEntity) {
+    for (RS_Entity* e: *p) {
 
         currEntity = e;
-        nextEntity = p->nextEntity(RS2::ResolveNone);
 
         if (!e->isAtomic()) {
             continue;
@@ -2331,17 +2418,14 @@ void RS_FilterDXFRW::writeSpline(RS_Spline *s) {
     // version 12 do not support Spline write as polyline
     if (version==1009) {
         DRW_Polyline pol;
-        RS_Entity* e;
-        for (e=s->firstEntity(RS2::ResolveNone);
-             e; e=s->nextEntity(RS2::ResolveNone)) {
-            pol.addVertex( DRW_Vertex(e->getStartpoint().x,
-                                      e->getStartpoint().y, 0.0, 0.0));
+        const std::vector<RS_Vector>& points = s->getTessellation();
+        // a closed polyline repeats its first vertex implicitly
+        const size_t count = s->isClosed() && !points.empty() ? points.size() - 1 : points.size();
+        for (size_t i = 0; i < count; ++i) {
+            pol.addVertex( DRW_Vertex(points[i].x, points[i].y, 0.0, 0.0));
         }
         if (s->isClosed()) {
             pol.flags = 1;
-        } else {
-            pol.addVertex( DRW_Vertex(s->getEndpoint().x,
-                                      s->getEndpoint().y, 0.0, 0.0));
         }
         getEntityAttributes(&pol, s);
         dxfW->writePolyline(&pol);
@@ -2762,8 +2846,7 @@ void RS_FilterDXFRW::writeLeader(RS_Leader* l) {
     leader.textwidth = 10;
     leader.vertnum = l->count();
 	RS_Line* li =nullptr;
-    for (RS_Entity* v=l->firstEntity(RS2::ResolveNone);
-            v;   v=l->nextEntity(RS2::ResolveNone)) {
+    for (RS_Entity* v: *l) {
         if (v->rtti()==RS2::EntityLine) {
             li = (RS_Line*)v;
 			leader.vertexlist.push_back(std::make_shared<DRW_Coord>(li->getStartpoint().x, li->getStartpoint().y, 0.0));
@@ -2801,9 +2884,7 @@ void RS_FilterDXFRW::writeHatch(RS_Hatch * h) {
     bool writeIt = true;
     if (h->countLoops()>0) {
         // check if all of the loops contain entities:
-        for (RS_Entity* l=h->firstEntity(RS2::ResolveNone);
-                l;
-                l=h->nextEntity(RS2::ResolveNone)) {
+        for (RS_Entity* l: *h) {
 
             if (l->isContainer() && !l->getFlag(RS2::FlagTemp)) {
                 if (l->count()==0) {
@@ -2832,18 +2913,14 @@ void RS_FilterDXFRW::writeHatch(RS_Hatch * h) {
         ha.name = h->getPattern().toUtf8().data();
     ha.loopsnum = h->countLoops();
 
-    for (RS_Entity* l=h->firstEntity(RS2::ResolveNone);
-         l;
-         l=h->nextEntity(RS2::ResolveNone)) {
+    for (RS_Entity* l: *h) {
 
         // Write hatch loops:
         if (l->isContainer() && !l->getFlag(RS2::FlagTemp)) {
             RS_EntityContainer* loop = (RS_EntityContainer*)l;
 			std::shared_ptr<DRW_HatchLoop> lData = std::make_shared<DRW_HatchLoop>(0);
 
-            for (RS_Entity* ed=loop->firstEntity(RS2::ResolveNone);
-                 ed;
-                 ed=loop->nextEntity(RS2::ResolveNone)) {
+            for (RS_Entity* ed: *loop) {
 
                 // Write hatch loop edges:
                 if (ed->rtti()==RS2::EntityLine) {
@@ -3001,8 +3078,7 @@ void RS_FilterDXFRW::writeImage(RS_Image * i) {
 
     RS_Block* blk = new RS_Block(graphic, blkdata);
 
-	for (RS_Entity* e1 = con->firstEntity(); e1 ;
-            e1 = con->nextEntity() ) {
+	for (RS_Entity* e1: *con) {
         blk->addEntity(e1);
     }
     writeBlock(dw, blk);
@@ -3073,9 +3149,16 @@ void RS_FilterDXFRW::setEntityAttributes(RS_Entity* entity,
  */
 void RS_FilterDXFRW::getEntityAttributes(DRW_Entity* ent, const RS_Entity* entity) {
 //DRW_Entity RS_FilterDXFRW::getEntityAttributes(RS_Entity* /*entity*/) {
+    getEntityAttributes(ent, entity->getLayer(), entity->getPen(false));
+}
 
+
+
+/**
+ * Gets the attributes for the given layer and pen.
+ */
+void RS_FilterDXFRW::getEntityAttributes(DRW_Entity* ent, const RS_Layer* layer, const RS_Pen& pen) {
     // Layer:
-    RS_Layer* layer = entity->getLayer();
     QString layerName;
     if (layer) {
         layerName = layer->getName();
@@ -3083,8 +3166,6 @@ void RS_FilterDXFRW::getEntityAttributes(DRW_Entity* ent, const RS_Entity* entit
         layerName = "0";
     }
 
-    RS_Pen pen = entity->getPen(false);
-
     // Color:
     int exact_rgb;
     int color = colorToNumber(pen.getColor(), &exact_rgb);
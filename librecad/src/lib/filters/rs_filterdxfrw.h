@@ -43,6 +43,7 @@ class RS_Solid;
 class RS_Polyline;
 class RS_Spline;
 class LC_SplinePoints;
+class LC_BulkGeometry;
 class RS_Insert;
 class RS_MText;
 class RS_Text;
@@ -160,6 +161,7 @@ public:
     void writeLeader(RS_Leader* l);
     void writeDimension(RS_Dimension* d);
     void writePolyline(RS_Polyline* p);
+    void writeBulkGeometry(LC_BulkGeometry* b);
 
 /*	void writeEntityContainer(DL_WriterA& dw, RS_EntityContainer* con,
                 const DRW_Entity& attrib);
@@ -169,6 +171,7 @@ public:
 
     void setEntityAttributes(RS_Entity* entity, const DRW_Entity* attrib);
     void getEntityAttributes(DRW_Entity* ent, const RS_Entity* entity);
+    void getEntityAttributes(DRW_Entity* ent, const RS_Layer* layer, const RS_Pen& pen);
 
     static QString toDxfString(const QString& str);
     static QString toNativeString(const QString& data);
@@ -199,6 +202,8 @@ public:
 private:
     void prepareBlocks();
     void writeEntity(RS_Entity* e);
+    bool addToBulkGeometry(RS_Entity* entity);
+    void finishBulkGeometry();
 #ifdef DWGSUPPORT
     void printDwgError(int le);
     QString printDwgVersion(int v);
@@ -235,6 +240,11 @@ private:
     QHash<int, RS_EntityContainer*> blockHash;
     /** Pointer to entity container to store possible orphan entities like paper space */
     RS_EntityContainer* dummyContainer;
+    /** Container for plain lines and points, if compact storage is enabled */
+    LC_BulkGeometry* bulkGeometry {nullptr};
+    /** Number of model space entities when bulkGeometry got its last element */
+    unsigned bulkGeometryPosition {0};
+    bool compactPrimitives {false};
 };
 
 #endif
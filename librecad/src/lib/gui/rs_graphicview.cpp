@@ -44,6 +44,7 @@
 #include "rs_linetypepattern.h"
 #include "rs_math.h"
 #include "rs_painter.h"
+#include "rs_pen.h"
 #include "rs_snapper.h"
 #include "rs_settings.h"
 #include "rs_units.h"
@@ -996,14 +997,37 @@ void RS_GraphicView::drawLayer3(RS_Painter *painter) {
 
 void RS_GraphicView::setPenForEntity(RS_Painter *painter,RS_Entity *e, double& patternOffset)
 {
+	if (transformedPen != nullptr) {
+		// transformed previews are drawn with the pen of the preview
+		painter->setPen(*transformedPen);
+		return;
+	}
+
+	// Getting pen from entity (or layer), cached by the entity
+	setPenForEntity(painter, e, e->getResolvedPen(), patternOffset);
+}
+
+
+
+/**
+ * Sets the painter pen for drawing a part of the entity e which resolves
+ * its own pen, e.g. a single element of LC_BulkGeometry. Selection,
+ * highlighting and the view settings are applied as for the entity.
+ *
+ * @param pen the resolved pen of the part
+ */
+void RS_GraphicView::setPenForEntity(RS_Painter *painter, const RS_Entity* e, RS_Pen pen, double& patternOffset)
+{
+	if (transformedPen != nullptr) {
+		painter->setPen(*transformedPen);
+		return;
+	}
+
 	if (draftMode) {
         painter->setPen(RS_Pen(m_colorData->foreground,
 							   RS2::Width00, RS2::SolidLine));
 	}
 
-	// Getting pen from entity (or layer)
-	RS_Pen pen = e->getPen(true);
-
     // Avoid negative widths
     int w = std::max(static_cast<int>(pen.getWidth()), 0);
 
@@ -1144,14 +1168,17 @@ void RS_GraphicView::drawEntity(RS_Painter *painter, RS_Entity* e, double& patte
         return;
 	}
 
-    // test if the entity is in the viewport
-    if (!isPrinting() &&
+    // test if the entity is in the viewport. Construction lines are
+    // infinite and clipped to the viewport when drawn.
+    if (!isPrinting() && transformedPen == nullptr &&
         e->rtti() != RS2::EntityGraphic &&
-        e->rtti() != RS2::EntityLine &&
+        !(e->rtti() == RS2::EntityLine && e->isConstruction()) &&
        (toGuiX(e->getMax().x)<0 || toGuiX(e->getMin().x)>getWidth() ||
         toGuiY(e->getMin().y)<0 || toGuiY(e->getMax().y)>getHeight())) {
+        ++culledEntities;
         return;
     }
+    ++drawnEntities;
 
 	// set pen (color):
     setPenForEntity(painter, e, patternOffset);
@@ -1178,7 +1205,7 @@ void RS_GraphicView::drawEntity(RS_Painter *painter, RS_Entity* e, double& patte
 	}
 
 	// draw reference points:
-	if (e->isSelected() && !(isPrinting() || isPrintPreview())) {
+	if (e->isSelected() && transformedPen == nullptr && !(isPrinting() || isPrintPreview())) {
 		if (!e->isParentSelected()) {
 			RS_VectorSolutions const& s = e->getRefPoints();
 
@@ -1216,7 +1243,8 @@ void RS_GraphicView::drawEntityPlain(RS_Painter *painter, RS_Entity* e, double&
 		return;
 	}
 
-	if (!e->isContainer() && (e->isSelected()!=painter->shouldDrawSelected())) {
+	if (!e->isContainer() && transformedPen == nullptr
+			&& (e->isSelected()!=painter->shouldDrawSelected())) {
 		return;
 	}
 
@@ -1228,7 +1256,8 @@ void RS_GraphicView::drawEntityPlain(RS_Painter *painter, RS_Entity* e) {
 		return;
 	}
 
-	if (!e->isContainer() && (e->isSelected()!=painter->shouldDrawSelected())) {
+	if (!e->isContainer() && transformedPen == nullptr
+			&& (e->isSelected()!=painter->shouldDrawSelected())) {
 		return;
 	}
 	double patternOffset(0.);
@@ -1441,11 +1470,8 @@ void RS_GraphicView::drawGrid(RS_Painter *painter) {
 	//painter->setPen(Qt::gray);
     painter->setPen(m_colorData->gridColor);
 
-	//grid->updatePointArray();
-	auto const& pts = grid->getPoints();
-	for(auto const& v: pts){
-		painter->drawGridPoint(toGui(v));
-	}
+	// the grid is updated by drawMetaGrid(), only if the view changed
+	painter->drawGridPoints(grid->getScreenPoints());
 
 	// draw grid info:
 	//painter->setPen(Qt::white);
@@ -1484,7 +1510,7 @@ void RS_GraphicView::drawMetaGrid(RS_Painter *painter) {
     double dx=std::abs(dv.x);
     double dy=std::abs(dv.y); //potential bug, need to recover metaGrid.width
 	// draw meta grid:
-	auto mx = grid->getMetaX();
+	auto const& mx = grid->getMetaX();
 	for(auto const& x: mx){
 		painter->drawLine(RS_Vector(toGuiX(x), 0),
 						  RS_Vector(toGuiX(x), getHeight()));
@@ -1493,7 +1519,7 @@ void RS_GraphicView::drawMetaGrid(RS_Painter *painter) {
 							  RS_Vector(toGuiX(x)+0.5*dx, getHeight()));
 		}
 	}
-	auto my = grid->getMetaY();
+	auto const& my = grid->getMetaY();
 	if(grid->isIsometric()){//isometric metaGrid
         dx=std::abs(dx);
         dy=std::abs(dy);
@@ -1563,6 +1589,75 @@ void RS_GraphicView::drawOverlay(RS_Painter *painter)
     }
 }
 
+/**
+ * Draws entities of the document through the given transformation, in
+ * graph coordinates, without modifying or copying them. Used by previews
+ * of move, rotate, scale and mirror actions. All entities are drawn
+ * with the given pen, regardless of their selection state.
+ */
+void RS_GraphicView::drawTransformed(RS_Painter *painter, const std::vector<RS_Entity*>& entities,
+                                     const LC_AffineTransform& transform, const RS_Pen& pen,
+                                     double& patternOffset)
+{
+    if (painter == nullptr || entities.empty())
+        return;
+
+    // conjugate the graph transformation into screen space by mapping
+    // three screen points: origin and the unit directions
+    const double unit = 1000.;
+    const RS_Vector o = toGui(transform.map(toGraph(RS_Vector{0., 0.})));
+    const RS_Vector ex = toGui(transform.map(toGraph(RS_Vector{unit, 0.}))) - o;
+    const RS_Vector ey = toGui(transform.map(toGraph(RS_Vector{0., unit}))) - o;
+    const LC_AffineTransform screenTransform{ex.x/unit, ex.y/unit, ey.x/unit, ey.y/unit, o.x, o.y};
+    if (!transform.invert(transformInverse))
+        return;
+
+    transformedPen = &pen;
+    painter->pushTransform(screenTransform);
+    for (RS_Entity* e: entities) {
+        if (e == nullptr || e->isUndone())
+            continue;
+        painter->setPen(pen);
+        e->draw(painter, this, patternOffset);
+    }
+    painter->popTransform();
+    transformedPen = nullptr;
+    transformInverse = {};
+}
+
+/**
+ * @return the visible part of the drawing in graph coordinates.
+ * During a partial redraw, this is the redrawn area only.
+ * While drawing transformed entities, this is the area which is mapped
+ * into the viewport by the transformation.
+ */
+LC_Rect RS_GraphicView::getVisibleArea() const
+{
+    const RS_Vector vpMin = partialRedraw ? partialRedrawArea.minP() : toGraph(0, getHeight());
+    const RS_Vector vpMax = partialRedraw ? partialRedrawArea.maxP() : toGraph(getWidth(), 0);
+    if (transformedPen == nullptr)
+        return {vpMin, vpMax};
+
+    const RS_Vector corners[4] = {
+        transformInverse.map(vpMin),
+        transformInverse.map({vpMax.x, vpMin.y}),
+        transformInverse.map(vpMax),
+        transformInverse.map({vpMin.x, vpMax.y})
+    };
+    RS_Vector minV = corners[0];
+    RS_Vector maxV = corners[0];
+    for (const RS_Vector& corner: corners) {
+        minV = RS_Vector::minimum(minV, corner);
+        maxV = RS_Vector::maximum(maxV, corner);
+    }
+    return {minV, maxV};
+}
+
+void RS_GraphicView::redrawArea(const RS_Vector& /*v1*/, const RS_Vector& /*v2*/)
+{
+    redraw(RS2::RedrawDrawing);
+}
+
 RS2::SnapRestriction RS_GraphicView::getSnapRestriction() const
 {
 	return defaultSnapRes;
@@ -35,6 +35,7 @@
 #include <QMap>
 #include <QWidget>
 
+#include "lc_affinetransform.h"
 #include "lc_rect.h"
 #include "rs.h"
 
@@ -51,6 +52,7 @@ class RS_CommandEvent;
 class RS_Graphic;
 class RS_Grid;
 class RS_Painter;
+class RS_Pen;
 
 struct RS_LineTypePattern;
 struct RS_SnapMode;
@@ -119,6 +121,9 @@ public:
 	/** This virtual method must be overwritten to redraw
 	  the widget. */
 	virtual void redraw(RS2::RedrawMethod method=RS2::RedrawAll) = 0;
+	/** Redraws the drawing within the given area, by default the
+	  whole drawing is redrawn. */
+	virtual void redrawArea(const RS_Vector& v1, const RS_Vector& v2);
 	/** This virtual method must be overwritten and is then
 	  called whenever the view changed */
     virtual void adjustOffsetControls() = 0;
@@ -269,7 +274,11 @@ public:
 	virtual void drawEntityPlain(RS_Painter *painter, RS_Entity* e);
 	virtual void drawEntityPlain(RS_Painter *painter, RS_Entity* e, double& patternOffset);
     virtual void setPenForEntity(RS_Painter *painter, RS_Entity* e, double& patternOffset);
+    void setPenForEntity(RS_Painter *painter, const RS_Entity* e, RS_Pen pen, double& patternOffset);
     virtual void drawEntityHighlighted(RS_Entity* e, bool highlighted = true);
+    virtual void drawTransformed(RS_Painter *painter, const std::vector<RS_Entity*>& entities,
+                                 const LC_AffineTransform& transform, const RS_Pen& pen,
+                                 double& patternOffset);
     virtual RS_Vector getMousePosition() const = 0;
 
 	virtual const RS_LineTypePattern* getPattern(RS2::LineType t);
@@ -373,6 +382,8 @@ public:
         return view_rect;
     }
 
+    LC_Rect getVisibleArea() const;
+
     bool isPanning() const;
     void setPanning(bool state);
 
@@ -388,6 +399,20 @@ public:
 
     void setTypeToSelect(RS2::EntityType mType);
 
+    /** Resets the counts of drawn and culled entities, for profiling. */
+    void resetDrawStatistics() {
+        drawnEntities = 0;
+        culledEntities = 0;
+    }
+    //! number of entities drawn since resetDrawStatistics()
+    int getDrawnEntities() const {
+        return drawnEntities;
+    }
+    //! number of entities skipped outside of the viewport since resetDrawStatistics()
+    int getCulledEntities() const {
+        return culledEntities;
+    }
+
 protected:
 
     RS_EntityContainer* container = nullptr; // Holds a pointer to all the enties
@@ -419,6 +444,10 @@ protected:
 
     LC_Rect view_rect;
 
+    //! while set, only this area is redrawn, see getVisibleArea()
+    bool partialRedraw = false;
+    LC_Rect partialRedrawArea;
+
 private:
 
 	bool zoomFrozen=false;
@@ -455,8 +484,16 @@ private:
 
     bool scaleLineWidth = false;
 
+    int drawnEntities = 0;
+    int culledEntities = 0;
+
     RS2::EntityType typeToSelect = RS2::EntityType::EntityUnknown;
 
+    //! pen used for all entities while drawTransformed() is active
+    const RS_Pen* transformedPen = nullptr;
+    //! inverse of the drawing transform while drawTransformed() is active
+    LC_AffineTransform transformInverse;
+
 signals:
     void relative_zero_changed(const RS_Vector&);
     void previous_zoom_state(bool);
@@ -24,6 +24,7 @@
 **
 **********************************************************************/
 #include<cmath>
+#include<tuple>
 #include<QString>
 #include "rs_grid.h"
 #include "rs_graphicview.h"
@@ -50,7 +51,36 @@ const double minimumGridWidth=1.0e-8;
 RS_Grid::RS_Grid(RS_GraphicView* graphicView)
     :graphicView(graphicView)
     ,baseGrid(false)
-{}
+{
+	loadSettings();
+}
+
+bool RS_Grid::State::operator == (State const& other) const
+{
+	return std::tie(factor.x, factor.y, offsetX, offsetY, width, height,
+					userGrid.x, userGrid.y, isometric, unit, format)
+			== std::tie(other.factor.x, other.factor.y, other.offsetX, other.offsetY,
+						other.width, other.height, other.userGrid.x, other.userGrid.y,
+						other.isometric, other.unit, other.format);
+}
+
+void RS_Grid::loadSettings()
+{
+	RS_SETTINGS->beginGroup("/Appearance");
+	settings.scaleGrid = (bool)RS_SETTINGS->readNumEntry("/ScaleGrid", 1);
+	settings.isometric = (bool)RS_SETTINGS->readNumEntry("/IsometricGrid", 0);
+	settings.crosshairType=static_cast<RS2::CrosshairType>(RS_SETTINGS->readNumEntry("/CrosshairType",0));
+	settings.userGrid.x = RS_SETTINGS->readEntry("/GridSpacingX",QString("-1")).toDouble();
+	settings.userGrid.y = RS_SETTINGS->readEntry("/GridSpacingY",QString("-1")).toDouble();
+	settings.minGridSpacing = RS_SETTINGS->readNumEntry("/MinGridSpacing", 10);
+	RS_SETTINGS->endGroup();
+	invalidate();
+}
+
+void RS_Grid::invalidate()
+{
+	valid = false;
+}
 
 /**
  * find the closest grid point
@@ -80,41 +110,49 @@ void RS_Grid::updatePointArray() {
 
 	RS_Graphic* graphic = graphicView->getGraphic();
 
-	// auto scale grid?
-	RS_SETTINGS->beginGroup("/Appearance");
-	bool scaleGrid = (bool)RS_SETTINGS->readNumEntry("/ScaleGrid", 1);
 	// get grid setting
-	RS_Vector userGrid;
+	State current;
 	if (graphic) {
 		//$ISOMETRICGRID == $SNAPSTYLE
-		isometric = static_cast<bool>(graphic->getVariableInt("$SNAPSTYLE",0));
+		current.isometric = static_cast<bool>(graphic->getVariableInt("$SNAPSTYLE",0));
 		crosshairType=graphic->getCrosshairType();
-		userGrid = graphic->getVariableVector("$GRIDUNIT",
+		current.userGrid = graphic->getVariableVector("$GRIDUNIT",
 											 RS_Vector(-1.0, -1.0));
+		current.unit = graphic->getUnit();
+		current.format = graphic->getLinearFormat();
 	}else {
-		isometric = (bool)RS_SETTINGS->readNumEntry("/IsometricGrid", 0);
-		crosshairType=static_cast<RS2::CrosshairType>(RS_SETTINGS->readNumEntry("/CrosshairType",0));
-		userGrid.x = RS_SETTINGS->readEntry("/GridSpacingX",QString("-1")).toDouble();
-		userGrid.y = RS_SETTINGS->readEntry("/GridSpacingY",QString("-1")).toDouble();
+		current.isometric = settings.isometric;
+		crosshairType = settings.crosshairType;
+		current.userGrid = settings.userGrid;
 	}
-	int minGridSpacing = RS_SETTINGS->readNumEntry("/MinGridSpacing", 10);
-	RS_SETTINGS->endGroup();
+	current.factor = graphicView->getFactor();
+	current.offsetX = graphicView->getOffsetX();
+	current.offsetY = graphicView->getOffsetY();
+	current.width = graphicView->getWidth();
+	current.height = graphicView->getHeight();
+
+	// the grid only depends on the view and the grid settings
+	if (valid && current == state) return;
+	state = current;
+	valid = true;
+
+	isometric = state.isometric;
+	RS_Vector const& userGrid = state.userGrid;
+	bool const scaleGrid = settings.scaleGrid;
+	int const minGridSpacing = settings.minGridSpacing;
 
 	// std::cout<<"Grid userGrid="<<userGrid<<std::endl;
 
 	pt.clear();
+	screenPt.clear();
 	metaX.clear();
 	metaY.clear();
 
 	// RS_DEBUG->print("RS_Grid::update: 001");
 
 	// find out unit:
-	RS2::Unit unit = RS2::None;
-	RS2::LinearFormat format = RS2::Decimal;
-	if (graphic) {
-		unit = graphic->getUnit();
-		format = graphic->getLinearFormat();
-	}
+	RS2::Unit unit = state.unit;
+	RS2::LinearFormat format = state.format;
 
 	RS_Vector gridWidth;
 	// RS_Vector metaGridWidth;
@@ -173,6 +211,7 @@ void RS_Grid::updatePointArray() {
 			createOrthogonalGrid(rect, gridWidth);
 
 		}
+		createScreenPoints();
 
 		// RS_DEBUG->print("RS_Grid::update: 015");
 	}
@@ -491,6 +530,16 @@ void RS_Grid::createIsometricGrid(LC_Rect const& rect, RS_Vector const& gridWidt
 	}
 }
 
+void RS_Grid::createScreenPoints()
+{
+	screenPt.resize(static_cast<int>(pt.size()));
+	for (size_t i = 0; i < pt.size(); ++i) {
+		RS_Vector const guiPoint = graphicView->toGui(pt[i]);
+		screenPt[static_cast<int>(i)] = QPoint(RS_Math::round(guiPoint.x),
+											   RS_Math::round(guiPoint.y));
+	}
+}
+
 QString RS_Grid::getInfo() const{
 	return QString("%1 / %2").arg(spacing).arg(metaSpacing);
 }
@@ -499,6 +548,10 @@ std::vector<RS_Vector> const& RS_Grid::getPoints() const{
 	return pt;
 }
 
+QPolygon const& RS_Grid::getScreenPoints() const{
+	return screenPt;
+}
+
 std::vector<double> const& RS_Grid::getMetaX() const{
 	return metaX;
 }
@@ -513,6 +566,7 @@ bool RS_Grid::isIsometric() const{
 
 void RS_Grid::setIsometric(bool b){
 	isometric=b;
+	invalidate();
 }
 
 RS_Vector RS_Grid::getMetaGridWidth() const {
@@ -28,6 +28,8 @@
 #ifndef RS_GRID_H
 #define RS_GRID_H
 
+#include <QPolygon>
+
 #include "rs.h"
 #include "rs_vector.h"
 
@@ -53,12 +55,30 @@ class RS_Grid
 public:
 	RS_Grid(RS_GraphicView* graphicView);
 
+	/**
+	 * Updates the grid points, only if the view, the grid settings of the
+	 * drawing or the application settings changed since the last update.
+	 */
 	void updatePointArray();
+	/**
+	 * Re-reads the grid related application settings and forces the grid
+	 * to be rebuilt on the next update.
+	 */
+	void loadSettings();
+	/**
+	 * Forces the grid to be rebuilt on the next update.
+	 */
+	void invalidate();
 
 	/**
 		 * @return Array of all visible grid points.
 		 */
 	std::vector<RS_Vector> const& getPoints() const;
+	/**
+	 * @return the visible grid points in screen coordinates, to be drawn
+	 * at once.
+	 */
+	QPolygon const& getScreenPoints() const;
 
 	/**
 	* \brief the closest grid point
@@ -107,6 +127,33 @@ private:
 	RS_Vector getMetricGridWidth(RS_Vector const& userGrid, bool scaleGrid, int minGridSpacing);
 	RS_Vector getImperialGridWidth(RS_Vector const& userGrid, bool scaleGrid, int minGridSpacing);
 	//! \}
+	void createScreenPoints();
+
+	//! grid related application settings
+	struct Settings {
+		bool scaleGrid = true;
+		int minGridSpacing = 10;
+		//! \{ used without a drawing only
+		bool isometric = false;
+		RS2::CrosshairType crosshairType = RS2::LeftCrosshair;
+		RS_Vector userGrid{-1., -1.};
+		//! \}
+	};
+
+	//! view and drawing state the grid points were created for
+	struct State {
+		RS_Vector factor;
+		int offsetX = 0;
+		int offsetY = 0;
+		int width = 0;
+		int height = 0;
+		RS_Vector userGrid;
+		bool isometric = false;
+		RS2::Unit unit = RS2::None;
+		RS2::LinearFormat format = RS2::Decimal;
+
+		bool operator == (State const& other) const;
+	};
 
     //! Graphic view this grid is connected to.
     RS_GraphicView *graphicView = nullptr;
@@ -116,8 +163,15 @@ private:
     //! Current meta grid spacing
     double metaSpacing = 0.;
 
+    Settings settings;
+    State state;
+    //! false if the grid points need to be rebuilt
+    bool valid = false;
+
     //! Pointer to array of grid points
     std::vector<RS_Vector> pt;
+    //! grid points in screen coordinates
+    QPolygon screenPt;
     RS_Vector baseGrid; // the left-bottom grid point
     RS_Vector cellV;    // (dx,dy)
     RS_Vector metaGridWidth;
@@ -31,6 +31,7 @@
 #include "rs.h"
 #include "rs_vector.h"
 
+class LC_AffineTransform;
 class RS_Color;
 class RS_GraphicView;
 class RS_Pen;
@@ -92,6 +93,11 @@ public:
     virtual void lineTo(int x, int y) = 0;
 
     virtual void drawGridPoint(const RS_Vector& p) = 0;
+    /**
+     * Draws all given grid points with a single call.
+     * The points are in screen coordinates.
+     */
+    virtual void drawGridPoints(const QPolygon& points) = 0;
     virtual void drawPoint(const RS_Vector& p, int pdmode, int pdsize) = 0;
     virtual void drawLine(const RS_Vector& p1, const RS_Vector& p2) = 0;
     virtual void drawRect(const RS_Vector& p1, const RS_Vector& p2);
@@ -160,6 +166,17 @@ public:
 
     virtual void setClipRect(int x, int y, int w, int h) = 0;
     virtual void resetClipping() = 0;
+
+    /**
+     * Saves the painter state and applies the given screen space
+     * transformation on top of the current one. Everything drawn
+     * until the matching popTransform() is transformed.
+     */
+    virtual void pushTransform(const LC_AffineTransform& transform) = 0;
+    /**
+     * Restores the state saved by the last pushTransform().
+     */
+    virtual void popTransform() = 0;
 	int toScreenX(double x) const;
 	int toScreenY(double y) const;
 
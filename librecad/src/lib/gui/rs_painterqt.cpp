@@ -24,11 +24,13 @@
 **
 **********************************************************************/
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <memory>
 
 #include "dxf_format.h"
+#include "lc_affinetransform.h"
 #include "lc_splinepoints.h"
 #include "rs_arc.h"
 #include "rs_debug.h"
@@ -100,46 +102,23 @@ Qt::PenStyle rsToQtLineType(RS2::LineType t) {
     }
 }
 
-// For a given elliptic arc, create a QPainterPath to allow clipping the complete QR
-// to the desirable
-QPainterPath getEllipticArcClipping(const RS_Vector& origin,
-                                double radius1, double radius2,
-                                double angle, double angle1, double angle2)
+/**
+ * Number of line segments approximating an arc of the given screen radius
+ * within a quarter pixel.
+ */
+int arcSegments(double radius, double angleLength)
 {
+    constexpr double tolerance = 0.25;
+    constexpr int maxSegments = 4096;
+    if (radius <= tolerance)
+        return 1;
+    const double step = 2. * std::acos(1. - tolerance / radius);
+    return std::clamp(int(std::ceil(std::abs(angleLength) / step)), 1, maxSegments);
+}
 
-    // Elliptic arc: QPainter doesn't support drawing an elliptic arc natively.
-    // Create a QPainterPath to clip the complete ellipse to draw an arc.
-    // Get a point on ellipse by the elliptic angle
-    auto getP = [&origin, &radius1, &radius2, &angle](double a) {
-        auto point = origin + RS_Vector{a}.scale({radius1, -radius2});
-        point.rotate(origin, -angle);
-        return point;
-    };
-    RS_Vector p1 = getP(angle1);
-    RS_Vector p2 = getP(angle2);
-    // Find a direction vector along the two end points of the arc
-    auto dp = p2 - p1;
-    dp /= dp.magnitude();
-    // Find a point on the arc
-    RS_Vector p3 = getP((angle1+angle2)*0.5) - p1;
-    // Find a direction normal to the line p1-p2
-    p3 -= dp * p3.dotP(dp);
-    // the QPainterPath should
-    double ellipseSize = 2.0 * std::max(radius1, radius2);
-    p3 *= ellipseSize/p3.magnitude();
-
-    // makes the path larger
-    dp *= ellipseSize;
-    p1 -= dp;
-    p2 += dp;
-
-    QPainterPath path;
-    path.moveTo(p1.x, p1.y);
-    path.lineTo(p1.x+p3.x, p1.y+p3.y);
-    path.lineTo(p2.x+p3.x, p2.y+p3.y);
-    path.lineTo(p2.x, p2.y);
-    path.lineTo(p1.x, p1.y);
-    return path;
+QPointF toQPointF(const RS_Vector& v)
+{
+    return {v.x, v.y};
 }
 
 // RAII style saving and restore QPainter states
@@ -194,79 +173,24 @@ private:
     QPainter& m_painter;
 };
 
-void drawArc(QPainterPath& path, const RS_Arc& arc, const LC_Rect& viewRect, const std::function<QPointF(const RS_Vector&)>& mapping)
+/**
+ * Appends the screen points of an arc segment of a polyline, without its start point.
+ * Arcs outside of the visible area are replaced by their chord, which is invisible too.
+ */
+void appendArc(std::vector<QPointF>& points, const RS_Arc& arc, const RS_GraphicView& view,
+               const LC_Rect& visibleArea)
 {
-    auto mapingRs=[&mapping](const RS_Vector& vp) -> RS_Vector {
-        QPointF point = mapping(vp);
-        return {point.x(), point.y()};
-    };
-    LC_Rect arcRect{mapingRs(arc.getMin()), mapingRs(arc.getMax())};
-    if (arcRect.inArea(viewRect) && arc.isReversed()) {
-        // QPainterPath::arcTo() can only draw along the increasing angle direction.
-        // Approximate a reversed arc by line segments. Maximum step about 5 degrees
-        double a0 = arc.getAngle1();
-        double a1 = arc.isReversed() ? a0 - arc.getAngleLength() : a0 + arc.getAngleLength();
-        int steps = int(arc.getAngleLength()/(M_PI/36.)) + 2;
-        double dA = (a1-a0)/steps;
-        for (int i=0; i<= steps; ++i) {
-            double a = a0 + dA * i;
-            path.lineTo(mapping(arc.getCenter() + RS_Vector{a} * arc.getRadius()));
-        }
-    } else {
-        double a0 = arc.getAngle1();
-        QPointF center = mapping(arc.getCenter());
-        QPointF rightMost = mapping(arc.getCenter() + RS_Vector{arc.getRadius(), 0.});
-        double r = std::hypot(center.x() - rightMost.x(), center.y() - rightMost.y());
-        if (arc.isReversed()) {
-            // if the arc is not enclosed in the viewport, we don't care about DashPattern offsets
-            // draw the arc along the positive angular direction; ignore reversed drawing
-            a0 -= arc.getAngleLength();
-            path.moveTo(mapping(arc.getEndpoint()));
-        }
-        path.arcTo(center.x() - r, center.y() - r, r + r, r + r, a0 * 180./M_PI, arc.getAngleLength() * 180./M_PI);
-        if (arc.isReversed()) {
-            // cropped arc, still move the current position to the arc end point
-            path.moveTo(mapping(arc.getEndpoint()));
+    const QPointF endpoint = toQPointF(view.toGui(arc.getEndpoint()));
+    if (visibleArea.intersects(LC_Rect{arc.getMin(), arc.getMax()})) {
+        const double angleLength = arc.isReversed() ? -arc.getAngleLength() : arc.getAngleLength();
+        const int segments = arcSegments(std::abs(view.toGuiDX(arc.getRadius())), angleLength);
+        const double step = angleLength / segments;
+        for (int i = 1; i < segments; ++i) {
+            const RS_Vector point = arc.getCenter() + RS_Vector{arc.getAngle1() + step * i} * arc.getRadius();
+            points.push_back(toQPointF(view.toGui(point)));
         }
     }
-}
-
-void drawPolylineSegment(QPainterPath& path, RS_Entity* entity, const LC_Rect& viewRect, const std::function<QPointF(const RS_Vector&)>& mapping)
-{
-    if (entity == nullptr)
-        return;
-    switch(entity->rtti()) {
-    case RS2::EntityLine:
-        path.lineTo(mapping(entity->getEndpoint()));
-        break;
-    case RS2::EntityArc:
-        drawArc(path, *static_cast<RS_Arc*>(entity), viewRect, mapping);
-        break;
-    default:
-        LC_ERR<<"Polyline may contain lines/arcs only: found rtti() ="<<entity->rtti();
-    }
-}
-
-QPainterPath createPolyline(const RS_Polyline& polyline, const RS_GraphicView& view)
-{
-    QPainterPath path;
-    if (polyline.isEmpty())
-        return path;
-    auto toGui = [&view](const RS_Vector& v) -> QPointF {
-        RS_Vector vGui = view.toGui(v);
-        return {vGui.x, vGui.y};
-    };
-    auto mapingRs=[&toGui](const RS_Vector& vp) -> RS_Vector {
-        QPointF point = toGui(vp);
-        return {point.x(), point.y()};
-    };
-    LC_Rect viewRect{mapingRs(view.getViewRect().minP()), mapingRs(view.getViewRect().maxP())};
-    path.moveTo(toGui(static_cast<RS_AtomicEntity*>(*polyline.begin())->getStartpoint()));
-
-    for(RS_Entity* entity: polyline)
-        drawPolylineSegment(path, entity, viewRect, toGui);
-
-    return path;
+    points.push_back(endpoint);
 }
 }
 
@@ -301,6 +225,18 @@ void RS_PainterQt::drawGridPoint(const RS_Vector& p) {
     QPainter::drawPoint(toScreenX(p.x), toScreenY(p.y));
 }
 
+/**
+ * Draws grid points at once.
+ */
+void RS_PainterQt::drawGridPoints(const QPolygon& points) {
+    if (offset.x != 0. || offset.y != 0.) {
+        QPainter::drawPoints(points.translated(RS_Math::round(offset.x),
+                                               RS_Math::round(offset.y)));
+    } else {
+        QPainter::drawPoints(points);
+    }
+}
+
 
 
 /**
@@ -692,12 +628,22 @@ void RS_PainterQt::drawEllipse(const RS_Vector& cp,
 
     if (std::abs(std::remainder(a2 - a1, 2. * M_PI)) > RS_TOLERANCE_ANGLE)
     {
-        // Elliptic arc: QPainter doesn't support drawing an elliptic arc natively.
-        // Create a QPainterPath to clip the complete ellipse to draw an arc.
-        QPainterPath path = getEllipticArcClipping({double(toScreenX(cp.x)), double(toScreenY(cp.y))}
-                                               , radius1, radius2, angle, a1, a2);
-        setClipping(true);
-        setClipPath(path);
+        // Elliptic arc: QPainter doesn't support drawing an elliptic arc natively,
+        // flatten it into the reused point buffer instead of clipping the ellipse
+        const int segments = arcSegments(std::max(radius1, radius2), a2 - a1);
+        const double step = (a2 - a1) / segments;
+        const double cosAngle = std::cos(angle);
+        const double sinAngle = std::sin(angle);
+        pointBuffer.resize(segments + 1);
+        for (int i = 0; i <= segments; ++i) {
+            // the screen y axis points down, so the ellipse is rotated by -angle
+            const double x = radius1 * std::cos(a1 + step * i);
+            const double y = -radius2 * std::sin(a1 + step * i);
+            pointBuffer[i] = {center.x() + x * cosAngle + y * sinAngle,
+                              center.y() - x * sinAngle + y * cosAngle};
+        }
+        QPainter::drawPolyline(pointBuffer.data(), segments + 1);
+        return;
     }
 
     // The transform to align the
@@ -705,7 +651,8 @@ void RS_PainterQt::drawEllipse(const RS_Vector& cp,
     t1.translate(center.x(), center.y());
     t1.rotate(-angle*180./M_PI);
     t1.translate(-center.x(), -center.y());
-    setTransform(t1, false);
+    // combine with the current transform, previews may draw transformed
+    setTransform(t1, true);
     QPainter::drawEllipse(center, radius1, radius2);
 }
 
@@ -720,7 +667,27 @@ void RS_PainterQt::drawPolyline(const RS_Polyline& polyline, const RS_GraphicVie
 {
     // RAII style QPainter state saving/restoring
     PainterGuard painterGuard{*this};
-    drawPath(createPolyline(polyline, view));
+    if (polyline.isEmpty())
+        return;
+
+    // the segments are flattened into the reused point buffer, so that the dash
+    // pattern runs on over the vertices
+    const LC_Rect visibleArea = view.getVisibleArea();
+    pointBuffer.clear();
+    pointBuffer.push_back(toQPointF(view.toGui(static_cast<RS_AtomicEntity*>(*polyline.begin())->getStartpoint())));
+    for (RS_Entity* entity: polyline) {
+        switch (entity->rtti()) {
+        case RS2::EntityLine:
+            pointBuffer.push_back(toQPointF(view.toGui(entity->getEndpoint())));
+            break;
+        case RS2::EntityArc:
+            appendArc(pointBuffer, *static_cast<RS_Arc*>(entity), view, visibleArea);
+            break;
+        default:
+            LC_ERR<<"Polyline may contain lines/arcs only: found rtti() ="<<entity->rtti();
+        }
+    }
+    QPainter::drawPolyline(pointBuffer.data(), int(pointBuffer.size()));
 }
 
 void RS_PainterQt::drawSpline(const RS_Spline& spline, const RS_GraphicView& view)
@@ -756,7 +723,7 @@ void RS_PainterQt::drawImg(QImage& img, const RS_Vector& pos,
     }
 
     wm->scale(factor.x, factor.y);
-    setWorldTransform(*wm);
+    setWorldTransform(*wm, true);
 
     drawImage(0,-img.height(), img);
 
@@ -863,6 +830,14 @@ void RS_PainterQt::setPen(const RS_Pen& pen) {
         break;
     }
 
+    // consecutive entities mostly share their pens
+    if (lastPenValid && lpen == lastPen
+            && lpen.getScreenWidth() == lastPen.getScreenWidth()
+            && lpen.getAlpha() == lastPen.getAlpha()) {
+        QPainter::setPen(lastQPen);
+        return;
+    }
+
     QColor pColor { lpen.getColor() };
 
     pColor.setAlphaF(pen.getAlpha());
@@ -880,7 +855,12 @@ void RS_PainterQt::setPen(const RS_Pen& pen) {
     }
     p.setJoinStyle(Qt::RoundJoin);
     p.setCapStyle(Qt::RoundCap);
+    // transformed previews keep the widths in screen pixels
+    p.setCosmetic(pushedTransforms > 0);
     QPainter::setPen(p);
+    lastQPen = p;
+    lastPen = lpen;
+    lastPenValid = true;
 }
 
 void RS_PainterQt::setPen(const RS_Color& color) {
@@ -961,6 +941,22 @@ void RS_PainterQt::resetClipping() {
     setClipping(false);
 }
 
+void RS_PainterQt::pushTransform(const LC_AffineTransform& transform) {
+    save();
+    setWorldTransform(QTransform{transform.m11(), transform.m12(),
+                                 transform.m21(), transform.m22(),
+                                 transform.dx(), transform.dy()}, true);
+    ++pushedTransforms;
+    lastPenValid = false;
+}
+
+void RS_PainterQt::popTransform() {
+    restore();
+    if (pushedTransforms > 0)
+        --pushedTransforms;
+    lastPenValid = false;
+}
+
 void RS_PainterQt::fillRect ( const QRectF & rectangle, const RS_Color & color ) {
 
         double x1=rectangle.left();
@@ -1082,15 +1078,16 @@ QPainterPath RS_PainterQt::createSpline(const RS_Spline& spline, const RS_Graphi
         return {vGui.x, vGui.y};
     };
 
-    RS_Entity* e=spline.firstEntity(RS2::ResolveNone);
-    do {
-        auto line = dynamic_cast<RS_Line*>(e);
-        if (line == nullptr)
-            break;
-        if (path.isEmpty())
-            path.moveTo(toGui(line->getStartpoint()));
-        path.lineTo(toGui(line->getEndpoint()));
-    } while ((e = spline.nextEntity(RS2::ResolveNone)) != nullptr);
+    // flatten for the current zoom, to a quarter pixel
+    const double tolerance = 0.25 / std::max(std::abs(view.getFactor().x), RS_TOLERANCE);
+    const LC_Rect visibleArea = view.getVisibleArea();
+    const std::vector<RS_Vector> points = spline.flatten(tolerance, 256, &visibleArea);
+    if (points.size() < 2)
+        return path;
+
+    path.moveTo(toGui(points.front()));
+    for (size_t i = 1; i < points.size(); ++i)
+        path.lineTo(toGui(points[i]));
     return path;
 }
 
@@ -28,6 +28,8 @@
 #ifndef RS_PAINTERQT_H
 #define RS_PAINTERQT_H
 
+#include <vector>
+
 #include <QPainter>
 #include <QPainterPath>
 
@@ -51,6 +53,7 @@ public:
     void moveTo(int x, int y) override;
     void lineTo(int x, int y) override;
     void drawGridPoint(const RS_Vector& p) override;
+    void drawGridPoints(const QPolygon& points) override;
     void drawPoint(const RS_Vector& p, int pdmode, int pdsize) override;
     void drawLine(const RS_Vector& p1, const RS_Vector& p2) override;
     //virtual void drawRect(const RS_Vector& p1, const RS_Vector& p2);
@@ -115,6 +118,9 @@ public:
     void setClipRect(int x, int y, int w, int h) override;
     void resetClipping() override;
 
+    void pushTransform(const LC_AffineTransform& transform) override;
+    void popTransform() override;
+
     RS_Pen& getRsPen();
 
 protected:
@@ -122,6 +128,14 @@ protected:
     QPainterPath createSplinePoints(const LC_SplinePointsData& data) const;
     QPainterPath createSpline(const RS_Spline& spline, const RS_GraphicView& view) const;
     RS_Pen lpen;
+    //! the QPen built for the last pen by setPen(), reused for equal pens
+    QPen lastQPen;
+    RS_Pen lastPen;
+    bool lastPenValid = false;
+    //! number of transformations pushed by pushTransform(), pens are cosmetic while drawing transformed
+    int pushedTransforms = 0;
+    //! screen points of flattened arcs and polylines, reused to avoid allocations
+    std::vector<QPointF> pointBuffer;
     long rememberX = 0; // Used for the moment because QPainter doesn't support moveTo anymore, thus we need to remember ourselves the moveTo positions
     long rememberY = 0;
 };
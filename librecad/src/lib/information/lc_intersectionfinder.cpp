@@ -0,0 +1,398 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include "lc_intersectionfinder.h"
+#include "lc_parallel.h"
+#include "rs_arc.h"
+#include "rs_circle.h"
+#include "rs_ellipse.h"
+#include "rs_entitycontainer.h"
+#include "rs_information.h"
+#include "rs_line.h"
+#include "rs_math.h"
+
+namespace {
+
+//! pieces covering more grid cells are tested against all others instead
+constexpr size_t MaxCellsPerPiece = 1024;
+
+/**
+ * A result of a piece pair, with the indices of the pieces to sort the
+ * results independent of the order the cells were processed in.
+ */
+template<typename T>
+struct Found {
+    size_t piece1 = 0;
+    size_t piece2 = 0;
+    T value;
+};
+
+/**
+ * Counterclockwise angular range of an arc, in circle or ellipse angles.
+ */
+struct AngleRange {
+    double start = 0.;
+    double length = 0.;
+
+    double middle() const {
+        return start + 0.5 * length;
+    }
+    double end() const {
+        return start + length;
+    }
+    /** @return true if the angle is inside the range, away from its ends */
+    bool contains(double angle, double tolerance) const {
+        const double d = RS_Math::correctAngle(angle - start);
+        return d > tolerance && d < length - tolerance;
+    }
+    bool overlaps(const AngleRange& other, double tolerance) const {
+        return contains(other.middle(), tolerance) || other.contains(middle(), tolerance)
+                || contains(other.start, tolerance) || contains(other.end(), tolerance)
+                || other.contains(start, tolerance) || other.contains(end(), tolerance);
+    }
+};
+
+AngleRange angleRange(double angle1, double angle2, double length, bool reversed)
+{
+    return {reversed ? angle2 : angle1, length};
+}
+
+bool isCircular(RS2::EntityType type)
+{
+    return type == RS2::EntityArc || type == RS2::EntityCircle;
+}
+
+bool isPieceType(RS2::EntityType type)
+{
+    switch (type) {
+    case RS2::EntityLine:
+    case RS2::EntityArc:
+    case RS2::EntityCircle:
+    case RS2::EntityEllipse:
+    case RS2::EntitySplinePoints:
+    case RS2::EntitySpline:
+    case RS2::EntityParabola:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/** @return true for containers resolved into pieces */
+bool isResolved(RS2::EntityType type)
+{
+    return type == RS2::EntityPolyline || type == RS2::EntityInsert;
+}
+}
+
+size_t LC_IntersectionFinder::Grid::column(double x) const
+{
+    const double c = std::floor((x - origin.x) / cellSize);
+    return static_cast<size_t>(std::clamp(c, 0., double(columns - 1)));
+}
+
+size_t LC_IntersectionFinder::Grid::row(double y) const
+{
+    const double r = std::floor((y - origin.y) / cellSize);
+    return static_cast<size_t>(std::clamp(r, 0., double(rows - 1)));
+}
+
+LC_IntersectionFinder::LC_IntersectionFinder(double tolerance):
+    m_tolerance(std::max(tolerance, RS_TOLERANCE))
+{}
+
+void LC_IntersectionFinder::add(RS_Entity* entity)
+{
+    if (entity == nullptr || entity->isUndone() || entity->isConstruction())
+        return;
+    addPiece(entity, entity);
+}
+
+void LC_IntersectionFinder::addAll(const RS_EntityContainer& container, bool selectedOnly)
+{
+    for (RS_Entity* e: container) {
+        if (e->isVisible() && (!selectedOnly || e->isSelected()))
+            add(e);
+    }
+}
+
+void LC_IntersectionFinder::addPiece(RS_Entity* entity, RS_Entity* piece)
+{
+    const RS2::EntityType type = piece->rtti();
+    if (isResolved(type)) {
+        for (RS_Entity* child: *static_cast<RS_EntityContainer*>(piece)) {
+            if (!child->isUndone())
+                addPiece(entity, child);
+        }
+    } else if (isPieceType(type)) {
+        m_pieces.push_back({entity, piece, LC_Rect{piece->getMin(), piece->getMax()}});
+    }
+}
+
+/**
+ * Builds a grid of about one cell per piece over the extent of all pieces.
+ * Pieces covering too many cells are left out, they are listed at the end
+ * of cellPieces, after the pieces of the last cell.
+ */
+LC_IntersectionFinder::Grid LC_IntersectionFinder::buildGrid() const
+{
+    Grid grid;
+    const size_t count = m_pieces.size();
+    if (count == 0)
+        return grid;
+
+    RS_Vector minP = m_pieces.front().box.minP();
+    RS_Vector maxP = m_pieces.front().box.maxP();
+    for (const Piece& piece: m_pieces) {
+        minP = RS_Vector::minimum(minP, piece.box.minP());
+        maxP = RS_Vector::maximum(maxP, piece.box.maxP());
+    }
+    const double width = maxP.x - minP.x + 2. * m_tolerance;
+    const double height = maxP.y - minP.y + 2. * m_tolerance;
+    grid.origin = minP - RS_Vector{m_tolerance, m_tolerance};
+    // about one cell per piece, also for very narrow extents
+    grid.cellSize = std::max({std::sqrt(width * height / count),
+                              std::max(width, height) / count, m_tolerance});
+    grid.columns = static_cast<size_t>(width / grid.cellSize) + 1;
+    grid.rows = static_cast<size_t>(height / grid.cellSize) + 1;
+
+    // count the pieces per cell, then fill the cells
+    const size_t cells = grid.columns * grid.rows;
+    std::vector<size_t> cellCount(cells + 1, 0);
+    std::vector<bool> large(count, false);
+    size_t largeCount = 0;
+    auto forEachCell = [this, &grid](const Piece& piece, auto&& func) {
+        const size_t c0 = grid.column(piece.box.minP().x - m_tolerance);
+        const size_t c1 = grid.column(piece.box.maxP().x + m_tolerance);
+        const size_t r0 = grid.row(piece.box.minP().y - m_tolerance);
+        const size_t r1 = grid.row(piece.box.maxP().y + m_tolerance);
+        for (size_t r = r0; r <= r1; ++r)
+            for (size_t c = c0; c <= c1; ++c)
+                func(r * grid.columns + c);
+    };
+    for (size_t i = 0; i < count; ++i) {
+        const Piece& piece = m_pieces[i];
+        const size_t covered = (grid.column(piece.box.maxP().x + m_tolerance)
+                                - grid.column(piece.box.minP().x - m_tolerance) + 1)
+                * (grid.row(piece.box.maxP().y + m_tolerance)
+                   - grid.row(piece.box.minP().y - m_tolerance) + 1);
+        if (covered > MaxCellsPerPiece) {
+            large[i] = true;
+            ++largeCount;
+            continue;
+        }
+        forEachCell(piece, [&cellCount](size_t cell) {
+            ++cellCount[cell];
+        });
+    }
+
+    grid.cellStart.resize(cells + 1, 0);
+    for (size_t cell = 0; cell < cells; ++cell)
+        grid.cellStart[cell + 1] = grid.cellStart[cell] + cellCount[cell];
+    grid.cellPieces.resize(grid.cellStart[cells] + largeCount);
+    std::vector<size_t> fill(grid.cellStart.begin(), grid.cellStart.end() - 1);
+    size_t largeFill = grid.cellStart[cells];
+    for (size_t i = 0; i < count; ++i) {
+        if (large[i]) {
+            grid.cellPieces[largeFill++] = i;
+            continue;
+        }
+        forEachCell(m_pieces[i], [&grid, &fill, i](size_t cell) {
+            grid.cellPieces[fill[cell]++] = i;
+        });
+    }
+    return grid;
+}
+
+template<typename Result, typename Func>
+std::vector<Result> LC_IntersectionFinder::forEachPair(Func&& func) const
+{
+    std::vector<Result> results;
+    const Grid grid = buildGrid();
+    if (grid.cellStart.empty())
+        return results;
+
+    std::mutex mutex;
+    auto collect = [&results, &mutex](std::vector<Result>& found) {
+        if (found.empty())
+            return;
+        std::lock_guard<std::mutex> lock(mutex);
+        results.insert(results.end(), std::make_move_iterator(found.begin()),
+                       std::make_move_iterator(found.end()));
+    };
+    auto isCandidate = [this](size_t i, size_t j) {
+        return m_pieces[i].entity != m_pieces[j].entity
+                && m_pieces[i].box.intersects(m_pieces[j].box, m_tolerance);
+    };
+
+    const size_t cells = grid.cellStart.size() - 1;
+    LC_Parallel::forEachRange(cells, [&](size_t begin, size_t end) {
+        std::vector<Result> found;
+        for (size_t cell = begin; cell < end; ++cell) {
+            for (size_t a = grid.cellStart[cell]; a < grid.cellStart[cell + 1]; ++a) {
+                for (size_t b = a + 1; b < grid.cellStart[cell + 1]; ++b) {
+                    const size_t i = grid.cellPieces[a];
+                    const size_t j = grid.cellPieces[b];
+                    if (!isCandidate(i, j))
+                        continue;
+                    // test pairs sharing several cells only in the cell
+                    // of the lower left corner of their common box
+                    const double x = std::max(m_pieces[i].box.minP().x, m_pieces[j].box.minP().x);
+                    const double y = std::max(m_pieces[i].box.minP().y, m_pieces[j].box.minP().y);
+                    if (grid.row(y) * grid.columns + grid.column(x) == cell)
+                        func(i, j, found);
+                }
+            }
+        }
+        collect(found);
+    }, 64);
+
+    // large pieces against all others
+    const std::vector<size_t> large(grid.cellPieces.begin() + grid.cellStart[cells],
+                                    grid.cellPieces.end());
+    std::vector<bool> isLarge(m_pieces.size(), false);
+    for (size_t i: large)
+        isLarge[i] = true;
+    LC_Parallel::forEachIndex(large.size(), [&](size_t index) {
+        std::vector<Result> found;
+        const size_t i = large[index];
+        for (size_t j = 0; j < m_pieces.size(); ++j) {
+            if (j == i || (isLarge[j] && j < i) || !isCandidate(i, j))
+                continue;
+            func(std::min(i, j), std::max(i, j), found);
+        }
+        collect(found);
+    }, 1);
+
+    std::stable_sort(results.begin(), results.end(), [](const Result& r1, const Result& r2) {
+        return r1.piece1 < r2.piece1 || (r1.piece1 == r2.piece1 && r1.piece2 < r2.piece2);
+    });
+    return results;
+}
+
+std::vector<LC_IntersectionFinder::Intersection> LC_IntersectionFinder::intersections() const
+{
+    auto found = forEachPair<Found<Intersection>>([this](size_t i, size_t j,
+                                                         std::vector<Found<Intersection>>& out) {
+        const Piece& p1 = m_pieces[i];
+        const Piece& p2 = m_pieces[j];
+        const RS_VectorSolutions solutions = RS_Information::getIntersection(p1.piece, p2.piece, true);
+        for (const RS_Vector& point: solutions) {
+            if (point.valid)
+                out.push_back({i, j, {point, p1.entity, p2.entity, p1.piece, p2.piece,
+                                      solutions.isTangent()}});
+        }
+    });
+
+    std::vector<Intersection> result;
+    result.reserve(found.size());
+    for (const auto& f: found)
+        result.push_back(f.value);
+    return result;
+}
+
+std::vector<LC_IntersectionFinder::Overlap> LC_IntersectionFinder::overlaps() const
+{
+    auto found = forEachPair<Found<Overlap>>([this](size_t i, size_t j,
+                                                    std::vector<Found<Overlap>>& out) {
+        const Piece& p1 = m_pieces[i];
+        const Piece& p2 = m_pieces[j];
+        if (isOverlap(p1.piece, p2.piece))
+            out.push_back({i, j, {p1.entity, p2.entity, p1.piece, p2.piece}});
+    });
+
+    std::vector<Overlap> result;
+    result.reserve(found.size());
+    for (const auto& f: found)
+        result.push_back(f.value);
+    return result;
+}
+
+bool LC_IntersectionFinder::isOverlap(const RS_Entity* piece1, const RS_Entity* piece2) const
+{
+    const RS2::EntityType type1 = piece1->rtti();
+    const RS2::EntityType type2 = piece2->rtti();
+
+    if (type1 == RS2::EntityLine && type2 == RS2::EntityLine) {
+        const RS_Vector start = piece1->getStartpoint();
+        RS_Vector direction = piece1->getEndpoint() - start;
+        const double length = direction.magnitude();
+        if (length < m_tolerance)
+            return false;
+        direction /= length;
+        // both end points of the second line on the first line
+        auto distance = [&start, &direction](const RS_Vector& point) {
+            const RS_Vector d = point - start;
+            return std::abs(d.x * direction.y - d.y * direction.x);
+        };
+        if (distance(piece2->getStartpoint()) > m_tolerance
+                || distance(piece2->getEndpoint()) > m_tolerance)
+            return false;
+        const double t1 = (piece2->getStartpoint() - start).dotP(direction);
+        const double t2 = (piece2->getEndpoint() - start).dotP(direction);
+        return std::min(length, std::max(t1, t2)) - std::max(0., std::min(t1, t2)) > m_tolerance;
+    }
+
+    if (isCircular(type1) && isCircular(type2)) {
+        const auto circle1 = static_cast<const RS_AtomicEntity*>(piece1);
+        const auto circle2 = static_cast<const RS_AtomicEntity*>(piece2);
+        const double radius = circle1->getRadius();
+        if (radius < m_tolerance
+                || circle1->getCenter().distanceTo(circle2->getCenter()) > m_tolerance
+                || std::abs(radius - circle2->getRadius()) > m_tolerance)
+            return false;
+        if (type1 == RS2::EntityCircle || type2 == RS2::EntityCircle)
+            return true;
+        const auto arc1 = static_cast<const RS_Arc*>(piece1);
+        const auto arc2 = static_cast<const RS_Arc*>(piece2);
+        const AngleRange range1 = angleRange(arc1->getAngle1(), arc1->getAngle2(),
+                                             arc1->getAngleLength(), arc1->isReversed());
+        const AngleRange range2 = angleRange(arc2->getAngle1(), arc2->getAngle2(),
+                                             arc2->getAngleLength(), arc2->isReversed());
+        return range1.overlaps(range2, m_tolerance / radius);
+    }
+
+    if (type1 == RS2::EntityEllipse && type2 == RS2::EntityEllipse) {
+        const auto ellipse1 = static_cast<const RS_Ellipse*>(piece1);
+        const auto ellipse2 = static_cast<const RS_Ellipse*>(piece2);
+        const double radius = ellipse1->getMajorRadius();
+        if (ellipse1->getRatio() * radius < m_tolerance
+                || ellipse1->getCenter().distanceTo(ellipse2->getCenter()) > m_tolerance
+                || ellipse1->getMajorP().distanceTo(ellipse2->getMajorP()) > m_tolerance
+                || std::abs(ellipse1->getRatio() - ellipse2->getRatio()) * radius > m_tolerance)
+            return false;
+        const AngleRange range1 = angleRange(ellipse1->getAngle1(), ellipse1->getAngle2(),
+                                             ellipse1->getAngleLength(), ellipse1->isReversed());
+        const AngleRange range2 = angleRange(ellipse2->getAngle1(), ellipse2->getAngle2(),
+                                             ellipse2->getAngleLength(), ellipse2->isReversed());
+        // the ellipse angle changes slowest near the major axis
+        return range1.overlaps(range2, m_tolerance / (ellipse1->getRatio() * radius));
+    }
+    return false;
+}
@@ -0,0 +1,140 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_INTERSECTIONFINDER_H
+#define LC_INTERSECTIONFINDER_H
+
+#include <cstddef>
+#include <vector>
+
+#include "lc_rect.h"
+#include "rs.h"
+#include "rs_vector.h"
+
+class RS_Entity;
+class RS_EntityContainer;
+
+/**
+ * Finds all intersections and overlaps within a set of entities at once.
+ *
+ * Containers such as polylines, splines and inserts are resolved into
+ * their atomic pieces: lines, arcs, circles, ellipses and spline points.
+ * The pieces are sorted into a uniform grid by their bounding boxes, and
+ * only pieces sharing a grid cell are tested with
+ * RS_Information::getIntersection(), so the cost grows with the number of
+ * pieces and intersections instead of the number of pairs. The cells are
+ * tested concurrently, the results don't depend on the number of threads.
+ *
+ * Pieces of the same added entity are not tested against each other.
+ * Bulk geometry, texts, dimensions, hatches and images are ignored.
+ * The entities must not be modified while the finder is in use.
+ */
+class LC_IntersectionFinder {
+public:
+    struct Intersection {
+        RS_Vector point;
+        //! the entities as added, e.g. a polyline
+        RS_Entity* entity1 = nullptr;
+        RS_Entity* entity2 = nullptr;
+        //! the intersecting atomic pieces, e.g. segments of the polyline
+        RS_Entity* piece1 = nullptr;
+        RS_Entity* piece2 = nullptr;
+        bool tangent = false;
+    };
+
+    /**
+     * Two pieces covering the same geometry along a stretch longer than the
+     * tolerance: collinear lines, arcs and circles of the same circle, or
+     * elliptic arcs of the same ellipse.
+     */
+    struct Overlap {
+        RS_Entity* entity1 = nullptr;
+        RS_Entity* entity2 = nullptr;
+        RS_Entity* piece1 = nullptr;
+        RS_Entity* piece2 = nullptr;
+    };
+
+    explicit LC_IntersectionFinder(double tolerance = RS_TOLERANCE);
+
+    /** Adds an entity, containers are resolved into their pieces. */
+    void add(RS_Entity* entity);
+    /**
+     * Adds the visible top level entities of a container.
+     * @param selectedOnly only add selected entities
+     */
+    void addAll(const RS_EntityContainer& container, bool selectedOnly);
+
+    /** @return number of atomic pieces to test */
+    size_t count() const {
+        return m_pieces.size();
+    }
+
+    /**
+     * @return all points where two pieces of different entities meet,
+     * sorted by the order the entities were added
+     */
+    std::vector<Intersection> intersections() const;
+    /** @return all overlapping pieces of different entities */
+    std::vector<Overlap> overlaps() const;
+
+private:
+    struct Piece {
+        RS_Entity* entity = nullptr;
+        RS_Entity* piece = nullptr;
+        LC_Rect box;
+    };
+
+    /**
+     * Pieces by grid cell, cell i holds the pieces
+     * m_cellPieces[m_cellStart[i]] to m_cellPieces[m_cellStart[i + 1] - 1].
+     */
+    struct Grid {
+        RS_Vector origin;
+        double cellSize = 1.;
+        size_t columns = 0;
+        size_t rows = 0;
+        std::vector<size_t> cellStart;
+        std::vector<size_t> cellPieces;
+
+        size_t column(double x) const;
+        size_t row(double y) const;
+    };
+
+    void addPiece(RS_Entity* entity, RS_Entity* piece);
+    Grid buildGrid() const;
+    /**
+     * Calls func(i, j) once for every pair of pieces of different entities
+     * with overlapping boxes, concurrently for different cells.
+     * Collects the results appended by func to the vector passed to it.
+     */
+    template<typename Result, typename Func>
+    std::vector<Result> forEachPair(Func&& func) const;
+    bool isOverlap(const RS_Entity* piece1, const RS_Entity* piece2) const;
+
+    double m_tolerance = RS_TOLERANCE;
+    std::vector<Piece> m_pieces;
+};
+
+#endif // LC_INTERSECTIONFINDER_H
@@ -36,9 +36,11 @@
 #include "rs_ellipse.h"
 #include "rs_line.h"
 #include "rs_polyline.h"
+#include "rs_spline.h"
 #include "lc_quadratic.h"
 #include "lc_splinepoints.h"
 #include "rs_math.h"
+#include "lc_containertraverser.h"
 #include "lc_rect.h"
 #include "rs_debug.h"
 
@@ -249,15 +251,12 @@ RS_VectorSolutions RS_Information::getIntersection(RS_Entity const* e1,
 		}
 	}
 
-    //avoid intersections between line segments the same spline
-    /* ToDo: 24 Aug 2011, Dongxu Li, if rtti() is not defined for the parent, the following check for splines may still cause segfault */
-	if ( e1->getParent() && e1->getParent() == e2->getParent()) {
-        if ( e1->getParent()->rtti()==RS2::EntitySpline ) {
-            //do not calculate intersections from neighboring lines of a spline
-            if ( abs(e1->getParent()->findEntity(e1) - e1->getParent()->findEntity(e2)) <= 1 ) {
-                return ret;
-            }
-        }
+    // splines are intersected by the segments of their tessellation
+    if (e1->rtti() == RS2::EntitySpline) {
+        return getIntersectionSpline(static_cast<RS_Spline const*>(e1), e2, onEntities);
+    }
+    if (e2->rtti() == RS2::EntitySpline) {
+        return getIntersectionSpline(static_cast<RS_Spline const*>(e2), e1, onEntities);
     }
 
 	if(e1->rtti() == RS2::EntitySplinePoints || e2->rtti() == RS2::EntitySplinePoints)
@@ -334,6 +333,35 @@ RS_VectorSolutions RS_Information::getIntersection(RS_Entity const* e1,
 
 
 
+RS_VectorSolutions RS_Information::getIntersectionSpline(RS_Spline const* spline,
+        RS_Entity const* other, bool onEntities) {
+
+    RS_VectorSolutions ret;
+    const double tol = 1.0e-4;
+    const std::vector<RS_Vector>& points = spline->getTessellation();
+    for (size_t i = 1; i < points.size(); ++i) {
+        RS_Line segment{nullptr, points[i - 1], points[i]};
+        const RS_VectorSolutions sol = getIntersection(&segment, other, onEntities);
+        for (const RS_Vector& vp: sol) {
+            // intersections beyond the segment belong to its neighbours
+            if (!vp.valid || !segment.isPointOnEntity(vp, tol)) {
+                continue;
+            }
+            // a point at a vertex is found for both segments at the vertex
+            if (ret.size() > 0 && ret.getClosestDistance(vp) < tol) {
+                continue;
+            }
+            ret.push_back(vp);
+        }
+        if (sol.isTangent()) {
+            ret.setTangent(true);
+        }
+    }
+    return ret;
+}
+
+
+
 /**
  * @return Intersection between two lines.
  */
@@ -785,9 +813,8 @@ bool RS_Information::isPointInsideContour(const RS_Vector& point,
             *onContour = false;
         }
 
-        for (RS_Entity* e = contour->firstEntity(RS2::ResolveAll);
-				e;
-                e = contour->nextEntity(RS2::ResolveAll)) {
+        LC_ContainerTraverser traverser{*contour, RS2::ResolveAll};
+        for (RS_Entity* e = traverser.first(); e; e = traverser.next()) {
 
             // intersection(s) from ray with contour entity:
             sol = RS_Information::getIntersection(&ray, e, true);
@@ -37,6 +37,7 @@ class RS_VectorSolutions;
 class RS_Arc;
 class RS_Circle;
 class RS_Line;
+class RS_Spline;
 
 /**
  * Class for getting information about entities. This includes
@@ -89,6 +90,12 @@ public:
     
 	static RS_VectorSolutions getIntersectionEllipseLine(RS_Line* line,
             RS_Ellipse* ellipse);
+	/**
+	 * @return Intersections between the tessellation of a spline and
+	 * another entity, which may be a spline as well.
+	 */
+	static RS_VectorSolutions getIntersectionSpline(RS_Spline const* spline,
+			RS_Entity const* other, bool onEntities);
 	/**
 	 * @brief createQuadrilateral form quadrilateral from 4 straight lines
 	 * @param container contains 4 straight lines
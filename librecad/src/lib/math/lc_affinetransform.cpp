@@ -0,0 +1,133 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <cmath>
+
+#include "lc_affinetransform.h"
+
+#include "rs.h"
+
+LC_AffineTransform::LC_AffineTransform(double m11, double m12, double m21, double m22,
+                                       double dx, double dy):
+    m_m11{m11}
+  , m_m12{m12}
+  , m_m21{m21}
+  , m_m22{m22}
+  , m_dx{dx}
+  , m_dy{dy}
+{
+}
+
+LC_AffineTransform LC_AffineTransform::translation(const RS_Vector& offset)
+{
+    return {1., 0., 0., 1., offset.x, offset.y};
+}
+
+/**
+ * @return counter-clockwise rotation by angle (in rad) around center,
+ * like RS_Vector::rotate()
+ */
+LC_AffineTransform LC_AffineTransform::rotation(const RS_Vector& center, double angle)
+{
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    return {c, s, -s, c,
+            center.x - c * center.x + s * center.y,
+            center.y - s * center.x - c * center.y};
+}
+
+/**
+ * @return scaling by factor.x and factor.y relative to center, like RS_Vector::scale()
+ */
+LC_AffineTransform LC_AffineTransform::scaling(const RS_Vector& center, const RS_Vector& factor)
+{
+    return {factor.x, 0., 0., factor.y,
+            center.x - factor.x * center.x,
+            center.y - factor.y * center.y};
+}
+
+/**
+ * @return reflection at the axis through both points, like RS_Vector::mirror().
+ * The identity is returned for a degenerated axis.
+ */
+LC_AffineTransform LC_AffineTransform::mirroring(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2)
+{
+    const RS_Vector direction = axisPoint2 - axisPoint1;
+    const double length2 = direction.squared();
+    if (length2 < RS_TOLERANCE2)
+        return {};
+
+    const double m11 = 2. * direction.x * direction.x / length2 - 1.;
+    const double m22 = 2. * direction.y * direction.y / length2 - 1.;
+    const double m12 = 2. * direction.x * direction.y / length2;
+    return {m11, m12, m12, m22,
+            axisPoint1.x - m11 * axisPoint1.x - m12 * axisPoint1.y,
+            axisPoint1.y - m12 * axisPoint1.x - m22 * axisPoint1.y};
+}
+
+/**
+ * @return the transformation applying this one first, and next afterwards
+ */
+LC_AffineTransform LC_AffineTransform::then(const LC_AffineTransform& next) const
+{
+    return {next.m_m11 * m_m11 + next.m_m21 * m_m12,
+            next.m_m12 * m_m11 + next.m_m22 * m_m12,
+            next.m_m11 * m_m21 + next.m_m21 * m_m22,
+            next.m_m12 * m_m21 + next.m_m22 * m_m22,
+            next.m_m11 * m_dx + next.m_m21 * m_dy + next.m_dx,
+            next.m_m12 * m_dx + next.m_m22 * m_dy + next.m_dy};
+}
+
+/**
+ * Calculates the inverse transformation.
+ * @return false, if the transformation is not invertible
+ */
+bool LC_AffineTransform::invert(LC_AffineTransform& inverse) const
+{
+    const double determinant = m_m11 * m_m22 - m_m21 * m_m12;
+    if (std::abs(determinant) < RS_TOLERANCE2)
+        return false;
+
+    const double m11 = m_m22 / determinant;
+    const double m12 = -m_m12 / determinant;
+    const double m21 = -m_m21 / determinant;
+    const double m22 = m_m11 / determinant;
+    inverse = {m11, m12, m21, m22,
+               -(m11 * m_dx + m21 * m_dy),
+               -(m12 * m_dx + m22 * m_dy)};
+    return true;
+}
+
+RS_Vector LC_AffineTransform::map(const RS_Vector& point) const
+{
+    return {m_m11 * point.x + m_m21 * point.y + m_dx,
+            m_m12 * point.x + m_m22 * point.y + m_dy};
+}
+
+bool LC_AffineTransform::isIdentity() const
+{
+    return m_m11 == 1. && m_m12 == 0. && m_m21 == 0. && m_m22 == 1.
+            && m_dx == 0. && m_dy == 0.;
+}
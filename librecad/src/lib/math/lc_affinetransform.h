@@ -0,0 +1,69 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_AFFINETRANSFORM_H
+#define LC_AFFINETRANSFORM_H
+
+#include "rs_vector.h"
+
+/**
+ * A 2D affine transformation, used to preview moved, rotated, scaled or
+ * mirrored entities without modifying copies of them.
+ *
+ * The naming follows QTransform: a point (x, y) is mapped to
+ * (m11 * x + m21 * y + dx, m12 * x + m22 * y + dy).
+ */
+class LC_AffineTransform {
+public:
+    LC_AffineTransform() = default;
+    LC_AffineTransform(double m11, double m12, double m21, double m22, double dx, double dy);
+
+    static LC_AffineTransform translation(const RS_Vector& offset);
+    static LC_AffineTransform rotation(const RS_Vector& center, double angle);
+    static LC_AffineTransform scaling(const RS_Vector& center, const RS_Vector& factor);
+    static LC_AffineTransform mirroring(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2);
+
+    LC_AffineTransform then(const LC_AffineTransform& next) const;
+    bool invert(LC_AffineTransform& inverse) const;
+    RS_Vector map(const RS_Vector& point) const;
+    bool isIdentity() const;
+
+    double m11() const { return m_m11; }
+    double m12() const { return m_m12; }
+    double m21() const { return m_m21; }
+    double m22() const { return m_m22; }
+    double dx() const { return m_dx; }
+    double dy() const { return m_dy; }
+
+private:
+    double m_m11 = 1.;
+    double m_m12 = 0.;
+    double m_m21 = 0.;
+    double m_m22 = 1.;
+    double m_dx = 0.;
+    double m_dy = 0.;
+};
+
+#endif // LC_AFFINETRANSFORM_H
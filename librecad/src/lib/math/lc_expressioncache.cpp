@@ -0,0 +1,228 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <muParser.h>
+
+#include "lc_expressioncache.h"
+
+#include "rs_debug.h"
+#include "rs_math.h"
+
+namespace {
+
+// the cache is cleared when it grows beyond this number of expressions
+constexpr size_t g_maxEntries = 1024;
+
+mu::string_type toMuString(const QString& str)
+{
+#ifdef _UNICODE
+    return str.toStdWString();
+#else
+    return str.toStdString();
+#endif
+}
+
+QString fromMuString(const mu::string_type& str)
+{
+#ifdef _UNICODE
+    return QString::fromStdWString(str);
+#else
+    return QString::fromStdString(str);
+#endif
+}
+}
+
+/**
+ * A compiled expression with the buffers its variables are bound to.
+ */
+struct LC_ExpressionCache::Entry {
+    mu::Parser parser;
+    bool valid = true;
+    QStringList names;
+    std::vector<std::vector<double>> buffers;
+
+    /**
+     * Binds the variables to buffers for at least count values.
+     * Rebinding makes muParser compile the expression again, so the
+     * buffers only grow.
+     */
+    void reserve(size_t count)
+    {
+        if (!buffers.empty() && buffers.front().size() >= count)
+            return;
+        buffers.resize(names.size());
+        for (int i = 0; i < names.size(); ++i) {
+            buffers[i].resize(std::max<size_t>(count, 1));
+            parser.DefineVar(toMuString(names.at(i)), buffers[i].data());
+        }
+    }
+};
+
+LC_ExpressionCache& LC_ExpressionCache::instance()
+{
+    static LC_ExpressionCache cache;
+    return cache;
+}
+
+/**
+ * @return the expression with leading and trailing whitespace removed and
+ * inner whitespace runs replaced by single spaces
+ */
+QString LC_ExpressionCache::normalize(const QString& expr)
+{
+    return expr.simplified();
+}
+
+/**
+ * @return the cache entry for the expression and variables, the entry is
+ * created and compiled if needed. Called with the mutex locked.
+ */
+LC_ExpressionCache::Entry* LC_ExpressionCache::findEntry(const QString& expr,
+                                                         const QStringList& variables)
+{
+    const QString text = normalize(expr);
+    const QString key = variables.join(',') + '\n' + text;
+    auto it = m_entries.find(key);
+    if (it != m_entries.end())
+        return it->second.get();
+
+    if (m_entries.size() >= g_maxEntries)
+        m_entries.clear();
+
+    auto entry = std::make_unique<Entry>();
+    entry->names = variables;
+    try {
+        entry->parser.DefineConst(toMuString("pi"), M_PI);
+        entry->reserve(1);
+        entry->parser.SetExpr(toMuString(RS_Math::derationalize(text)));
+    }
+    catch (mu::Parser::exception_type& e) {
+        RS_DEBUG->print(RS_Debug::D_WARNING, "LC_ExpressionCache: %s",
+                        fromMuString(e.GetMsg()).toLatin1().data());
+        entry->valid = false;
+    }
+    Entry* result = entry.get();
+    m_entries.emplace(key, std::move(entry));
+    return result;
+}
+
+/**
+ * Evaluates an expression without variables.
+ * @return false, if the expression is empty or invalid
+ */
+bool LC_ExpressionCache::evaluate(const QString& expr, double& result)
+{
+    if (expr.isEmpty())
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry* entry = findEntry(expr, {});
+    if (!entry->valid)
+        return false;
+    try {
+        result = entry->parser.Eval();
+    }
+    catch (mu::Parser::exception_type& e) {
+        // parse errors are only reported by the first evaluation
+        RS_DEBUG->print(RS_Debug::D_WARNING, "LC_ExpressionCache: %s",
+                        fromMuString(e.GetMsg()).toLatin1().data());
+        entry->valid = false;
+    }
+    return entry->valid;
+}
+
+/**
+ * Evaluates an expression for every value of a single variable.
+ */
+bool LC_ExpressionCache::evaluate(const QString& expr,
+                                  const QString& variable,
+                                  const std::vector<double>& values,
+                                  std::vector<double>& results)
+{
+    return evaluate(expr, QStringList{variable}, {&values}, results);
+}
+
+/**
+ * Evaluates an expression in bulk. The i-th result is computed with every
+ * variable set to the i-th value of its array.
+ *
+ * @param variables names of the variables
+ * @param values one array of values per variable, all of the same size
+ * @param results the results, one per value
+ * @return false, if the expression is empty or invalid or the arrays
+ * don't match the variables
+ */
+bool LC_ExpressionCache::evaluate(const QString& expr,
+                                  const QStringList& variables,
+                                  const std::vector<const std::vector<double>*>& values,
+                                  std::vector<double>& results)
+{
+    results.clear();
+    if (expr.isEmpty() || values.size() != size_t(variables.size()))
+        return false;
+    const size_t count = values.empty() ? 1 : values.front()->size();
+    for (const std::vector<double>* array: values) {
+        if (array == nullptr || array->size() != count)
+            return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry* entry = findEntry(expr, variables);
+    if (!entry->valid)
+        return false;
+    try {
+        entry->reserve(count);
+        for (size_t i = 0; i < values.size(); ++i)
+            std::copy(values[i]->cbegin(), values[i]->cend(), entry->buffers[i].begin());
+        results.resize(count);
+        if (count > 0)
+            entry->parser.Eval(results.data(), static_cast<int>(count));
+    }
+    catch (mu::Parser::exception_type& e) {
+        RS_DEBUG->print(RS_Debug::D_WARNING, "LC_ExpressionCache: %s",
+                        fromMuString(e.GetMsg()).toLatin1().data());
+        entry->valid = false;
+        results.clear();
+    }
+    return entry->valid;
+}
+
+void LC_ExpressionCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+/**
+ * @return number of cached expressions
+ */
+size_t LC_ExpressionCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
@@ -0,0 +1,78 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_EXPRESSIONCACHE_H
+#define LC_EXPRESSIONCACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * Cache of compiled muParser expressions.
+ *
+ * Expressions are keyed by their normalized text (see normalize()) and the
+ * names of the variables they may use. The first evaluation parses the
+ * expression into muParser bytecode, later evaluations of the same text
+ * only run the bytecode. Invalid expressions are cached as well, so
+ * validating input on every keystroke does not parse the same text again.
+ *
+ * Like RS_Math::eval(), expressions may contain the constant "pi", and
+ * fractions and unit symbols are converted by RS_Math::derationalize().
+ */
+class LC_ExpressionCache {
+public:
+    static LC_ExpressionCache& instance();
+
+    bool evaluate(const QString& expr, double& result);
+    bool evaluate(const QString& expr,
+                  const QString& variable,
+                  const std::vector<double>& values,
+                  std::vector<double>& results);
+    bool evaluate(const QString& expr,
+                  const QStringList& variables,
+                  const std::vector<const std::vector<double>*>& values,
+                  std::vector<double>& results);
+
+    void clear();
+    size_t size() const;
+
+    static QString normalize(const QString& expr);
+
+private:
+    struct Entry;
+
+    LC_ExpressionCache() = default;
+    Entry* findEntry(const QString& expr, const QStringList& variables);
+
+    mutable std::mutex m_mutex;
+    std::map<QString, std::unique_ptr<Entry>> m_entries;
+};
+
+#endif // LC_EXPRESSIONCACHE_H
@@ -0,0 +1,430 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include "lc_segmentdistance.h"
+
+#include "rs.h"
+
+#if defined(__AVX__)
+#define LC_SEGMENTDISTANCE_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LC_SEGMENTDISTANCE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define LC_SEGMENTDISTANCE_NEON
+#include <arm_neon.h>
+#endif
+
+// The batch kernels must produce bit identical distances to the scalar
+// path, so multiply-add pairs must not be fused into FMA instructions.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace {
+
+constexpr double g_noDistance = std::numeric_limits<double>::infinity();
+
+/**
+ * Updates the result for the element at index with squared distance d2.
+ * Only strictly smaller distances replace the current result, so the
+ * lowest index wins among equal distances.
+ */
+inline void updateResult(LC_SegmentDistance::Result& result, size_t index, double d2)
+{
+    if (d2 < result.distance2) {
+        result.distance2 = d2;
+        result.index = index;
+    }
+}
+
+inline double pointDistance2(double px, double py, double x, double y)
+{
+    const double dx = x - px;
+    const double dy = y - py;
+    return dx * dx + dy * dy;
+}
+
+/**
+ * Scalar processing of the elements [begin, count), continuing the given result.
+ */
+LC_SegmentDistance::Result segmentTail(LC_SegmentDistance::Result result,
+                                       double px, double py,
+                                       const double* x1, const double* y1,
+                                       const double* x2, const double* y2,
+                                       size_t begin, size_t count)
+{
+    for (size_t i = begin; i < count; ++i)
+        updateResult(result, i, LC_SegmentDistance::segmentDistance2(px, py, x1[i], y1[i], x2[i], y2[i]));
+    return result;
+}
+
+LC_SegmentDistance::Result pointTail(LC_SegmentDistance::Result result,
+                                     double px, double py,
+                                     const double* x, const double* y,
+                                     size_t begin, size_t count)
+{
+    for (size_t i = begin; i < count; ++i)
+        updateResult(result, i, pointDistance2(px, py, x[i], y[i]));
+    return result;
+}
+
+/**
+ * Reduces the per lane minima to a single result. Lanes hold disjoint
+ * index sets, ties are resolved to the lowest index.
+ */
+template<size_t Lanes>
+LC_SegmentDistance::Result reduceLanes(const double (&distances)[Lanes],
+                                       const double (&indices)[Lanes],
+                                       size_t count)
+{
+    LC_SegmentDistance::Result result{count, g_noDistance};
+    for (size_t lane = 0; lane < Lanes; ++lane) {
+        const auto index = static_cast<size_t>(indices[lane]);
+        if (distances[lane] < result.distance2
+                || (distances[lane] == result.distance2 && index < result.index)) {
+            result.distance2 = distances[lane];
+            result.index = index;
+        }
+    }
+    return result;
+}
+
+#if defined(LC_SEGMENTDISTANCE_AVX)
+
+constexpr size_t g_lanes = 4;
+
+LC_SegmentDistance::Result segmentBatch(double px, double py,
+                                        const double* x1, const double* y1,
+                                        const double* x2, const double* y2,
+                                        size_t count)
+{
+    const __m256d vpx = _mm256_set1_pd(px);
+    const __m256d vpy = _mm256_set1_pd(py);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d tolerance = _mm256_set1_pd(RS_TOLERANCE2);
+    const __m256d step = _mm256_set1_pd(double(g_lanes));
+    __m256d index = _mm256_setr_pd(0., 1., 2., 3.);
+    __m256d best = _mm256_set1_pd(g_noDistance);
+    __m256d bestIndex = _mm256_set1_pd(double(count));
+
+    const size_t end = count - count % g_lanes;
+    for (size_t i = 0; i < end; i += g_lanes) {
+        const __m256d sx = _mm256_loadu_pd(x1 + i);
+        const __m256d sy = _mm256_loadu_pd(y1 + i);
+        const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x2 + i), sx);
+        const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y2 + i), sy);
+        const __m256d length2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        const __m256d dot = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(vpx, sx), dx),
+                                          _mm256_mul_pd(_mm256_sub_pd(vpy, sy), dy));
+        __m256d t = _mm256_min_pd(_mm256_max_pd(_mm256_div_pd(dot, length2), zero), one);
+        t = _mm256_blendv_pd(t, half, _mm256_cmp_pd(length2, tolerance, _CMP_LT_OQ));
+        const __m256d cx = _mm256_sub_pd(_mm256_add_pd(sx, _mm256_mul_pd(t, dx)), vpx);
+        const __m256d cy = _mm256_sub_pd(_mm256_add_pd(sy, _mm256_mul_pd(t, dy)), vpy);
+        const __m256d d2 = _mm256_add_pd(_mm256_mul_pd(cx, cx), _mm256_mul_pd(cy, cy));
+        const __m256d closer = _mm256_cmp_pd(d2, best, _CMP_LT_OQ);
+        best = _mm256_blendv_pd(best, d2, closer);
+        bestIndex = _mm256_blendv_pd(bestIndex, index, closer);
+        index = _mm256_add_pd(index, step);
+    }
+
+    double distances[g_lanes];
+    double indices[g_lanes];
+    _mm256_storeu_pd(distances, best);
+    _mm256_storeu_pd(indices, bestIndex);
+    return segmentTail(reduceLanes(distances, indices, count), px, py, x1, y1, x2, y2, end, count);
+}
+
+LC_SegmentDistance::Result pointBatch(double px, double py,
+                                      const double* x, const double* y,
+                                      size_t count)
+{
+    const __m256d vpx = _mm256_set1_pd(px);
+    const __m256d vpy = _mm256_set1_pd(py);
+    const __m256d step = _mm256_set1_pd(double(g_lanes));
+    __m256d index = _mm256_setr_pd(0., 1., 2., 3.);
+    __m256d best = _mm256_set1_pd(g_noDistance);
+    __m256d bestIndex = _mm256_set1_pd(double(count));
+
+    const size_t end = count - count % g_lanes;
+    for (size_t i = 0; i < end; i += g_lanes) {
+        const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), vpx);
+        const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), vpy);
+        const __m256d d2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        const __m256d closer = _mm256_cmp_pd(d2, best, _CMP_LT_OQ);
+        best = _mm256_blendv_pd(best, d2, closer);
+        bestIndex = _mm256_blendv_pd(bestIndex, index, closer);
+        index = _mm256_add_pd(index, step);
+    }
+
+    double distances[g_lanes];
+    double indices[g_lanes];
+    _mm256_storeu_pd(distances, best);
+    _mm256_storeu_pd(indices, bestIndex);
+    return pointTail(reduceLanes(distances, indices, count), px, py, x, y, end, count);
+}
+
+#elif defined(LC_SEGMENTDISTANCE_SSE2)
+
+constexpr size_t g_lanes = 2;
+
+// SSE2 has no blend instruction
+inline __m128d select(__m128d mask, __m128d a, __m128d b)
+{
+    return _mm_or_pd(_mm_and_pd(mask, b), _mm_andnot_pd(mask, a));
+}
+
+LC_SegmentDistance::Result segmentBatch(double px, double py,
+                                        const double* x1, const double* y1,
+                                        const double* x2, const double* y2,
+                                        size_t count)
+{
+    const __m128d vpx = _mm_set1_pd(px);
+    const __m128d vpy = _mm_set1_pd(py);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd(1.);
+    const __m128d half = _mm_set1_pd(0.5);
+    const __m128d tolerance = _mm_set1_pd(RS_TOLERANCE2);
+    const __m128d step = _mm_set1_pd(double(g_lanes));
+    __m128d index = _mm_setr_pd(0., 1.);
+    __m128d best = _mm_set1_pd(g_noDistance);
+    __m128d bestIndex = _mm_set1_pd(double(count));
+
+    const size_t end = count - count % g_lanes;
+    for (size_t i = 0; i < end; i += g_lanes) {
+        const __m128d sx = _mm_loadu_pd(x1 + i);
+        const __m128d sy = _mm_loadu_pd(y1 + i);
+        const __m128d dx = _mm_sub_pd(_mm_loadu_pd(x2 + i), sx);
+        const __m128d dy = _mm_sub_pd(_mm_loadu_pd(y2 + i), sy);
+        const __m128d length2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        const __m128d dot = _mm_add_pd(_mm_mul_pd(_mm_sub_pd(vpx, sx), dx),
+                                       _mm_mul_pd(_mm_sub_pd(vpy, sy), dy));
+        __m128d t = _mm_min_pd(_mm_max_pd(_mm_div_pd(dot, length2), zero), one);
+        t = select(_mm_cmplt_pd(length2, tolerance), t, half);
+        const __m128d cx = _mm_sub_pd(_mm_add_pd(sx, _mm_mul_pd(t, dx)), vpx);
+        const __m128d cy = _mm_sub_pd(_mm_add_pd(sy, _mm_mul_pd(t, dy)), vpy);
+        const __m128d d2 = _mm_add_pd(_mm_mul_pd(cx, cx), _mm_mul_pd(cy, cy));
+        const __m128d closer = _mm_cmplt_pd(d2, best);
+        best = select(closer, best, d2);
+        bestIndex = select(closer, bestIndex, index);
+        index = _mm_add_pd(index, step);
+    }
+
+    double distances[g_lanes];
+    double indices[g_lanes];
+    _mm_storeu_pd(distances, best);
+    _mm_storeu_pd(indices, bestIndex);
+    return segmentTail(reduceLanes(distances, indices, count), px, py, x1, y1, x2, y2, end, count);
+}
+
+LC_SegmentDistance::Result pointBatch(double px, double py,
+                                      const double* x, const double* y,
+                                      size_t count)
+{
+    const __m128d vpx = _mm_set1_pd(px);
+    const __m128d vpy = _mm_set1_pd(py);
+    const __m128d step = _mm_set1_pd(double(g_lanes));
+    __m128d index = _mm_setr_pd(0., 1.);
+    __m128d best = _mm_set1_pd(g_noDistance);
+    __m128d bestIndex = _mm_set1_pd(double(count));
+
+    const size_t end = count - count % g_lanes;
+    for (size_t i = 0; i < end; i += g_lanes) {
+        const __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), vpx);
+        const __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i), vpy);
+        const __m128d d2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        const __m128d closer = _mm_cmplt_pd(d2, best);
+        best = select(closer, best, d2);
+        bestIndex = select(closer, bestIndex, index);
+        index = _mm_add_pd(index, step);
+    }
+
+    double distances[g_lanes];
+    double indices[g_lanes];
+    _mm_storeu_pd(distances, best);
+    _mm_storeu_pd(indices, bestIndex);
+    return pointTail(reduceLanes(distances, indices, count), px, py, x, y, end, count);
+}
+
+#elif defined(LC_SEGMENTDISTANCE_NEON)
+
+constexpr size_t g_lanes = 2;
+
+LC_SegmentDistance::Result segmentBatch(double px, double py,
+                                        const double* x1, const double* y1,
+                                        const double* x2, const double* y2,
+                                        size_t count)
+{
+    const float64x2_t vpx = vdupq_n_f64(px);
+    const float64x2_t vpy = vdupq_n_f64(py);
+    const float64x2_t zero = vdupq_n_f64(0.);
+    const float64x2_t one = vdupq_n_f64(1.);
+    const float64x2_t half = vdupq_n_f64(0.5);
+    const float64x2_t tolerance = vdupq_n_f64(RS_TOLERANCE2);
+    const float64x2_t step = vdupq_n_f64(double(g_lanes));
+    const double firstIndices[g_lanes] = {0., 1.};
+    float64x2_t index = vld1q_f64(firstIndices);
+    float64x2_t best = vdupq_n_f64(g_noDistance);
+    float64x2_t bestIndex = vdupq_n_f64(double(count));
+
+    const size_t end = count - count % g_lanes;
+    for (size_t i = 0; i < end; i += g_lanes) {
+        const float64x2_t sx = vld1q_f64(x1 + i);
+        const float64x2_t sy = vld1q_f64(y1 + i);
+        const float64x2_t dx = vsubq_f64(vld1q_f64(x2 + i), sx);
+        const float64x2_t dy = vsubq_f64(vld1q_f64(y2 + i), sy);
+        const float64x2_t length2 = vaddq_f64(vmulq_f64(dx, dx), vmulq_f64(dy, dy));
+        const float64x2_t dot = vaddq_f64(vmulq_f64(vsubq_f64(vpx, sx), dx),
+                                          vmulq_f64(vsubq_f64(vpy, sy), dy));
+        float64x2_t t = vdivq_f64(dot, length2);
+        // std::max()/std::min() semantics: keep the first operand unless the other one is larger/smaller
+        t = vbslq_f64(vcltq_f64(zero, t), t, zero);
+        t = vbslq_f64(vcltq_f64(t, one), t, one);
+        t = vbslq_f64(vcltq_f64(length2, tolerance), half, t);
+        const float64x2_t cx = vsubq_f64(vaddq_f64(sx, vmulq_f64(t, dx)), vpx);
+        const float64x2_t cy = vsubq_f64(vaddq_f64(sy, vmulq_f64(t, dy)), vpy);
+        const float64x2_t d2 = vaddq_f64(vmulq_f64(cx, cx), vmulq_f64(cy, cy));
+        const uint64x2_t closer = vcltq_f64(d2, best);
+        best = vbslq_f64(closer, d2, best);
+        bestIndex = vbslq_f64(closer, index, bestIndex);
+        index = vaddq_f64(index, step);
+    }
+
+    double distances[g_lanes];
+    double indices[g_lanes];
+    vst1q_f64(distances, best);
+    vst1q_f64(indices, bestIndex);
+    return segmentTail(reduceLanes(distances, indices, count), px, py, x1, y1, x2, y2, end, count);
+}
+
+LC_SegmentDistance::Result pointBatch(double px, double py,
+                                      const double* x, const double* y,
+                                      size_t count)
+{
+    const float64x2_t vpx = vdupq_n_f64(px);
+    const float64x2_t vpy = vdupq_n_f64(py);
+    const float64x2_t step = vdupq_n_f64(double(g_lanes));
+    const double firstIndices[g_lanes] = {0., 1.};
+    float64x2_t index = vld1q_f64(firstIndices);
+    float64x2_t best = vdupq_n_f64(g_noDistance);
+    float64x2_t bestIndex = vdupq_n_f64(double(count));
+
+    const size_t end = count - count % g_lanes;
+    for (size_t i = 0; i < end; i += g_lanes) {
+        const float64x2_t dx = vsubq_f64(vld1q_f64(x + i), vpx);
+        const float64x2_t dy = vsubq_f64(vld1q_f64(y + i), vpy);
+        const float64x2_t d2 = vaddq_f64(vmulq_f64(dx, dx), vmulq_f64(dy, dy));
+        const uint64x2_t closer = vcltq_f64(d2, best);
+        best = vbslq_f64(closer, d2, best);
+        bestIndex = vbslq_f64(closer, index, bestIndex);
+        index = vaddq_f64(index, step);
+    }
+
+    double distances[g_lanes];
+    double indices[g_lanes];
+    vst1q_f64(distances, best);
+    vst1q_f64(indices, bestIndex);
+    return pointTail(reduceLanes(distances, indices, count), px, py, x, y, end, count);
+}
+
+#endif
+}
+
+namespace LC_SegmentDistance {
+
+double segmentDistance2(double px, double py,
+                        double x1, double y1, double x2, double y2)
+{
+    const double dx = x2 - x1;
+    const double dy = y2 - y1;
+    const double length2 = dx * dx + dy * dy;
+    double t = std::min(1., std::max(0., ((px - x1) * dx + (py - y1) * dy) / length2));
+    // degenerated segments are measured from their middle point
+    if (length2 < RS_TOLERANCE2)
+        t = 0.5;
+    const double cx = x1 + t * dx - px;
+    const double cy = y1 + t * dy - py;
+    return cx * cx + cy * cy;
+}
+
+Result nearestSegmentScalar(double px, double py,
+                            const double* x1, const double* y1,
+                            const double* x2, const double* y2,
+                            size_t count)
+{
+    return segmentTail({count, g_noDistance}, px, py, x1, y1, x2, y2, 0, count);
+}
+
+Result nearestPointScalar(double px, double py,
+                          const double* x, const double* y,
+                          size_t count)
+{
+    return pointTail({count, g_noDistance}, px, py, x, y, 0, count);
+}
+
+Result nearestSegment(double px, double py,
+                      const double* x1, const double* y1,
+                      const double* x2, const double* y2,
+                      size_t count)
+{
+#if defined(LC_SEGMENTDISTANCE_AVX) || defined(LC_SEGMENTDISTANCE_SSE2) || defined(LC_SEGMENTDISTANCE_NEON)
+    return segmentBatch(px, py, x1, y1, x2, y2, count);
+#else
+    return nearestSegmentScalar(px, py, x1, y1, x2, y2, count);
+#endif
+}
+
+Result nearestPoint(double px, double py,
+                    const double* x, const double* y,
+                    size_t count)
+{
+#if defined(LC_SEGMENTDISTANCE_AVX) || defined(LC_SEGMENTDISTANCE_SSE2) || defined(LC_SEGMENTDISTANCE_NEON)
+    return pointBatch(px, py, x, y, count);
+#else
+    return nearestPointScalar(px, py, x, y, count);
+#endif
+}
+
+const char* instructionSet()
+{
+#if defined(LC_SEGMENTDISTANCE_AVX)
+    return "AVX";
+#elif defined(LC_SEGMENTDISTANCE_SSE2)
+    return "SSE2";
+#elif defined(LC_SEGMENTDISTANCE_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_SEGMENTDISTANCE_H
+#define LC_SEGMENTDISTANCE_H
+
+#include <cstddef>
+
+/**
+ * Batch kernels for nearest point and distance queries over segments and
+ * points kept in contiguous coordinate arrays (see LC_BulkGeometry).
+ *
+ * Depending on the instruction set the library is compiled for, several
+ * segments are processed per instruction (AVX: 4, SSE2/NEON: 2 doubles).
+ * The results are identical to the scalar path: the same expressions are
+ * evaluated for every element, and among equal distances the element with
+ * the lowest index wins.
+ */
+namespace LC_SegmentDistance {
+
+/**
+ * Result of a nearest query.
+ */
+struct Result {
+    //! index of the nearest element, equal to the element count if none was found
+    size_t index = 0;
+    //! squared distance to the nearest element
+    double distance2 = 0.;
+};
+
+/**
+ * @brief nearestSegment finds the segment (x1[i], y1[i]) - (x2[i], y2[i])
+ * closest to (px, py). Degenerated segments are measured from their middle.
+ */
+Result nearestSegment(double px, double py,
+                      const double* x1, const double* y1,
+                      const double* x2, const double* y2,
+                      size_t count);
+
+/**
+ * @brief nearestPoint finds the point (x[i], y[i]) closest to (px, py).
+ */
+Result nearestPoint(double px, double py,
+                    const double* x, const double* y,
+                    size_t count);
+
+//! \{ scalar reference implementations
+Result nearestSegmentScalar(double px, double py,
+                            const double* x1, const double* y1,
+                            const double* x2, const double* y2,
+                            size_t count);
+Result nearestPointScalar(double px, double py,
+                          const double* x, const double* y,
+                          size_t count);
+//! \}
+
+/**
+ * @return squared distance from (px, py) to a single segment, evaluated
+ * like in the batch kernels
+ */
+double segmentDistance2(double px, double py,
+                        double x1, double y1, double x2, double y2);
+
+/**
+ * @return name of the instruction set used by the batch kernels
+ */
+const char* instructionSet();
+}
+
+#endif // LC_SEGMENTDISTANCE_H
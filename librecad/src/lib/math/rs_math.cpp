@@ -29,12 +29,12 @@
 #include <boost/math/special_functions/ellint_2.hpp>
 
 #include <cmath>
-#include <muParser.h>
 #include <QString>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 #include <QDebug>
 
+#include "lc_expressioncache.h"
 #include "rs.h"
 #include "rs_math.h"
 #include "rs_vector.h"
@@ -334,43 +334,15 @@ QString RS_Math::derationalize(const QString& expr) {
 /**
  * Evaluates a mathematical expression and returns the result.
  * If an error occurred, ok will be set to false (if ok isn't NULL).
+ * Compiled expressions are reused, see LC_ExpressionCache.
  */
 double RS_Math::eval(const QString& expr, bool* ok) {
     bool okTmp = false;
     if(ok == nullptr)
         ok=&okTmp;
     double ret = 0.;
-    if (expr.isEmpty()) {
-        *ok = false;
-        return ret;
-    }
-
-    QString derationalized = derationalize(expr);
-    //expr = normalizedUnitsExpression(expr);
-
-    try{
-        mu::Parser p;
-#ifdef _UNICODE
-        p.DefineConst(L"pi",M_PI);
-        p.SetExpr(derationalized.toStdWString());
-#else
-        p.DefineConst("pi",M_PI);
-        p.SetExpr(derationalized.toStdString());
-#endif
-        ret=p.Eval();
-        *ok=true;
-    }
-    catch (mu::Parser::exception_type &e)
-    {
-        mu::console() << e.GetMsg() << std::endl;
-        *ok=false;
-    }
-    catch (...)
-    {
-        LC_ERR<<"MuParser error";
-    }
-
-    return ret;
+    *ok = LC_ExpressionCache::instance().evaluate(expr, ret);
+    return *ok ? ret : 0.;
 }
 
 
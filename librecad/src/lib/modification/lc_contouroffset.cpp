@@ -0,0 +1,639 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "lc_contouroffset.h"
+#include "lc_parallel.h"
+#include "rs_arc.h"
+#include "rs_circle.h"
+#include "rs_math.h"
+#include "rs_polyline.h"
+
+namespace {
+
+double crossP(const RS_Vector& v1, const RS_Vector& v2)
+{
+    return v1.x * v2.y - v1.y * v2.x;
+}
+
+/**
+ * A line or an arc. Points along the segment are given by a parameter from
+ * 0 at the start point to 1 at the end point.
+ */
+struct Segment {
+    RS_Vector start;
+    RS_Vector end;
+    //! arcs only
+    RS_Vector center;
+    double radius = 0.;
+    double startAngle = 0.;
+    //! angle length of arcs, positive counterclockwise, 0 for lines
+    double sweep = 0.;
+
+    bool isArc() const {
+        return sweep != 0.;
+    }
+
+    double length() const {
+        return isArc() ? radius * std::abs(sweep) : start.distanceTo(end);
+    }
+
+    RS_Vector pointAt(double t) const {
+        if (isArc())
+            return center + RS_Vector::polar(radius, startAngle + sweep * t);
+        return start + (end - start) * t;
+    }
+
+    /** @return parameter of the nearest point on the line or circle */
+    double parameterOf(const RS_Vector& point) const {
+        if (isArc()) {
+            // angles are measured from the middle of the arc
+            const double half = 0.5 * sweep;
+            return (half + std::remainder(center.angleTo(point) - startAngle - half, 2. * M_PI)) / sweep;
+        }
+        const RS_Vector direction = end - start;
+        const double squared = direction.squared();
+        return squared > 0. ? RS_Vector::dotP(point - start, direction) / squared : 0.;
+    }
+
+    double distanceTo(const RS_Vector& point) const {
+        const double t = parameterOf(point);
+        if (t <= 0.)
+            return start.distanceTo(point);
+        if (t >= 1.)
+            return end.distanceTo(point);
+        if (isArc())
+            return std::abs(center.distanceTo(point) - radius);
+        return pointAt(t).distanceTo(point);
+    }
+};
+
+Segment makeLine(const RS_Vector& start, const RS_Vector& end)
+{
+    Segment segment;
+    segment.start = start;
+    segment.end = end;
+    return segment;
+}
+
+Segment makeArc(const RS_Vector& center, double radius, double startAngle, double sweep)
+{
+    Segment segment;
+    segment.center = center;
+    segment.radius = radius;
+    segment.startAngle = startAngle;
+    segment.sweep = sweep;
+    segment.start = segment.pointAt(0.);
+    segment.end = segment.pointAt(1.);
+    return segment;
+}
+
+/** The segment from start to end with the given polyline bulge */
+Segment makeSegment(const RS_Vector& start, const RS_Vector& end, double bulge)
+{
+    if (std::abs(bulge) < RS_TOLERANCE)
+        return makeLine(start, end);
+
+    Segment segment;
+    segment.start = start;
+    segment.end = end;
+    segment.sweep = 4. * std::atan(bulge);
+    const RS_Vector chord = end - start;
+    segment.radius = 0.5 * chord.magnitude() / std::abs(std::sin(0.5 * segment.sweep));
+    // the center is left of the chord for counterclockwise arcs up to a half circle
+    segment.center = (start + end) * 0.5
+            + RS_Vector{-chord.y, chord.x} * ((1. - bulge * bulge) / (4. * bulge));
+    segment.startAngle = segment.center.angleTo(start);
+    return segment;
+}
+
+double signedArea(const std::vector<Segment>& segments)
+{
+    double area = 0.;
+    for (const Segment& segment: segments) {
+        area += 0.5 * crossP(segment.start, segment.end);
+        if (segment.isArc())
+            area += 0.5 * segment.radius * segment.radius * (segment.sweep - std::sin(segment.sweep));
+    }
+    return area;
+}
+
+/**
+ * Moves a segment by the distance to its left side, to the right for
+ * negative distances. Arcs collapsing beyond their center become lines
+ * between the moved end points.
+ */
+Segment offsetSegment(const Segment& segment, double distance)
+{
+    if (!segment.isArc()) {
+        const RS_Vector direction = (segment.end - segment.start).normalized();
+        const RS_Vector normal = RS_Vector{-direction.y, direction.x} * distance;
+        return makeLine(segment.start + normal, segment.end + normal);
+    }
+    // the left side of counterclockwise arcs is towards the center
+    const double radius = segment.sweep > 0. ? segment.radius - distance : segment.radius + distance;
+    if (radius > RS_TOLERANCE)
+        return makeArc(segment.center, radius, segment.startAngle, segment.sweep);
+    return makeLine(segment.center + RS_Vector::polar(radius, segment.startAngle),
+                    segment.center + RS_Vector::polar(radius, segment.startAngle + segment.sweep));
+}
+
+/**
+ * The arc around a vertex joining the end point of a moved segment to the
+ * start point of the next one, taking the shorter way. Half turns are made
+ * on the offset side.
+ */
+Segment joinSegment(const RS_Vector& vertex, const RS_Vector& from, const RS_Vector& to,
+                    double distance)
+{
+    const double startAngle = vertex.angleTo(from);
+    double sweep = std::remainder(vertex.angleTo(to) - startAngle, 2. * M_PI);
+    if (std::abs(sweep) > M_PI - RS_TOLERANCE)
+        sweep = distance > 0. ? -M_PI : M_PI;
+    Segment segment = makeArc(vertex, std::abs(distance), startAngle, sweep);
+    segment.start = from;
+    segment.end = to;
+    return segment;
+}
+
+struct Box {
+    double minX = 0.;
+    double minY = 0.;
+    double maxX = 0.;
+    double maxY = 0.;
+
+    void extend(const RS_Vector& point) {
+        minX = std::min(minX, point.x);
+        minY = std::min(minY, point.y);
+        maxX = std::max(maxX, point.x);
+        maxY = std::max(maxY, point.y);
+    }
+};
+
+Box boxOf(const Segment& segment, double margin)
+{
+    Box box{segment.start.x, segment.start.y, segment.start.x, segment.start.y};
+    box.extend(segment.end);
+    if (segment.isArc()) {
+        for (int quadrant = 0; quadrant < 4; ++quadrant) {
+            const RS_Vector point = segment.center + RS_Vector::polar(segment.radius, quadrant * M_PI_2);
+            const double t = segment.parameterOf(point);
+            if (t > 0. && t < 1.)
+                box.extend(point);
+        }
+    }
+    box.minX -= margin;
+    box.minY -= margin;
+    box.maxX += margin;
+    box.maxY += margin;
+    return box;
+}
+
+/** A point where two segments meet */
+struct Crossing {
+    double t1 = 0.;
+    double t2 = 0.;
+    RS_Vector point;
+};
+
+/**
+ * Intersections of the lines or circles of two segments, overlapping
+ * segments give the end points of the overlap.
+ */
+std::vector<RS_Vector> candidates(const Segment& first, const Segment& second, double tolerance)
+{
+    if (!first.isArc() && !second.isArc()) {
+        const RS_Vector direction1 = first.end - first.start;
+        const RS_Vector direction2 = second.end - second.start;
+        const RS_Vector offset = second.start - first.start;
+        const double denominator = crossP(direction1, direction2);
+        if (std::abs(denominator) > RS_TOLERANCE * direction1.magnitude() * direction2.magnitude())
+            return {first.start + direction1 * (crossP(offset, direction2) / denominator)};
+        if (std::abs(crossP(offset, direction1)) > tolerance * direction1.magnitude())
+            return {};
+        return {first.start, first.end, second.start, second.end};
+    }
+
+    if (first.isArc() != second.isArc()) {
+        const Segment& line = first.isArc() ? second : first;
+        const Segment& arc = first.isArc() ? first : second;
+        const RS_Vector direction = (line.end - line.start).normalized();
+        const RS_Vector toCenter = arc.center - line.start;
+        const RS_Vector foot = line.start + direction * RS_Vector::dotP(toCenter, direction);
+        const double height = std::abs(crossP(direction, toCenter));
+        if (height > arc.radius + tolerance)
+            return {};
+        if (height > arc.radius - tolerance)
+            return {foot};
+        const double half = std::sqrt(arc.radius * arc.radius - height * height);
+        return {foot - direction * half, foot + direction * half};
+    }
+
+    const RS_Vector offset = second.center - first.center;
+    const double distance = offset.magnitude();
+    if (distance < tolerance) {
+        if (std::abs(first.radius - second.radius) > tolerance)
+            return {};
+        return {first.start, first.end, second.start, second.end};
+    }
+    if (distance > first.radius + second.radius + tolerance
+            || distance < std::abs(first.radius - second.radius) - tolerance)
+        return {};
+    const RS_Vector direction = offset / distance;
+    const double along = 0.5 * (first.radius * first.radius - second.radius * second.radius + distance * distance) / distance;
+    const RS_Vector foot = first.center + direction * along;
+    const double squared = first.radius * first.radius - along * along;
+    if (squared < tolerance * tolerance)
+        return {foot};
+    const RS_Vector normal = RS_Vector{-direction.y, direction.x} * std::sqrt(squared);
+    return {foot - normal, foot + normal};
+}
+
+void intersect(const Segment& first, const Segment& second, double tolerance,
+               std::vector<Crossing>& crossings)
+{
+    const double margin1 = tolerance / first.length();
+    const double margin2 = tolerance / second.length();
+    const size_t begin = crossings.size();
+    for (const RS_Vector& point: candidates(first, second, tolerance)) {
+        const double t1 = first.parameterOf(point);
+        const double t2 = second.parameterOf(point);
+        if (t1 < -margin1 || t1 > 1. + margin1 || t2 < -margin2 || t2 > 1. + margin2)
+            continue;
+        // end points of overlaps are only candidates
+        if (first.pointAt(t1).distanceTo(point) > tolerance
+                || second.pointAt(t2).distanceTo(point) > tolerance)
+            continue;
+        const bool duplicate = std::any_of(crossings.begin() + begin, crossings.end(),
+                                           [&point, tolerance](const Crossing& crossing) {
+            return crossing.point.distanceTo(point) < tolerance;
+        });
+        if (!duplicate)
+            crossings.push_back({std::clamp(t1, 0., 1.), std::clamp(t2, 0., 1.), point});
+    }
+}
+
+/** A point splitting a segment */
+struct Split {
+    double t = 0.;
+    RS_Vector point;
+};
+
+/**
+ * Segments of the original contour by grid cell, to find the segments
+ * near a point. Segments covering many cells are kept apart and always
+ * tested.
+ */
+class SegmentGrid {
+public:
+    explicit SegmentGrid(const std::vector<Segment>& segments)
+        : m_segments{segments}
+    {
+        std::vector<Box> boxes;
+        boxes.reserve(segments.size());
+        Box all = boxOf(segments.front(), 0.);
+        for (const Segment& segment: segments) {
+            boxes.push_back(boxOf(segment, 0.));
+            all.extend({boxes.back().minX, boxes.back().minY});
+            all.extend({boxes.back().maxX, boxes.back().maxY});
+        }
+        m_origin = {all.minX, all.minY};
+        const double area = std::max((all.maxX - all.minX) * (all.maxY - all.minY), RS_TOLERANCE);
+        m_cellSize = std::max(std::sqrt(area / segments.size()), RS_TOLERANCE);
+        m_columns = column(all.maxX) + 1;
+        m_rows = row(all.maxY) + 1;
+        m_cells.resize(m_columns * m_rows);
+        for (size_t i = 0; i < segments.size(); ++i) {
+            const Box& box = boxes[i];
+            const size_t column0 = column(box.minX), column1 = column(box.maxX);
+            const size_t row0 = row(box.minY), row1 = row(box.maxY);
+            if ((column1 - column0 + 1) * (row1 - row0 + 1) > 64) {
+                m_large.push_back(i);
+                continue;
+            }
+            for (size_t r = row0; r <= row1; ++r)
+                for (size_t c = column0; c <= column1; ++c)
+                    m_cells[r * m_columns + c].push_back(i);
+        }
+    }
+
+    /** @return true if any segment is closer to the point than the distance */
+    bool isCloser(const RS_Vector& point, double distance) const {
+        auto closer = [this, &point, distance](size_t i) {
+            return m_segments[i].distanceTo(point) < distance;
+        };
+        if (std::any_of(m_large.begin(), m_large.end(), closer))
+            return true;
+        const size_t column0 = column(point.x - distance), column1 = column(point.x + distance);
+        const size_t row0 = row(point.y - distance), row1 = row(point.y + distance);
+        if ((column1 - column0 + 1) * (row1 - row0 + 1) > m_segments.size()) {
+            for (size_t i = 0; i < m_segments.size(); ++i)
+                if (closer(i))
+                    return true;
+            return false;
+        }
+        for (size_t r = row0; r <= row1; ++r)
+            for (size_t c = column0; c <= column1; ++c)
+                if (std::any_of(m_cells[r * m_columns + c].begin(), m_cells[r * m_columns + c].end(), closer))
+                    return true;
+        return false;
+    }
+
+private:
+    size_t index(double value, double origin, size_t count) const {
+        const double cell = std::floor((value - origin) / m_cellSize);
+        if (!(cell > 0.))
+            return 0;
+        return count > 0 ? std::min(static_cast<size_t>(cell), count - 1) : static_cast<size_t>(cell);
+    }
+    size_t column(double x) const {
+        return index(x, m_origin.x, m_columns);
+    }
+    size_t row(double y) const {
+        return index(y, m_origin.y, m_rows);
+    }
+
+    const std::vector<Segment>& m_segments;
+    RS_Vector m_origin;
+    double m_cellSize = 1.;
+    size_t m_columns = 0;
+    size_t m_rows = 0;
+    std::vector<std::vector<size_t>> m_cells;
+    std::vector<size_t> m_large;
+};
+
+/** A part of a segment of the raw offset contour */
+struct Piece {
+    size_t segment = 0;
+    double t1 = 0.;
+    double t2 = 1.;
+    RS_Vector start;
+    RS_Vector end;
+};
+
+/**
+ * Finds the pieces following each other, in the order they were
+ * created if possible, and returns the closed chains.
+ */
+std::vector<std::vector<size_t>> joinPieces(const std::vector<Piece>& pieces, double tolerance)
+{
+    std::vector<size_t> byStart(pieces.size());
+    for (size_t i = 0; i < pieces.size(); ++i)
+        byStart[i] = i;
+    std::sort(byStart.begin(), byStart.end(), [&pieces](size_t a, size_t b) {
+        return pieces[a].start.x < pieces[b].start.x;
+    });
+
+    std::vector<bool> used(pieces.size(), false);
+    auto successor = [&](size_t current) -> size_t {
+        const RS_Vector& end = pieces[current].end;
+        const size_t next = current + 1;
+        if (next < pieces.size() && !used[next] && pieces[next].start.distanceTo(end) < tolerance)
+            return next;
+        auto it = std::lower_bound(byStart.begin(), byStart.end(), end.x - tolerance,
+                                   [&pieces](size_t i, double x) {
+            return pieces[i].start.x < x;
+        });
+        for (; it != byStart.end() && pieces[*it].start.x <= end.x + tolerance; ++it)
+            if (!used[*it] && pieces[*it].start.distanceTo(end) < tolerance)
+                return *it;
+        return pieces.size();
+    };
+
+    std::vector<std::vector<size_t>> chains;
+    for (size_t first = 0; first < pieces.size(); ++first) {
+        if (used[first])
+            continue;
+        used[first] = true;
+        std::vector<size_t> chain{first};
+        for (;;) {
+            const size_t current = chain.back();
+            if (pieces[first].start.distanceTo(pieces[current].end) < tolerance) {
+                chains.push_back(std::move(chain));
+                break;
+            }
+            const size_t next = successor(current);
+            if (next == pieces.size())
+                break;
+            used[next] = true;
+            chain.push_back(next);
+        }
+    }
+    return chains;
+}
+}
+
+LC_ContourOffset::LC_ContourOffset(double tolerance):
+    m_tolerance{tolerance}
+{
+}
+
+bool LC_ContourOffset::toContour(const RS_Entity* entity, Contour& contour)
+{
+    contour.clear();
+    if (entity == nullptr)
+        return false;
+
+    switch (entity->rtti()) {
+    case RS2::EntityCircle: {
+        const auto* circle = static_cast<const RS_Circle*>(entity);
+        if (circle->getRadius() < RS_TOLERANCE)
+            return false;
+        const RS_Vector radius{circle->getRadius(), 0.};
+        contour.push_back({circle->getCenter() + radius, 1.});
+        contour.push_back({circle->getCenter() - radius, 1.});
+        return true;
+    }
+    case RS2::EntityPolyline: {
+        const auto* polyline = static_cast<const RS_Polyline*>(entity);
+        for (const RS_Entity* e: *polyline) {
+            if (e->rtti() == RS2::EntityLine)
+                contour.push_back({e->getStartpoint(), 0.});
+            else if (e->rtti() == RS2::EntityArc)
+                contour.push_back({e->getStartpoint(), static_cast<const RS_Arc*>(e)->getBulge()});
+            else
+                break;
+        }
+        const bool closed = polyline->isClosed()
+                || polyline->getStartpoint().distanceTo(polyline->getEndpoint()) < RS_TOLERANCE;
+        if (contour.size() != polyline->count() || contour.size() < 2 || !closed) {
+            contour.clear();
+            return false;
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+RS_Polyline* LC_ContourOffset::toPolyline(const Contour& contour, RS_EntityContainer* parent)
+{
+    auto* polyline = new RS_Polyline(parent, RS_PolylineData(RS_Vector{false}, RS_Vector{false}, true));
+    std::vector<std::pair<RS_Vector, double>> vertices;
+    vertices.reserve(contour.size());
+    for (const Vertex& vertex: contour)
+        vertices.emplace_back(vertex.point, vertex.bulge);
+    polyline->appendVertexs(vertices);
+    return polyline;
+}
+
+std::vector<LC_ContourOffset::Contour> LC_ContourOffset::offset(const Contour& contour,
+                                                                 double distance) const
+{
+    std::vector<Segment> original;
+    original.reserve(contour.size());
+    for (size_t i = 0; i < contour.size(); ++i) {
+        const Vertex& vertex = contour[i];
+        const RS_Vector& next = contour[(i + 1) % contour.size()].point;
+        if (vertex.point.distanceTo(next) >= m_tolerance)
+            original.push_back(makeSegment(vertex.point, next, vertex.bulge));
+    }
+    const double area = signedArea(original);
+    if (original.empty() || std::abs(area) < m_tolerance * m_tolerance)
+        return {};
+    if (std::abs(distance) < m_tolerance)
+        return {contour};
+
+    // the outside is on the right of counterclockwise contours
+    const double left = area > 0. ? -distance : distance;
+
+    // moved segments joined by arcs around the original vertices
+    std::vector<Segment> raw;
+    raw.reserve(2 * original.size());
+    std::vector<Segment> moved;
+    moved.reserve(original.size());
+    for (const Segment& segment: original)
+        moved.push_back(offsetSegment(segment, left));
+    for (size_t i = 0; i < moved.size(); ++i) {
+        if (moved[i].length() >= m_tolerance)
+            raw.push_back(moved[i]);
+        const RS_Vector& from = moved[i].end;
+        const RS_Vector& to = moved[(i + 1) % moved.size()].start;
+        if (from.distanceTo(to) >= m_tolerance)
+            raw.push_back(joinSegment(original[i].end, from, to, left));
+    }
+    if (raw.size() < 2)
+        return {};
+
+    // self-intersections, boxes are swept along x
+    std::vector<Box> boxes;
+    boxes.reserve(raw.size());
+    std::vector<size_t> order(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+        boxes.push_back(boxOf(raw[i], m_tolerance));
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&boxes](size_t a, size_t b) {
+        return boxes[a].minX < boxes[b].minX;
+    });
+
+    std::vector<std::vector<Split>> splits(raw.size());
+    std::vector<Crossing> crossings;
+    for (size_t a = 0; a < order.size(); ++a) {
+        const size_t i = order[a];
+        for (size_t b = a + 1; b < order.size() && boxes[order[b]].minX <= boxes[i].maxX; ++b) {
+            const size_t j = order[b];
+            if (boxes[j].minY > boxes[i].maxY || boxes[j].maxY < boxes[i].minY)
+                continue;
+            crossings.clear();
+            intersect(raw[i], raw[j], m_tolerance, crossings);
+            const double margin1 = m_tolerance / raw[i].length();
+            const double margin2 = m_tolerance / raw[j].length();
+            for (const Crossing& crossing: crossings) {
+                // consecutive segments meet at their common end point
+                if ((j + 1) % raw.size() == i && crossing.t1 < margin1 && crossing.t2 > 1. - margin2)
+                    continue;
+                if ((i + 1) % raw.size() == j && crossing.t1 > 1. - margin1 && crossing.t2 < margin2)
+                    continue;
+                splits[i].push_back({crossing.t1, crossing.point});
+                splits[j].push_back({crossing.t2, crossing.point});
+            }
+        }
+    }
+
+    // pieces between the intersections, only those at the full distance
+    // from the original contour remain
+    const SegmentGrid grid{original};
+    const double limit = std::abs(distance) - m_tolerance;
+    std::vector<Piece> pieces;
+    for (size_t i = 0; i < raw.size(); ++i) {
+        std::vector<Split>& split = splits[i];
+        std::sort(split.begin(), split.end(), [](const Split& a, const Split& b) {
+            return a.t < b.t;
+        });
+        split.push_back({1., raw[i].end});
+
+        bool previousKept = false;
+        double t = 0.;
+        RS_Vector start = raw[i].start;
+        for (size_t k = 0; k < split.size(); ++k) {
+            const Split& next = split[k];
+            const bool last = k + 1 == split.size();
+            if (!last && (start.distanceTo(next.point) < m_tolerance
+                          || raw[i].end.distanceTo(next.point) < m_tolerance))
+                continue;
+            const bool kept = !grid.isCloser(raw[i].pointAt(0.5 * (t + next.t)), limit);
+            if (kept && previousKept) {
+                pieces.back().t2 = next.t;
+                pieces.back().end = next.point;
+            } else if (kept) {
+                pieces.push_back({i, t, next.t, start, next.point});
+            }
+            previousKept = kept;
+            t = next.t;
+            start = next.point;
+        }
+    }
+
+    std::vector<Contour> result;
+    for (const std::vector<size_t>& chain: joinPieces(pieces, 10. * m_tolerance)) {
+        Contour offsetContour;
+        offsetContour.reserve(chain.size());
+        double chainLength = 0.;
+        for (size_t index: chain) {
+            const Piece& piece = pieces[index];
+            const Segment& segment = raw[piece.segment];
+            chainLength += segment.length() * (piece.t2 - piece.t1);
+            offsetContour.push_back({piece.start, std::tan(0.25 * segment.sweep * (piece.t2 - piece.t1))});
+        }
+        if (chainLength > 4. * m_tolerance && (chain.size() > 1 || offsetContour.front().bulge != 0.))
+            result.push_back(std::move(offsetContour));
+    }
+    return result;
+}
+
+std::vector<std::vector<LC_ContourOffset::Contour>> LC_ContourOffset::offsetAll(
+        const std::vector<Contour>& contours, double distance) const
+{
+    std::vector<std::vector<Contour>> result(contours.size());
+    LC_Parallel::forEachIndex(contours.size(), [this, &contours, &result, distance](size_t i) {
+        result[i] = offset(contours[i], distance);
+    }, 4);
+    return result;
+}
@@ -0,0 +1,96 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_CONTOUROFFSET_H
+#define LC_CONTOUROFFSET_H
+
+#include <vector>
+
+#include "rs_vector.h"
+
+class RS_Entity;
+class RS_EntityContainer;
+class RS_Polyline;
+
+/**
+ * Offsets closed contours of lines and arcs, e.g. profiles to prepare tool
+ * paths for export with LC_MakerCamSVG.
+ *
+ * A contour is offset in three steps:
+ * 1. every segment is moved by the distance to the offset side, arcs keep
+ *    their center, arcs collapsing to a point are replaced by a line;
+ * 2. consecutive segments are joined by arcs around the original vertices,
+ *    which is the exact offset of a convex corner and forms a small loop at
+ *    a concave corner;
+ * 3. the segments are split at all self-intersections and every piece
+ *    closer to the original contour than the distance is removed, which
+ *    removes the loops of concave corners as well as any part where the
+ *    contour is too narrow for the distance. The remaining pieces are
+ *    joined into closed contours again.
+ *
+ * All intersections are calculated analytically, the results consist of
+ * lines and arcs only. Contours are offset independently and concurrently
+ * by offsetAll(), holes are not taken into account.
+ */
+class LC_ContourOffset {
+public:
+    /** A vertex of a contour, the bulge describes the segment starting at the point */
+    struct Vertex {
+        RS_Vector point;
+        double bulge = 0.;
+    };
+    /** A closed contour, the last vertex connects to the first one */
+    using Contour = std::vector<Vertex>;
+
+    explicit LC_ContourOffset(double tolerance = 1.0e-6);
+
+    /**
+     * Converts a closed polyline of lines and arcs or a circle.
+     * @return false if the entity isn't a closed contour
+     */
+    static bool toContour(const RS_Entity* entity, Contour& contour);
+    /**
+     * Creates a closed polyline without layer and pen.
+     */
+    static RS_Polyline* toPolyline(const Contour& contour, RS_EntityContainer* parent);
+
+    /**
+     * @param distance the offset, positive outwards and negative inwards
+     * @return the offset contours, in the orientation of the original one.
+     * Empty if the contour vanishes.
+     */
+    std::vector<Contour> offset(const Contour& contour, double distance) const;
+    /**
+     * Offsets contours concurrently.
+     * @return the offset contours of contours[i] at result[i]
+     */
+    std::vector<std::vector<Contour>> offsetAll(const std::vector<Contour>& contours,
+                                                double distance) const;
+
+private:
+    double m_tolerance = 1.0e-6;
+};
+
+#endif // LC_CONTOUROFFSET_H
@@ -0,0 +1,497 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+
+#include "lc_geometrycleanup.h"
+#include "rs_arc.h"
+#include "rs_circle.h"
+#include "rs_ellipse.h"
+#include "rs_entitycontainer.h"
+#include "rs_line.h"
+#include "rs_math.h"
+#include "rs_pen.h"
+#include "rs_point.h"
+
+namespace {
+
+void hashCombine(size_t& seed, size_t value)
+{
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+/**
+ * Layer and pen of an entity, entities are only combined with others
+ * having the same attributes.
+ */
+struct Attributes {
+    const RS_Layer* layer = nullptr;
+    RS_Pen pen;
+
+    bool operator == (const Attributes& other) const {
+        return layer == other.layer && pen == other.pen;
+    }
+};
+
+struct AttributesHash {
+    size_t operator () (const Attributes& attributes) const {
+        size_t seed = std::hash<const RS_Layer*>()(attributes.layer);
+        hashCombine(seed, attributes.pen.getColor().rgba());
+        hashCombine(seed, static_cast<size_t>(attributes.pen.getWidth()));
+        hashCombine(seed, static_cast<size_t>(attributes.pen.getLineType()));
+        return seed;
+    }
+};
+
+/**
+ * A cell of the grid of tolerance sized cells used to find matching
+ * geometry. Geometry within the tolerance of another is in the same or in a
+ * neighbouring cell, also when the two are on either side of a cell border.
+ */
+struct CellKey {
+    RS2::EntityType type = RS2::EntityUnknown;
+    size_t attributes = 0;
+    std::int64_t x = 0;
+    std::int64_t y = 0;
+
+    bool operator == (const CellKey& other) const {
+        return type == other.type && attributes == other.attributes
+                && x == other.x && y == other.y;
+    }
+};
+
+struct CellKeyHash {
+    size_t operator () (const CellKey& key) const {
+        size_t seed = static_cast<size_t>(key.type);
+        hashCombine(seed, key.attributes);
+        hashCombine(seed, std::hash<std::int64_t>()(key.x));
+        hashCombine(seed, std::hash<std::int64_t>()(key.y));
+        return seed;
+    }
+};
+
+/**
+ * @return the point locating an entity in the grid, the middle of a line,
+ * the center of an arc, circle or ellipse, the position of a point
+ */
+RS_Vector anchor(const RS_Entity* e)
+{
+    switch (e->rtti()) {
+    case RS2::EntityLine:
+        return (e->getStartpoint() + e->getEndpoint()) * 0.5;
+    case RS2::EntityPoint:
+        return static_cast<const RS_Point*>(e)->getPos();
+    default:
+        return e->getCenter();
+    }
+}
+
+bool isSameAngle(double angle1, double angle2, double tolerance)
+{
+    return std::abs(std::remainder(angle1 - angle2, 2. * M_PI)) <= tolerance;
+}
+
+/**
+ * @return true, if the two entities of the same type are equal within the
+ * tolerance. Lines may run in opposite directions, arcs are compared by
+ * their counterclockwise ranges.
+ */
+bool isDuplicate(const RS_Entity* e1, const RS_Entity* e2, double tolerance)
+{
+    auto isNear = [tolerance](const RS_Vector& v1, const RS_Vector& v2) {
+        return v1.squaredTo(v2) <= tolerance * tolerance;
+    };
+    switch (e1->rtti()) {
+    case RS2::EntityLine:
+        return (isNear(e1->getStartpoint(), e2->getStartpoint()) && isNear(e1->getEndpoint(), e2->getEndpoint()))
+                || (isNear(e1->getStartpoint(), e2->getEndpoint()) && isNear(e1->getEndpoint(), e2->getStartpoint()));
+    case RS2::EntityArc: {
+        const auto arc1 = static_cast<const RS_Arc*>(e1);
+        const auto arc2 = static_cast<const RS_Arc*>(e2);
+        const double radius = arc1->getRadius();
+        // angles as arc lengths, to compare them with the tolerance
+        return isNear(arc1->getCenter(), arc2->getCenter())
+                && std::abs(radius - arc2->getRadius()) <= tolerance
+                && isSameAngle(arc1->isReversed() ? arc1->getAngle2() : arc1->getAngle1(),
+                               arc2->isReversed() ? arc2->getAngle2() : arc2->getAngle1(), tolerance / radius)
+                && std::abs(arc1->getAngleLength() - arc2->getAngleLength()) * radius <= tolerance;
+    }
+    case RS2::EntityCircle:
+        return isNear(e1->getCenter(), e2->getCenter())
+                && std::abs(e1->getRadius() - e2->getRadius()) <= tolerance;
+    case RS2::EntityEllipse: {
+        const auto ellipse1 = static_cast<const RS_Ellipse*>(e1);
+        const auto ellipse2 = static_cast<const RS_Ellipse*>(e2);
+        const double radius = ellipse1->getMajorRadius();
+        return isNear(ellipse1->getCenter(), ellipse2->getCenter())
+                && isNear(ellipse1->getMajorP(), ellipse2->getMajorP())
+                && std::abs(ellipse1->getMinorRadius() - ellipse2->getMinorRadius()) <= tolerance
+                && isSameAngle(ellipse1->isReversed() ? ellipse1->getAngle2() : ellipse1->getAngle1(),
+                               ellipse2->isReversed() ? ellipse2->getAngle2() : ellipse2->getAngle1(),
+                               tolerance / radius)
+                && std::abs(ellipse1->getAngleLength() - ellipse2->getAngleLength()) * radius <= tolerance;
+    }
+    case RS2::EntityPoint:
+        return isNear(static_cast<const RS_Point*>(e1)->getPos(), static_cast<const RS_Point*>(e2)->getPos());
+    default:
+        return false;
+    }
+}
+
+/**
+ * An entity taking part in the cleanup.
+ */
+struct Item {
+    RS_Entity* entity = nullptr;
+    size_t attributes = 0;
+    bool removed = false;
+};
+
+/**
+ * A line in the frame of its direction: the angle of the direction within
+ * [-angleTolerance, pi - angleTolerance), the signed distance from the
+ * center of all lines, and the range along the direction.
+ */
+struct LineFrame {
+    size_t item = 0;
+    double length = 0.;
+    double angle = 0.;
+    double offset = 0.;
+    double start = 0.;
+    double end = 0.;
+};
+
+/**
+ * An arc as a counterclockwise angular range.
+ */
+struct ArcRange {
+    size_t item = 0;
+    double start = 0.;
+    double end = 0.;
+};
+}
+
+LC_GeometryCleanup::LC_GeometryCleanup(double tolerance):
+    m_tolerance(std::max(tolerance, RS_TOLERANCE))
+{}
+
+LC_GeometryCleanup::Result LC_GeometryCleanup::run(const RS_EntityContainer& container,
+                                                   bool selectedOnly) const
+{
+    Result result;
+    const double tolerance = m_tolerance;
+    auto quantize = [tolerance](double value) {
+        constexpr double limit = 9.0e18;
+        return static_cast<std::int64_t>(std::llround(std::clamp(value / tolerance, -limit, limit)));
+    };
+
+    // collect the candidates and their attributes
+    std::vector<Item> items;
+    std::unordered_map<Attributes, size_t, AttributesHash> attributesIndex;
+    for (RS_Entity* e: container) {
+        if (e->isUndone() || !e->isVisible() || e->isLocked() || (selectedOnly && !e->isSelected()))
+            continue;
+        switch (e->rtti()) {
+        case RS2::EntityLine:
+            if (e->getLength() < tolerance)
+                continue;
+            break;
+        case RS2::EntityArc:
+        case RS2::EntityCircle:
+            if (e->getRadius() < tolerance)
+                continue;
+            break;
+        case RS2::EntityEllipse:
+        case RS2::EntityPoint:
+            break;
+        default:
+            continue;
+        }
+        const Attributes attributes{e->getLayer(false), e->getPen(false)};
+        const size_t index = attributesIndex.emplace(attributes, attributesIndex.size()).first->second;
+        items.push_back({e, index, false});
+    }
+
+    // grid cell of an item, for its type and attributes
+    auto cellKey = [&items, &quantize](size_t i) {
+        const RS_Vector position = anchor(items[i].entity);
+        return CellKey{items[i].entity->rtti(), items[i].attributes,
+                       quantize(position.x), quantize(position.y)};
+    };
+    // calls func for the items in the cell of the key and its neighbours
+    auto forNeighbours = [](const auto& cells, const CellKey& key, auto&& func) {
+        for (std::int64_t dx = -1; dx <= 1; ++dx) {
+            for (std::int64_t dy = -1; dy <= 1; ++dy) {
+                const auto it = cells.find({key.type, key.attributes, key.x + dx, key.y + dy});
+                if (it == cells.end())
+                    continue;
+                for (size_t j: it->second)
+                    func(j);
+            }
+        }
+    };
+
+    // exact duplicates: compare with the geometry kept in the neighbouring cells
+    std::unordered_map<CellKey, std::vector<size_t>, CellKeyHash> geometries;
+    geometries.reserve(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        const CellKey key = cellKey(i);
+        bool duplicate = false;
+        forNeighbours(geometries, key, [&](size_t j) {
+            duplicate = duplicate || isDuplicate(items[j].entity, items[i].entity, tolerance);
+        });
+        if (duplicate) {
+            items[i].removed = true;
+            result.removed.push_back(items[i].entity);
+            ++result.duplicates;
+        } else {
+            geometries[key].push_back(i);
+        }
+    }
+
+    // replaces the items of a merged group by a new entity
+    auto replace = [&result, &items](const std::vector<size_t>& group, RS_Entity* entity) {
+        // the attributes of the first one in the drawing
+        const RS_Entity* original = items[*std::min_element(group.begin(), group.end())].entity;
+        entity->setLayer(original->getLayer(false));
+        entity->setPen(original->getPen(false));
+        for (size_t i: group) {
+            items[i].removed = true;
+            result.removed.push_back(items[i].entity);
+        }
+        result.added.push_back(entity);
+        result.merged += group.size() - 1;
+    };
+
+    // overlapping collinear lines: sort by direction, distance from the
+    // center of the lines and start, then sweep along each line
+    RS_Vector minP{RS_MAXDOUBLE, RS_MAXDOUBLE};
+    RS_Vector maxP{RS_MINDOUBLE, RS_MINDOUBLE};
+    for (const Item& item: items) {
+        if (item.removed || item.entity->rtti() != RS2::EntityLine)
+            continue;
+        minP = RS_Vector::minimum(minP, item.entity->getMin());
+        maxP = RS_Vector::maximum(maxP, item.entity->getMax());
+    }
+    // distances from the center stay small, to keep the rounding errors small
+    const RS_Vector center = (minP + maxP) * 0.5;
+    std::vector<LineFrame> lines;
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (items[i].removed || items[i].entity->rtti() != RS2::EntityLine)
+            continue;
+        const RS_Vector p1 = items[i].entity->getStartpoint();
+        const RS_Vector p2 = items[i].entity->getEndpoint();
+        const double length = p1.distanceTo(p2);
+        // the end points of lines differing by this angle deviate less than the tolerance
+        const double angleTolerance = tolerance / length;
+        double angle = (p2 - p1).angle();
+        while (angle >= M_PI - angleTolerance)
+            angle -= M_PI;
+        lines.push_back({i, length, angle, 0., 0., 0.});
+    }
+    std::sort(lines.begin(), lines.end(), [&items](const LineFrame& l1, const LineFrame& l2) {
+        const size_t a1 = items[l1.item].attributes;
+        const size_t a2 = items[l2.item].attributes;
+        return a1 < a2 || (a1 == a2 && l1.angle < l2.angle);
+    });
+
+    auto mergeCollinear = [&](std::vector<LineFrame>::iterator first,
+                              std::vector<LineFrame>::iterator last) {
+        // the line of the first one, the others are projected onto it
+        const RS_Vector direction{first->angle};
+        const RS_Vector normal{-direction.y, direction.x};
+        const RS_Vector origin = center + normal * first->offset;
+        for (auto it = first; it != last; ++it) {
+            const double t1 = (items[it->item].entity->getStartpoint() - origin).dotP(direction);
+            const double t2 = (items[it->item].entity->getEndpoint() - origin).dotP(direction);
+            it->start = std::min(t1, t2);
+            it->end = std::max(t1, t2);
+        }
+        std::sort(first, last, [](const LineFrame& l1, const LineFrame& l2) {
+            return l1.start < l2.start;
+        });
+        std::vector<size_t> group;
+        double start = 0.;
+        double end = 0.;
+        auto flush = [&]() {
+            if (group.size() > 1)
+                replace(group, new RS_Line(nullptr, origin + direction * start, origin + direction * end));
+            group.clear();
+        };
+        for (auto it = first; it != last; ++it) {
+            if (!group.empty() && it->start < end - tolerance) {
+                group.push_back(it->item);
+                end = std::max(end, it->end);
+                continue;
+            }
+            flush();
+            group.push_back(it->item);
+            start = it->start;
+            end = it->end;
+        }
+        flush();
+    };
+
+    for (auto parallel = lines.begin(); parallel != lines.end();) {
+        // lines with the same attributes and direction
+        auto parallelEnd = parallel + 1;
+        while (parallelEnd != lines.end()
+               && items[parallelEnd->item].attributes == items[parallel->item].attributes
+               && parallelEnd->angle - (parallelEnd - 1)->angle
+               <= tolerance / std::min(parallelEnd->length, (parallelEnd - 1)->length))
+            ++parallelEnd;
+        // distances of the line middles in the direction of the first line
+        const RS_Vector direction{parallel->angle};
+        const RS_Vector normal{-direction.y, direction.x};
+        for (auto it = parallel; it != parallelEnd; ++it) {
+            const RS_Entity* line = items[it->item].entity;
+            it->angle = parallel->angle;
+            it->offset = ((line->getStartpoint() + line->getEndpoint()) * 0.5 - center).dotP(normal);
+        }
+        std::sort(parallel, parallelEnd, [](const LineFrame& l1, const LineFrame& l2) {
+            return l1.offset < l2.offset;
+        });
+        // collinear lines among them
+        for (auto collinear = parallel; collinear != parallelEnd;) {
+            auto collinearEnd = collinear + 1;
+            while (collinearEnd != parallelEnd
+                   && collinearEnd->offset - (collinearEnd - 1)->offset <= tolerance)
+                ++collinearEnd;
+            if (collinearEnd - collinear > 1)
+                mergeCollinear(collinear, collinearEnd);
+            collinear = collinearEnd;
+        }
+        parallel = parallelEnd;
+    }
+
+    // overlapping arcs and circles: group by center and radius, then merge
+    // the angular ranges. Arcs and circles share the cells of arcs, the
+    // groups are joined over neighbouring cells.
+    std::unordered_map<CellKey, std::vector<size_t>, CellKeyHash> circleCells;
+    std::vector<size_t> groupOf(items.size());
+    std::iota(groupOf.begin(), groupOf.end(), size_t(0));
+    auto findGroup = [&groupOf](size_t i) {
+        while (groupOf[i] != i)
+            i = groupOf[i] = groupOf[groupOf[i]];
+        return i;
+    };
+    std::vector<size_t> circleItems;
+    for (size_t i = 0; i < items.size(); ++i) {
+        const RS2::EntityType type = items[i].entity->rtti();
+        if (items[i].removed || (type != RS2::EntityArc && type != RS2::EntityCircle))
+            continue;
+        CellKey key = cellKey(i);
+        key.type = RS2::EntityArc;
+        const RS_Entity* e = items[i].entity;
+        forNeighbours(circleCells, key, [&](size_t j) {
+            const RS_Entity* other = items[j].entity;
+            if (e->getCenter().squaredTo(other->getCenter()) <= tolerance * tolerance
+                    && std::abs(e->getRadius() - other->getRadius()) <= tolerance)
+                groupOf[findGroup(i)] = findGroup(j);
+        });
+        circleCells[key].push_back(i);
+        circleItems.push_back(i);
+    }
+    std::unordered_map<size_t, std::vector<size_t>> circles;
+    for (size_t i: circleItems)
+        circles[findGroup(i)].push_back(i);
+    for (auto& circle: circles) {
+        std::vector<size_t>& members = circle.second;
+        if (members.size() < 2)
+            continue;
+        std::sort(members.begin(), members.end());
+        const RS_Entity* first = items[members.front()].entity;
+        const RS_Vector center = first->getCenter();
+        const double radius = first->getRadius();
+
+        // a circle covers all arcs
+        auto circleIt = std::find_if(members.begin(), members.end(), [&items](size_t i) {
+            return items[i].entity->rtti() == RS2::EntityCircle;
+        });
+        if (circleIt != members.end()) {
+            const size_t kept = *circleIt;
+            for (size_t i: members) {
+                if (i != kept) {
+                    items[i].removed = true;
+                    result.removed.push_back(items[i].entity);
+                    ++result.merged;
+                }
+            }
+            continue;
+        }
+
+        const double angleTolerance = tolerance / radius;
+        std::vector<ArcRange> arcs;
+        for (size_t i: members) {
+            const auto arc = static_cast<const RS_Arc*>(items[i].entity);
+            const double start = RS_Math::correctAngle(arc->isReversed() ? arc->getAngle2() : arc->getAngle1());
+            arcs.push_back({i, start, start + arc->getAngleLength()});
+        }
+        std::sort(arcs.begin(), arcs.end(), [](const ArcRange& a1, const ArcRange& a2) {
+            return a1.start < a2.start;
+        });
+
+        // sweep the ranges, a range may reach beyond 2 pi and overlap the first ones
+        std::vector<std::vector<size_t>> groups;
+        std::vector<std::pair<double, double>> ranges;
+        for (const ArcRange& arc: arcs) {
+            if (!ranges.empty() && arc.start < ranges.back().second - angleTolerance) {
+                groups.back().push_back(arc.item);
+                ranges.back().second = std::max(ranges.back().second, arc.end);
+                continue;
+            }
+            groups.push_back({arc.item});
+            ranges.emplace_back(arc.start, arc.end);
+        }
+        while (ranges.size() > 1
+               && ranges.back().second - 2. * M_PI > ranges.front().first + angleTolerance) {
+            ranges.front().second = std::max(ranges.front().second, ranges.back().second - 2. * M_PI);
+            ranges.front().first = ranges.back().first - 2. * M_PI;
+            groups.front().insert(groups.front().end(), groups.back().begin(), groups.back().end());
+            groups.pop_back();
+            ranges.pop_back();
+        }
+
+        for (size_t g = 0; g < groups.size(); ++g) {
+            if (groups[g].size() < 2)
+                continue;
+            const double start = ranges[g].first;
+            const double end = ranges[g].second;
+            if (end - start >= 2. * M_PI - angleTolerance)
+                replace(groups[g], new RS_Circle(nullptr, RS_CircleData(center, radius)));
+            else
+                replace(groups[g], new RS_Arc(nullptr, RS_ArcData(center, radius,
+                                                                  RS_Math::correctAngle(start),
+                                                                  RS_Math::correctAngle(end), false)));
+        }
+    }
+    return result;
+}
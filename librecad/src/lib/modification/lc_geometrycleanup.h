@@ -0,0 +1,80 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_GEOMETRYCLEANUP_H
+#define LC_GEOMETRYCLEANUP_H
+
+#include <cstddef>
+#include <vector>
+
+class RS_Entity;
+class RS_EntityContainer;
+
+/**
+ * Finds duplicate and overlapping geometry, typically stacked lines in
+ * imported CAD or GIS data ("overkill").
+ *
+ * Only the top level lines, arcs, circles, ellipses and points are
+ * considered, and only entities with the same layer and pen are combined.
+ *
+ * Exact duplicates are found through a hashed grid of cells of the size of
+ * the tolerance. An entity is compared with those in its own and the
+ * neighbouring cells, so values on either side of a cell border still match
+ * (lines in either direction, arcs counterclockwise). Lines are then
+ * sorted by direction, distance from the origin and position along the
+ * line, so collinear lines come together and overlapping ones are merged
+ * in one sweep. Arcs and circles are grouped by center and radius within
+ * the tolerance, through the same grid, and their angular ranges are merged
+ * the same way.
+ *
+ * The cleanup doesn't modify the container, it only tells which entities
+ * to remove and which new ones replace them, see
+ * RS_Modification::removeDuplicates().
+ */
+class LC_GeometryCleanup {
+public:
+    struct Result {
+        //! entities to remove, including those which are replaced
+        std::vector<RS_Entity*> removed;
+        //! new entities, without a parent
+        std::vector<RS_Entity*> added;
+        //! number of removed exact duplicates
+        size_t duplicates = 0;
+        //! number of overlapping lines and arcs merged into others
+        size_t merged = 0;
+    };
+
+    explicit LC_GeometryCleanup(double tolerance);
+
+    /**
+     * @param selectedOnly only consider selected entities
+     */
+    Result run(const RS_EntityContainer& container, bool selectedOnly) const;
+
+private:
+    double m_tolerance;
+};
+
+#endif // LC_GEOMETRYCLEANUP_H
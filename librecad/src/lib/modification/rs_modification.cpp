@@ -24,6 +24,8 @@
 **
 **********************************************************************/
 #include<cmath>
+#include <memory>
+#include <unordered_map>
 
 #include <QSet>
 
@@ -45,8 +47,14 @@
 #include "rs_math.h"
 #include "rs_mtext.h"
 #include "rs_polyline.h"
+#include "rs_spline.h"
 #include "rs_text.h"
 #include "rs_units.h"
+#include "lc_bulkgeometry.h"
+#include "lc_containertraverser.h"
+#include "lc_contouroffset.h"
+#include "lc_intersectionfinder.h"
+#include "lc_parallel.h"
 #include "lc_splinepoints.h"
 #include "lc_undosection.h"
 
@@ -86,14 +94,16 @@ RS_Vector getPasteScale(const RS_PasteData& data, RS_Graphic *& source, const RS
  * @brief addNewBlock() - create a new block
  * @param name - name of the new block to create
  * @param graphic - the target graphic
+ * @param notify - notify the block list listeners, false if the caller
+ *                 notifies them once after adding several blocks
  * @return RS_Block - the block created
  */
-RS_Block* addNewBlock(const QString& name, RS_Graphic& graphic)
+RS_Block* addNewBlock(const QString& name, RS_Graphic& graphic, bool notify = true)
 {
     RS_BlockData db = RS_BlockData(name, {0.0, 0.0}, false);
     RS_Block* b = new RS_Block(&graphic, db);
     b->reparent(&graphic);
-    graphic.addBlock(b);
+    graphic.addBlock(b, notify);
     return b;
 }
 
@@ -101,15 +111,15 @@ RS_VectorSolutions findIntersection(const RS_Entity& trimEntity, const RS_Entity
 {
 
     RS_VectorSolutions sol;
-    if (limitEntity.isAtomic()) {
-        // intersection(s) of the two entities:
+    if (limitEntity.isAtomic() || limitEntity.rtti() == RS2::EntitySpline) {
+        // intersection(s) of the two entities, for splines only on the spline:
         return RS_Information::getIntersection(&trimEntity, &limitEntity, false);
     }
     if (limitEntity.isContainer()) {
         auto ec = static_cast<const RS_EntityContainer*>(&limitEntity);
 
-        for (RS_Entity* e=ec->firstEntity(RS2::ResolveAll); e != nullptr;
-             e=ec->nextEntity(RS2::ResolveAll)) {
+        LC_ContainerTraverser traverser{*ec, RS2::ResolveAll};
+        for (RS_Entity* e = traverser.first(); e != nullptr; e = traverser.next()) {
 
             RS_VectorSolutions s2 = RS_Information::getIntersection(&trimEntity,
                                                                     e, false);
@@ -122,6 +132,74 @@ RS_VectorSolutions findIntersection(const RS_Entity& trimEntity, const RS_Entity
     return sol;
 }
 
+/**
+ * Splits a line, arc, circle or ellipse at the given points. Circles and
+ * whole ellipses are opened at the first point.
+ * @return the pieces, empty if the entity isn't split
+ */
+std::vector<RS_AtomicEntity*> splitAtPoints(const RS_AtomicEntity& entity,
+                                            const std::vector<RS_Vector>& points)
+{
+    constexpr double tolerance = 1e-4;
+    std::vector<RS_AtomicEntity*> pieces;
+    if (points.empty())
+        return pieces;
+
+    auto first = points.cbegin();
+    switch (entity.rtti()) {
+    case RS2::EntityLine:
+    case RS2::EntityArc:
+        pieces.push_back(static_cast<RS_AtomicEntity*>(entity.clone()));
+        break;
+    case RS2::EntityCircle: {
+        const double a = entity.getCenter().angleTo(*first++);
+        pieces.push_back(new RS_Arc(entity.getParent(),
+                                    RS_ArcData(entity.getCenter(), entity.getRadius(),
+                                               a, a + 2. * M_PI, false)));
+        break;
+    }
+    case RS2::EntityEllipse: {
+        const auto ellipse = static_cast<const RS_Ellipse*>(&entity);
+        if (ellipse->getAngleLength() < 2. * M_PI - RS_TOLERANCE_ANGLE) {
+            pieces.push_back(static_cast<RS_AtomicEntity*>(entity.clone()));
+            break;
+        }
+        const double a = ellipse->getEllipseAngle(*first++);
+        pieces.push_back(new RS_Ellipse{entity.getParent(),
+                                        RS_EllipseData{ellipse->getCenter(), ellipse->getMajorP(),
+                                                       ellipse->getRatio(), a, a + 2. * M_PI,
+                                                       ellipse->isReversed()}});
+        break;
+    }
+    default:
+        return pieces;
+    }
+    pieces.front()->setPen(entity.getPen(false));
+    pieces.front()->setLayer(entity.getLayer(false));
+
+    for (auto point = first; point != points.cend(); ++point) {
+        for (size_t i = 0; i < pieces.size(); ++i) {
+            RS_AtomicEntity* piece = pieces[i];
+            if (point->distanceTo(piece->getStartpoint()) < tolerance
+                    || point->distanceTo(piece->getEndpoint()) < tolerance
+                    || !piece->isPointOnEntity(*point, tolerance))
+                continue;
+            auto second = static_cast<RS_AtomicEntity*>(piece->clone());
+            piece->trimEndpoint(*point);
+            second->trimStartpoint(*point);
+            pieces.insert(pieces.begin() + i + 1, second);
+            break;
+        }
+    }
+
+    // a circle opened at its only point isn't split
+    if (pieces.size() == 1) {
+        delete pieces.front();
+        pieces.clear();
+    }
+    return pieces;
+}
+
 RS_Arc* trimCircle(RS_Circle* circle, const RS_Vector& trimCoord, const RS_VectorSolutions& sol)
 {
     double aStart=0.;
@@ -171,6 +249,26 @@ std::string getIdFlagString(RS_Entity* entity)
     return std::to_string(entity->getId()) + "/" + std::to_string(entity->rtti());
 }
 
+/**
+ * @brief isParallelTransformSafe whether the entity can be cloned and
+ * transformed on a worker thread. These entity types only modify their own
+ * geometry, while others may update from blocks, fonts or files.
+ */
+bool isParallelTransformSafe(const RS_Entity& entity)
+{
+    switch (entity.rtti()) {
+    case RS2::EntityLine:
+    case RS2::EntityArc:
+    case RS2::EntityCircle:
+    case RS2::EntityEllipse:
+    case RS2::EntityPoint:
+    case RS2::EntityPolyline:
+        return true;
+    default:
+        return false;
+    }
+}
+
 // Support fillet trimming for whole ellipses
 RS_AtomicEntity* trimEllipseForRound(RS_AtomicEntity* entity, const RS_Arc& arcFillet)
 {
@@ -267,10 +365,10 @@ void RS_Modification::remove()
 
     LC_UndoSection undo(document);
     bool invalidContainer {true};
-	// not safe (?)
-    for (auto* e : *container)
+    for (auto* e : container->getSelectedEntities())
     {
-        if (e != nullptr && e->isSelected())
+        // may have been deselected while removing a previous one
+        if (e->isSelected())
         {
             found = true;
 
@@ -339,13 +437,11 @@ void RS_Modification::revertDirection() {
 
 	std::vector<RS_Entity*> addList;
     bool invalidContainer {true};
-    for(auto e: *container) {
-		if (e && e->isSelected()) {
-			RS_Entity* ec = e->clone();
-			ec->revertDirection();
-			addList.push_back(ec);
-            invalidContainer = false;
-        }
+    for(auto e: container->getSelectedEntities()) {
+        RS_Entity* ec = e->clone();
+        ec->revertDirection();
+        addList.push_back(ec);
+        invalidContainer = false;
 	}
     if (invalidContainer) {
         RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Modification::revertDirection: no valid container is selected");
@@ -380,9 +476,7 @@ bool RS_Modification::changeAttributes(
     QList<RS_Entity*> clones;
     QSet<RS_Block*> blocks;
 
-    for (auto en: *cont) {
-        if (!en) continue;
-        if (!en->isSelected()) continue;
+    for (auto en: cont->getSelectedEntities()) {
 
         if (data.applyBlockDeep && en->rtti() == RS2::EntityInsert) {
             RS_Block* bl = static_cast<RS_Insert*>(en)->getBlockForInsert();
@@ -483,13 +577,9 @@ void RS_Modification::copy(const RS_Vector& ref, const bool cut) {
 
     bool invalidContainer {true};
 	// copy entities / layers / blocks
-	for(auto e: *container){
-        //for (unsigned i=0; i<container->count(); ++i) {
-        //RS_Entity* e = container->entityAt(i);
-        if (e && e->isSelected()) {
-            copyEntity(e, ref, cut);
-            invalidContainer = false;
-        }
+	for(auto e: container->getSelectedEntities()){
+        copyEntity(e, ref, cut);
+        invalidContainer = false;
     }
     if (invalidContainer) {
         RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Modification::copy: no valid container is selected");
@@ -543,6 +633,10 @@ void RS_Modification::copyEntity(RS_Entity* e, const RS_Vector& ref, const bool
     RS_CLIPBOARD->addEntity(c);
     copyLayers(e);
     copyBlocks(e);
+    if (c->rtti() == RS2::EntityBulkGeometry) {
+        // refer to the layer clones of the clipboard
+        static_cast<LC_BulkGeometry*>(c)->remapLayers(*RS_CLIPBOARD->getGraphic());
+    }
 
     // set layer to the layer clone:
     c->setLayer(e->getLayer()->getName());
@@ -612,6 +706,13 @@ void RS_Modification::copyLayers(RS_Entity* e) {
             //RS_Entity* e2 = b->entityAt(i);
             copyLayers(e2);
         }
+    } else if (e->rtti()==RS2::EntityBulkGeometry) {
+        // bulk containers: add layers of the elements
+        for (RS_Layer* l2: static_cast<LC_BulkGeometry*>(e)->getLayerTable()) {
+            if (l2 && !RS_CLIPBOARD->hasLayer(l2->getName())) {
+                RS_CLIPBOARD->addLayer(l2->clone());
+            }
+        }
     } else {
         RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::copyLayers: skip noninsert entity");
     }
@@ -710,6 +811,15 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::paste: selected layer: %s", layer->getName().toLatin1().data());
     graphic->activateLayer(layer);
 
+    // paste the entities directly unless pasting as a new block by demand
+    if (!data.asInsert) {
+        pasteEntities(source, ip, vfactor);
+        m_pasteLayers.clear();
+        graphic->addBlockNotification();
+        RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::paste: OK");
+        return;
+    }
+
     // hash for renaming duplicated blocks
     QHash<QString, QString> blocksDict;
 
@@ -722,7 +832,7 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
     blocksDict[name_old] = name_new;
 
     // create block
-    RS_Block* b = addNewBlock(name_new, *graphic);
+    RS_Block* b = addNewBlock(name_new, *graphic, false);
 
     // create insert object for the paste block
     RS_InsertData di = RS_InsertData(b->getName(), ip, vfactor, 0., 1, 1, RS_Vector(0.0,0.0));
@@ -745,6 +855,7 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
         if (e->rtti() == RS2::EntityInsert) {
             if (!pasteContainer(e, b, blocksDict, RS_Vector(0.0, 0.0))) {
                 RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::paste: unable to paste due to subcontainer paste error");
+                m_pasteLayers.clear();
                 return;
             }
             // clear selection due to the following processing of selected entities
@@ -753,6 +864,7 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
             // paste individual entities including Polylines, etc.
             if (!pasteEntity(e, b)) {
                 RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::paste: unable to paste due to entity paste error");
+                m_pasteLayers.clear();
                 return;
             }
             // clear selection due to the following processing of selected entities
@@ -760,24 +872,15 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
         }
     }
 
+    m_pasteLayers.clear();
+    graphic->addBlockNotification();
+
     // update insert
     i->update();
     i->setSelected(false);
 
-    // unblock all entities if not pasting as a new block by demand
     LC_UndoSection undo(document, handleUndo);
-    if (!data.asInsert) {
-        // no inserts should be selected except from paste block and insert
-        container->setSelected(false);
-        i->setSelected(true);
-        explode(false);
-        document->removeEntity(i);
-        b->clear();
-        // if this call a destructor for the block?
-        graphic->removeBlock(b);
-    } else {
-        undo.addUndoable(i);
-    }
+    undo.addUndoable(i);
 
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::paste: OK");
@@ -786,7 +889,9 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
 
 
 /**
- * Create layers in destination graphic corresponding to entity to be copied
+ * Create layers in destination graphic corresponding to entity to be copied.
+ * The layers of the source are mapped to those of the graphic, so the pasted
+ * entities look up their layers by pasteLayer() instead of by name.
  *
  **/
 bool RS_Modification::pasteLayers(RS_Graphic* source) {
@@ -798,6 +903,7 @@ bool RS_Modification::pasteLayers(RS_Graphic* source) {
         return false;
     }
 
+    m_pasteLayers.clear();
     RS_LayerList* lrs=source->getLayerList();
     for(RS_Layer* l: *lrs) {
 
@@ -808,10 +914,15 @@ bool RS_Modification::pasteLayers(RS_Graphic* source) {
 
         // add layers if absent
         QString ln = l->getName();
-        if (!graphic->findLayer(ln)) {
+        RS_Layer* layer = graphic->findLayer(ln);
+        if (!layer) {
             graphic->addLayer(l->clone());
+            layer = graphic->findLayer(ln);
             RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers: layer added: %s", ln.toLatin1().data());
         }
+        if (layer) {
+            m_pasteLayers.insert(l, layer);
+        }
     }
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteLayers: OK");
@@ -824,7 +935,7 @@ bool RS_Modification::pasteLayers(RS_Graphic* source) {
  * Create inserts and blocks in destination graphic corresponding to entity to be copied
  *
  **/
-bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* container, QHash<QString, QString>blocksDict, RS_Vector insertionPoint) {
+bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* container, QHash<QString, QString>& blocksDict, RS_Vector insertionPoint) {
 
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert");
 
@@ -855,7 +966,7 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
     }
     blocksDict[name_old] = name_new;
     // make new block in the destination
-    RS_Block* blockClone = addNewBlock(name_new, *graphic);
+    RS_Block* blockClone = addNewBlock(name_new, *graphic, false);
     // create insert for the new block
     RS_InsertData di = RS_InsertData(name_new, insertionPoint, RS_Vector(1.0, 1.0), 0.0, 1, 1, RS_Vector(0.0,0.0));
     RS_Insert* insertClone = new RS_Insert(container, di);
@@ -863,8 +974,7 @@ bool RS_Modification::pasteContainer(RS_Entity* entity, RS_EntityContainer* cont
     container->addEntity(insertClone);
 
     // set the same layer in clone as in source
-    QString ln = entity->getLayer()->getName();
-    RS_Layer* layer = graphic->getLayerList()->find(ln);
+    RS_Layer* layer = pasteLayer(entity->getLayer());
     if (!layer) {
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to select layer to paste in");
         return false;
@@ -929,8 +1039,7 @@ bool RS_Modification::pasteEntity(RS_Entity* entity, RS_EntityContainer* contain
     RS_Entity* e = entity->clone();
 
     // set the same layer in clone as in source
-    QString ln = entity->getLayer()->getName();
-    RS_Layer* layer = graphic->getLayerList()->find(ln);
+    RS_Layer* layer = pasteLayer(entity->getLayer());
     if (!layer) {
         RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteInsert: unable to select layer to paste in");
         return false;
@@ -938,6 +1047,9 @@ bool RS_Modification::pasteEntity(RS_Entity* entity, RS_EntityContainer* contain
     RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteInsert: selected layer: %s", layer->getName().toLatin1().data());
     e->setLayer(layer);
     e->setPen(entity->getPen(false));
+    if (e->rtti() == RS2::EntityBulkGeometry) {
+        static_cast<LC_BulkGeometry*>(e)->remapLayers(*graphic);
+    }
 
     // scaling entity doesn't needed as it scaled with insert object
     // paste entity
@@ -951,6 +1063,116 @@ bool RS_Modification::pasteEntity(RS_Entity* entity, RS_EntityContainer* contain
 
 
 
+/**
+ * @return the layer of the graphic to paste an entity of the given source
+ * layer in, nullptr if there is none
+ */
+RS_Layer* RS_Modification::pasteLayer(const RS_Layer* sourceLayer) const {
+    if (sourceLayer == nullptr) {
+        return nullptr;
+    }
+    RS_Layer* layer = m_pasteLayers.value(sourceLayer, nullptr);
+    return (layer != nullptr) ? layer : graphic->findLayer(sourceLayer->getName());
+}
+
+
+
+/**
+ * Pastes the entities of the source as individual entities into the
+ * container. The result is the same as pasting into a block, inserting it
+ * and exploding the insert, but every entity is cloned only once: the layer
+ * "0" and the attributes "by block" are resolved as by the insert and the
+ * clone is moved and scaled in place.
+ * Inserts of the source are pasted with new blocks by pasteContainer().
+ *
+ * @param insertionPoint the position of the origin of the source
+ * @param factor the paste scale factor
+ */
+bool RS_Modification::pasteEntities(RS_Graphic* source, const RS_Vector& insertionPoint, const RS_Vector& factor) {
+
+    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteEntities");
+
+    // the insert of the paste block, only to resolve the layer and pen
+    RS_Insert pasteInsert{document, RS_InsertData(QString{}, insertionPoint, factor, 0., 1, 1, RS_Vector(0.0, 0.0),
+                                                  nullptr, RS2::NoUpdate)};
+    pasteInsert.setLayerToActive();
+    pasteInsert.setPenToActive();
+
+    // pasted inserts are created in here, the container doesn't own them
+    RS_EntityContainer inserts{document, false};
+    QHash<QString, QString> blocksDict;
+    std::vector<RS_Entity*> addList;
+    bool success = true;
+    for(auto e: *source) {
+
+        if (!e) {
+            RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Modification::pasteEntities: nullptr entity in source");
+            continue;
+        }
+
+        RS_Entity* ne = nullptr;
+        if (e->rtti() == RS2::EntityInsert) {
+            const unsigned pasted = inserts.count();
+            if (!pasteContainer(e, &inserts, blocksDict, RS_Vector(0.0, 0.0))) {
+                RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteEntities: unable to paste due to subcontainer paste error");
+                if (inserts.count() > pasted) {
+                    addList.push_back(inserts.last());
+                }
+                success = false;
+                break;
+            }
+            ne = inserts.last();
+        } else {
+            RS_Layer* layer = pasteLayer(e->getLayer());
+            if (!layer) {
+                RS_DEBUG->print(RS_Debug::D_ERROR, "RS_Modification::pasteEntities: unable to select layer to paste in");
+                success = false;
+                break;
+            }
+            ne = e->clone();
+            ne->setLayer(layer);
+            ne->setPen(e->getPen(false));
+            if (ne->rtti() == RS2::EntityBulkGeometry) {
+                static_cast<LC_BulkGeometry*>(ne)->remapLayers(*graphic);
+            }
+        }
+        // clear selection due to the following processing of selected entities
+        e->setSelected(false);
+        addList.push_back(ne);
+
+        // as updated by the insert of the paste block
+        if (ne->getLayer() != nullptr && ne->getLayer()->getName() == "0") {
+            ne->setLayer(pasteInsert.getLayer());
+        }
+        ne->setPen(pasteInsert.resolveBlockPen(ne->getPen(false)));
+        ne->reparent(container);
+        ne->setUpdateEnabled(false);
+        ne->move(insertionPoint);
+        ne->scale(insertionPoint, factor);
+        ne->setUpdateEnabled(true);
+        ne->update();
+        ne->setSelected(false);
+    }
+    inserts.clear();
+
+    if (!success) {
+        for (RS_Entity* e: addList) {
+            delete e;
+        }
+        return false;
+    }
+
+    LC_UndoSection undo(document, handleUndo);
+    // no entities should be selected except from the pasted ones
+    container->setSelected(false);
+    addNewEntities(addList);
+
+    RS_DEBUG->print(RS_Debug::D_DEBUGGING, "RS_Modification::pasteEntities: OK");
+    return true;
+}
+
+
+
 /**
  * Splits a polyline into two leaving out a gap.
  *
@@ -1914,32 +2136,13 @@ bool RS_Modification::move(RS_MoveData& data) {
 	std::vector<RS_Entity*> addList;
 
     // Create new entities
-    for (int num=1;
-            num<=data.number || (data.number==0 && num<=1);
-            num++) {
-        // too slow:
-        //for (unsigned i=0; i<container->count(); ++i) {
-		//RS_Entity* e = container->entityAt(i);
-		for(auto e: *container){
-			if (e && e->isSelected()) {
-                RS_Entity* ec = e->clone();
-
-                ec->move(data.offset*num);
-                if (data.useCurrentLayer) {
-                    ec->setLayerToActive();
-                }
-                if (data.useCurrentAttributes) {
-                    ec->setPenToActive();
-                }
-                if (ec->rtti()==RS2::EntityInsert) {
-                    ((RS_Insert*)ec)->update();
-                }
-                // since 2.0.4.0: keep selection
-                ec->setSelected(true);
-				addList.push_back(ec);
-            }
-        }
-    }
+    // since 2.0.4.0: keep selection
+    cloneTransformed(getSelectedEntities(), std::max(data.number, 1),
+                     data.useCurrentLayer, data.useCurrentAttributes, true,
+                     [&data](RS_Entity* ec, int num) {
+                         ec->move(data.offset*num);
+                     },
+                     addList);
 
     LC_UndoSection undo( document, handleUndo); // bundle remove/add entities in one undoCycle
     deselectOriginals(data.number==0);
@@ -1962,35 +2165,33 @@ bool RS_Modification::offset(const RS_OffsetData& data) {
     }
 
 	std::vector<RS_Entity*> addList;
+    const std::vector<RS_Entity*> selected = getSelectedEntities();
 
     // Create new entities
     for (int num=1;
             num<=data.number || (data.number==0 && num<=1);
             num++) {
-        // too slow:
-		for(auto e: *container){
-			if (e && e->isSelected()) {
-                RS_Entity* ec = e->clone();
-				//highlight is used by trim actions. do not carry over flag
-				ec->setHighlighted(false);
+		for(auto e: selected){
+            RS_Entity* ec = e->clone();
+            //highlight is used by trim actions. do not carry over flag
+            ec->setHighlighted(false);
 
-				if (!ec->offset(data.coord, num*data.distance)) {
-                    delete ec;
-                    continue;
-                }
-                if (data.useCurrentLayer) {
-                    ec->setLayerToActive();
-                }
-                if (data.useCurrentAttributes) {
-                    ec->setPenToActive();
-                }
-                if (ec->rtti()==RS2::EntityInsert) {
-					static_cast<RS_Insert*>(ec)->update();
-                }
-                // since 2.0.4.0: keep selection
-                ec->setSelected(true);
-				addList.push_back(ec);
+            if (!ec->offset(data.coord, num*data.distance)) {
+                delete ec;
+                continue;
+            }
+            if (data.useCurrentLayer) {
+                ec->setLayerToActive();
+            }
+            if (data.useCurrentAttributes) {
+                ec->setPenToActive();
             }
+            if (ec->rtti()==RS2::EntityInsert) {
+                static_cast<RS_Insert*>(ec)->update();
+            }
+            // since 2.0.4.0: keep selection
+            ec->setSelected(true);
+            addList.push_back(ec);
         }
     }
 
@@ -2017,31 +2218,12 @@ bool RS_Modification::rotate(RS_RotateData& data) {
 	std::vector<RS_Entity*> addList;
 
     // Create new entities
-    for (int num=1;
-            num<=data.number || (data.number==0 && num<=1);
-			num++) {
-		for(auto e: *container){
-            //for (unsigned i=0; i<container->count(); ++i) {
-            //RS_Entity* e = container->entityAt(i);
-
-            if (e && e->isSelected()) {
-                RS_Entity* ec = e->clone();
-                ec->setSelected(false);
-
-                ec->rotate(data.center, data.angle*num);
-                if (data.useCurrentLayer) {
-                    ec->setLayerToActive();
-                }
-                if (data.useCurrentAttributes) {
-                    ec->setPenToActive();
-                }
-                if (ec->rtti()==RS2::EntityInsert) {
-                    ((RS_Insert*)ec)->update();
-                }
-				addList.push_back(ec);
-            }
-        }
-    }
+    cloneTransformed(getSelectedEntities(), std::max(data.number, 1),
+                     data.useCurrentLayer, data.useCurrentAttributes, false,
+                     [&data](RS_Entity* ec, int num) {
+                         ec->rotate(data.center, data.angle*num);
+                     },
+                     addList);
 
     LC_UndoSection undo( document, handleUndo); // bundle remove/add entities in one undoCycle
     deselectOriginals(data.number==0);
@@ -2064,9 +2246,10 @@ bool RS_Modification::scale(RS_ScaleData& data) {
     }
 
 	std::vector<RS_Entity*> selectedList,addList;
+    // temporary ellipses replacing circles and arcs, only used as clone sources
+    std::vector<std::unique_ptr<RS_Entity>> replacements;
 
-	for(auto ec: *container){
-        if (ec->isSelected() ) {
+	for(RS_Entity* ec: getSelectedEntities()){
             if ( !data.isotropicScaling ) {
                     if ( ec->rtti() == RS2::EntityCircle ) {
     //non-isotropic scaling, replacing selected circles with ellipses
@@ -2075,6 +2258,7 @@ bool RS_Modification::scale(RS_ScaleData& data) {
 				{c->getCenter(), {c->getRadius(),0.},
 						1.,
 						0., 0., false}};
+                replacements.emplace_back(ec);
             } else if ( ec->rtti() == RS2::EntityArc ) {
     //non-isotropic scaling, replacing selected arcs with ellipses
 				RS_Arc *c=static_cast<RS_Arc*>(ec);
@@ -2085,42 +2269,19 @@ bool RS_Modification::scale(RS_ScaleData& data) {
 								   c->getAngle1(),
 								   c->getAngle2(),
 								   c->isReversed()}};
+                replacements.emplace_back(ec);
             }
             }
 			selectedList.push_back(ec);
-
-        }
     }
 
     // Create new entities
-    for (int num=1;
-            num<=data.number || (data.number==0 && num<=1);
-            num++) {
-
-		for(RS_Entity* e: selectedList) {
-            //for (RS_Entity* e=container->firstEntity();
-            //        e;
-            //        e=container->nextEntity()) {
-            //for (unsigned i=0; i<container->count(); ++i) {
-            //RS_Entity* e = container->entityAt(i);
-			if (e) {
-                RS_Entity* ec = e->clone();
-                ec->setSelected(false);
-
-                ec->scale(data.referencePoint, RS_Math::pow(data.factor, num));
-                if (data.useCurrentLayer) {
-                    ec->setLayerToActive();
-                }
-                if (data.useCurrentAttributes) {
-                    ec->setPenToActive();
-                }
-                if (ec->rtti()==RS2::EntityInsert) {
-                    ((RS_Insert*)ec)->update();
-                }
-				addList.push_back(ec);
-            }
-        }
-    }
+    cloneTransformed(selectedList, std::max(data.number, 1),
+                     data.useCurrentLayer, data.useCurrentAttributes, false,
+                     [&data](RS_Entity* ec, int num) {
+                         ec->scale(data.referencePoint, RS_Math::pow(data.factor, num));
+                     },
+                     addList);
 
     LC_UndoSection undo( document, handleUndo); // bundle remove/add entities in one undoCycle
     deselectOriginals(data.number==0);
@@ -2145,31 +2306,12 @@ bool RS_Modification::mirror(RS_MirrorData& data) {
 	std::vector<RS_Entity*> addList;
 
     // Create new entities
-    for (int num=1;
-            num<=(int)data.copy || (data.copy==false && num<=1);
-			++num) {
-		for(auto e: *container){
-            //for (unsigned i=0; i<container->count(); ++i) {
-            //RS_Entity* e = container->entityAt(i);
-
-            if (e && e->isSelected()) {
-                RS_Entity* ec = e->clone();
-                ec->setSelected(false);
-
-                ec->mirror(data.axisPoint1, data.axisPoint2);
-                if (data.useCurrentLayer) {
-                    ec->setLayerToActive();
-                }
-                if (data.useCurrentAttributes) {
-                    ec->setPenToActive();
-                }
-                if (ec->rtti()==RS2::EntityInsert) {
-                    ((RS_Insert*)ec)->update();
-                }
-				addList.push_back(ec);
-            }
-        }
-    }
+    cloneTransformed(getSelectedEntities(), 1,
+                     data.useCurrentLayer, data.useCurrentAttributes, false,
+                     [&data](RS_Entity* ec, int /*num*/) {
+                         ec->mirror(data.axisPoint1, data.axisPoint2);
+                     },
+                     addList);
 
     LC_UndoSection undo( document, handleUndo); // bundle remove/add entities in one undoCycle
     deselectOriginals(data.copy==false);
@@ -2193,36 +2335,16 @@ bool RS_Modification::rotate2(RS_Rotate2Data& data) {
 	std::vector<RS_Entity*> addList;
 
     // Create new entities
-    for (int num=1;
-            num<=data.number || (data.number==0 && num<=1);
-            num++) {
-
-		for(auto e: *container){
-            //for (unsigned i=0; i<container->count(); ++i) {
-            //RS_Entity* e = container->entityAt(i);
-
-            if (e && e->isSelected()) {
-                RS_Entity* ec = e->clone();
-                ec->setSelected(false);
-
-                ec->rotate(data.center1, data.angle1*num);
-                RS_Vector center2 = data.center2;
-                center2.rotate(data.center1, data.angle1*num);
+    cloneTransformed(getSelectedEntities(), std::max(data.number, 1),
+                     data.useCurrentLayer, data.useCurrentAttributes, false,
+                     [&data](RS_Entity* ec, int num) {
+                         ec->rotate(data.center1, data.angle1*num);
+                         RS_Vector center2 = data.center2;
+                         center2.rotate(data.center1, data.angle1*num);
 
-                ec->rotate(center2, data.angle2*num);
-                if (data.useCurrentLayer) {
-                    ec->setLayerToActive();
-                }
-                if (data.useCurrentAttributes) {
-                    ec->setPenToActive();
-                }
-                if (ec->rtti()==RS2::EntityInsert) {
-                    ((RS_Insert*)ec)->update();
-                }
-				addList.push_back(ec);
-            }
-        }
-    }
+                         ec->rotate(center2, data.angle2*num);
+                     },
+                     addList);
 
     LC_UndoSection undo( document, handleUndo); // bundle remove/add entities in one undoCycle
     deselectOriginals(data.number==0);
@@ -2246,33 +2368,14 @@ bool RS_Modification::moveRotate(RS_MoveRotateData& data) {
 	std::vector<RS_Entity*> addList;
 
     // Create new entities
-    for (int num=1;
-            num<=data.number || (data.number==0 && num<=1);
-			++num) {
-		for(auto e: *container){
-            //for (unsigned i=0; i<container->count(); ++i) {
-            //RS_Entity* e = container->entityAt(i);
-
-            if (e && e->isSelected()) {
-                RS_Entity* ec = e->clone();
-                ec->setSelected(false);
-
-                ec->move(data.offset*num);
-                ec->rotate(data.referencePoint + data.offset*num,
-                           data.angle*num);
-                if (data.useCurrentLayer) {
-                    ec->setLayerToActive();
-                }
-                if (data.useCurrentAttributes) {
-                    ec->setPenToActive();
-                }
-                if (ec->rtti()==RS2::EntityInsert) {
-                    ((RS_Insert*)ec)->update();
-                }
-				addList.push_back(ec);
-            }
-        }
-    }
+    cloneTransformed(getSelectedEntities(), std::max(data.number, 1),
+                     data.useCurrentLayer, data.useCurrentAttributes, false,
+                     [&data](RS_Entity* ec, int num) {
+                         ec->move(data.offset*num);
+                         ec->rotate(data.referencePoint + data.offset*num,
+                                    data.angle*num);
+                     },
+                     addList);
 
     LC_UndoSection undo( document, handleUndo); // bundle remove/add entities in one undoCycle
     deselectOriginals(data.number==0);
@@ -2283,6 +2386,78 @@ bool RS_Modification::moveRotate(RS_MoveRotateData& data) {
 
 
 
+/**
+ * @return the selected top level entities of the container
+ */
+std::vector<RS_Entity*> RS_Modification::getSelectedEntities() const
+{
+    return container->getSelectedEntities();
+}
+
+
+
+/**
+ * Clones the given entities for each copy number 1..copies, and applies the
+ * transformation to each clone.
+ *
+ * Clones of plain geometry are created and transformed in parallel chunks.
+ * Entities which depend on document state during their update, like inserts
+ * or texts, are handled afterwards on the calling thread.
+ * The clones are appended to addList ordered by copy number, then by the
+ * order of the originals.
+ *
+ * @param originals entities to clone
+ * @param copies number of copies, at least 1
+ * @param useCurrentLayer move the clones to the active layer
+ * @param useCurrentAttributes set the active pen to the clones
+ * @param keepSelection whether the clones are selected
+ * @param transform transformation applied to a clone for a copy number
+ * @param addList the clones are appended to this list
+ */
+void RS_Modification::cloneTransformed(const std::vector<RS_Entity*>& originals, int copies,
+                                       bool useCurrentLayer, bool useCurrentAttributes,
+                                       bool keepSelection,
+                                       const std::function<void(RS_Entity*, int)>& transform,
+                                       std::vector<RS_Entity*>& addList) const
+{
+    const size_t count = originals.size();
+    const size_t total = count * static_cast<size_t>(std::max(copies, 1));
+    if (total == 0)
+        return;
+    const size_t first = addList.size();
+    addList.resize(first + total, nullptr);
+
+    auto cloneOne = [&](size_t index) {
+        RS_Entity* ec = originals[index % count]->clone();
+        transform(ec, static_cast<int>(index / count) + 1);
+        if (useCurrentLayer) {
+            ec->setLayerToActive();
+        }
+        if (useCurrentAttributes) {
+            ec->setPenToActive();
+        }
+        ec->setSelected(keepSelection);
+        addList[first + index] = ec;
+    };
+
+    LC_Parallel::forEachIndex(total, [&](size_t index) {
+        if (isParallelTransformSafe(*originals[index % count]))
+            cloneOne(index);
+    });
+
+    for (size_t index = 0; index < total; ++index) {
+        if (isParallelTransformSafe(*originals[index % count]))
+            continue;
+        cloneOne(index);
+        RS_Entity* ec = addList[first + index];
+        if (ec->rtti()==RS2::EntityInsert) {
+            static_cast<RS_Insert*>(ec)->update();
+        }
+    }
+}
+
+
+
 /**
  * Deselects all selected entities and removes them if remove is true;
  *
@@ -2292,7 +2467,7 @@ void RS_Modification::deselectOriginals(bool remove)
 {
     LC_UndoSection undo( document, handleUndo);
 
-    for (auto e: *container) {
+    for (auto e: getSelectedEntities()) {
 
         //for (unsigned i=0; i<container->count(); ++i) {
         //RS_Entity* e = container->entityAt(i);
@@ -2711,6 +2886,160 @@ bool RS_Modification::cut(const RS_Vector& cutCoord,
 
 
 
+/**
+ * Breaks the selected lines, arcs, circles and ellipses at their
+ * intersections with each other and with the other selected entities.
+ * Polylines, splines and inserts are not broken, but break the others.
+ *
+ * @return true if at least one entity was broken
+ */
+bool RS_Modification::breakAtIntersections()
+{
+    if (!container) {
+        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        "RS_Modification::breakAtIntersections: no valid container");
+        return false;
+    }
+
+    LC_IntersectionFinder finder;
+    finder.addAll(*container, true);
+
+    // intersection points of the atomic top level entities, in order of the drawing.
+    // Splines are top level pieces too, but they are no atomic entities.
+    std::vector<RS_Entity*> entities;
+    std::unordered_map<RS_Entity*, std::vector<RS_Vector>> points;
+    auto addPoint = [&entities, &points](RS_Entity* entity, RS_Entity* piece,
+                                         const RS_Vector& point) {
+        if (entity != piece || !entity->isAtomic() || entity->isLocked())
+            return;
+        std::vector<RS_Vector>& entityPoints = points[entity];
+        if (entityPoints.empty())
+            entities.push_back(entity);
+        entityPoints.push_back(point);
+    };
+    for (const LC_IntersectionFinder::Intersection& intersection: finder.intersections()) {
+        addPoint(intersection.entity1, intersection.piece1, intersection.point);
+        addPoint(intersection.entity2, intersection.piece2, intersection.point);
+    }
+
+    std::vector<RS_Entity*> addList;
+    std::vector<RS_Entity*> broken;
+    for (RS_Entity* entity: entities) {
+        std::vector<RS_AtomicEntity*> pieces = splitAtPoints(*static_cast<RS_AtomicEntity*>(entity),
+                                                             points[entity]);
+        if (pieces.empty())
+            continue;
+        broken.push_back(entity);
+        addList.insert(addList.end(), pieces.begin(), pieces.end());
+    }
+    if (broken.empty()) {
+        RS_DEBUG->print(RS_Debug::D_DEBUGGING,
+                        "RS_Modification::breakAtIntersections: no intersections");
+        return false;
+    }
+
+    LC_UndoSection undo(document, handleUndo);
+    for (RS_Entity* entity: broken) {
+        entity->setSelected(false);
+        entity->changeUndoState();
+        undo.addUndoable(entity);
+    }
+    addNewEntities(addList);
+
+    RS_DEBUG->print(RS_Debug::D_DEBUGGING,
+                    "RS_Modification::breakAtIntersections: %zu entities broken into %zu",
+                    broken.size(), addList.size());
+    return true;
+}
+
+
+
+/**
+ * Removes duplicate geometry and merges overlapping lines and arcs of the
+ * same layer and pen in one undo cycle, see LC_GeometryCleanup.
+ *
+ * @param selectedOnly only clean up the selected entities
+ * @return the removed and added entities, which belong to the container
+ * afterwards
+ */
+LC_GeometryCleanup::Result RS_Modification::removeDuplicates(double tolerance, bool selectedOnly)
+{
+    if (!container) {
+        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        "RS_Modification::removeDuplicates: no valid container");
+        return {};
+    }
+
+    LC_GeometryCleanup::Result result = LC_GeometryCleanup{tolerance}.run(*container, selectedOnly);
+    if (result.removed.empty())
+        return result;
+
+    LC_UndoSection undo(document, handleUndo);
+    for (RS_Entity* entity: result.removed) {
+        entity->setSelected(false);
+        entity->changeUndoState();
+        undo.addUndoable(entity);
+    }
+    for (RS_Entity* entity: result.added)
+        entity->reparent(container);
+    addNewEntities(result.added);
+
+    RS_DEBUG->print(RS_Debug::D_DEBUGGING,
+                    "RS_Modification::removeDuplicates: %zu duplicates, %zu merged",
+                    result.duplicates, result.merged);
+    return result;
+}
+
+
+
+/**
+ * Offsets closed polylines and circles, see LC_ContourOffset. The contours
+ * are offset concurrently, self-intersections of the results are removed.
+ *
+ * @param contours closed polylines and circles, other entities are ignored
+ * @param distance distance of the first offset, positive outwards
+ * @param number number of offsets at multiples of the distance
+ * @return number of created polylines
+ */
+size_t RS_Modification::offsetContours(const std::vector<RS_Entity*>& contours,
+                                       double distance, int number)
+{
+    if (!container) {
+        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        "RS_Modification::offsetContours: no valid container");
+        return 0;
+    }
+
+    std::vector<LC_ContourOffset::Contour> originals;
+    LC_ContourOffset::Contour contour;
+    for (RS_Entity* e: contours) {
+        if (e != nullptr && LC_ContourOffset::toContour(e, contour))
+            originals.push_back(std::move(contour));
+    }
+    if (originals.empty())
+        return 0;
+
+    const LC_ContourOffset engine;
+    std::vector<RS_Entity*> addList;
+    for (int num = 1; num <= number || (number == 0 && num <= 1); num++) {
+        for (const auto& offsets: engine.offsetAll(originals, num * distance)) {
+            for (const LC_ContourOffset::Contour& offset: offsets) {
+                RS_Polyline* polyline = LC_ContourOffset::toPolyline(offset, container);
+                polyline->setLayerToActive();
+                addList.push_back(polyline);
+            }
+        }
+    }
+    if (addList.empty())
+        return 0;
+
+    LC_UndoSection undo(document, handleUndo);
+    addNewEntities(addList);
+    return addList.size();
+}
+
+
+
 /**
  * Stretching.
  */
@@ -3284,7 +3613,8 @@ static void update_exploded_children_recursively(
         // Note: reassigning ec and e here, so keep
         // that in mind when writing code below this block.
         ec = (RS_EntityContainer*) clone;
-        for (e = ec->firstEntity(rl); e; e = ec->nextEntity(rl)) {
+        LC_ContainerTraverser traverser{*ec, rl};
+        for (e = traverser.first(); e; e = traverser.next()) {
             if (e) {
                 // Run the same code for every children recursively
                 update_exploded_children_recursively(ec, clone, e,
@@ -3310,105 +3640,118 @@ bool RS_Modification::explode(const bool remove /*= true*/)
 
 	std::vector<RS_Entity*> addList;
 
-    for(auto e: *container){
-        //for (unsigned i=0; i<container->count(); ++i) {
-        //RS_Entity* e = container->entityAt(i);
-
-        if (e && e->isSelected()) {
-            if (e->isContainer()) {
-
-                // add entities from container:
-                RS_EntityContainer* ec = (RS_EntityContainer*)e;
-                //ec->setSelected(false);
-
-                // iterate and explode container:
-                //for (unsigned i2=0; i2<ec->count(); ++i2) {
-                //    RS_Entity* e2 = ec->entityAt(i2);
-                RS2::ResolveLevel rl;
-                bool resolvePen;
-                bool resolveLayer;
-
-                switch (ec->rtti()) {
-                case RS2::EntityMText:
-                case RS2::EntityText:
-                case RS2::EntityHatch:
-                case RS2::EntityPolyline:
-                    rl = RS2::ResolveAll;
-                    resolveLayer = true;
-                    resolvePen = true;
-                    break;
+    for(auto e: getSelectedEntities()){
+        if (e->rtti() == RS2::EntityBulkGeometry) {
+            // bulk containers have no children, create regular entities
+            static_cast<LC_BulkGeometry*>(e)->createEntities(container, addList);
+        } else if (e->rtti() == RS2::EntitySpline) {
+            // splines have no children, create lines from the tessellation
+            const size_t first = addList.size();
+            static_cast<RS_Spline*>(e)->createEntities(container, addList);
+            for (size_t i = first; i < addList.size(); ++i) {
+                addList[i]->setLayer(e->getLayer());
+                addList[i]->setPen(e->getPen(false));
+            }
+        } else if (e->isContainer()) {
+
+            // add entities from container:
+            RS_EntityContainer* ec = (RS_EntityContainer*)e;
+            //ec->setSelected(false);
+
+            // iterate and explode container:
+            //for (unsigned i2=0; i2<ec->count(); ++i2) {
+            //    RS_Entity* e2 = ec->entityAt(i2);
+            RS2::ResolveLevel rl;
+            bool resolvePen;
+            bool resolveLayer;
+
+            switch (ec->rtti()) {
+            case RS2::EntityMText:
+            case RS2::EntityText:
+            case RS2::EntityHatch:
+            case RS2::EntityPolyline:
+                rl = RS2::ResolveAll;
+                resolveLayer = true;
+                resolvePen = true;
+                break;
 
-                case RS2::EntityInsert:
-                    resolvePen = false;
-                    resolveLayer = false;
-                    rl = RS2::ResolveNone;
-                    break;
+            case RS2::EntityInsert:
+                resolvePen = false;
+                resolveLayer = false;
+                rl = RS2::ResolveNone;
+                break;
 
-                case RS2::EntityDimAligned:
-                case RS2::EntityDimLinear:
-                case RS2::EntityDimRadial:
-                case RS2::EntityDimDiametric:
-                case RS2::EntityDimAngular:
-                case RS2::EntityDimLeader:
-                case RS2::EntityDimArc:
-                    rl = RS2::ResolveNone;
-                    resolveLayer = true;
-                    resolvePen = false;
-                    break;
+            case RS2::EntityDimAligned:
+            case RS2::EntityDimLinear:
+            case RS2::EntityDimRadial:
+            case RS2::EntityDimDiametric:
+            case RS2::EntityDimAngular:
+            case RS2::EntityDimLeader:
+            case RS2::EntityDimArc:
+                rl = RS2::ResolveNone;
+                resolveLayer = true;
+                resolvePen = false;
+                break;
 
-                default:
-                    rl = RS2::ResolveAll;
-                    resolveLayer = true;
-                    resolvePen = false;
-                    break;
-                }
+            default:
+                rl = RS2::ResolveAll;
+                resolveLayer = true;
+                resolvePen = false;
+                break;
+            }
 
-                for (RS_Entity* e2 = ec->firstEntity(rl); e2;
-                        e2 = ec->nextEntity(rl)) {
+            LC_ContainerTraverser traverser{*ec, rl};
+            for (RS_Entity* e2 = traverser.first(); e2; e2 = traverser.next()) {
 
-                    if (e2) {
-                        RS_Entity* clone = e2->clone();
-                        clone->setSelected(false);
-                        clone->reparent(container);
+                if (e2) {
+                    RS_Entity* clone = e2->clone();
+                    clone->setSelected(false);
+                    clone->reparent(container);
 
-                        addList.push_back(clone);
+                    addList.push_back(clone);
 
-                        // In order to fix bug #819 and escape similar issues,
-                        // we have to update all children of exploded entity,
-                        // even those (below the tree) which are not direct
-                        // subjects to the current explode() call.
-                        update_exploded_children_recursively(ec, e2, clone,
-                                rl, resolveLayer, resolvePen);
+                    // In order to fix bug #819 and escape similar issues,
+                    // we have to update all children of exploded entity,
+                    // even those (below the tree) which are not direct
+                    // subjects to the current explode() call.
+                    update_exploded_children_recursively(ec, e2, clone,
+                            rl, resolveLayer, resolvePen);
 /*
-                        if (resolveLayer) {
-                            clone->setLayer(ec->getLayer());
-                        } else {
-                            clone->setLayer(e2->getLayer());
-                        }
+                    if (resolveLayer) {
+                        clone->setLayer(ec->getLayer());
+                    } else {
+                        clone->setLayer(e2->getLayer());
+                    }
 
 //                        clone->setPen(ec->getPen(resolvePen));
-                        if (resolvePen) {
-                            clone->setPen(ec->getPen(true));
-                        } else {
-                            clone->setPen(e2->getPen(false));
-                        }
+                    if (resolvePen) {
+                        clone->setPen(ec->getPen(true));
+                    } else {
+                        clone->setPen(e2->getPen(false));
+                    }
 
-						addList.push_back(clone);
+					addList.push_back(clone);
 
-                        clone->update();
+                    clone->update();
 */
-                    }
                 }
-            } else {
-                e->setSelected(false);
             }
+        } else {
+            e->setSelected(false);
         }
     }
 
     LC_UndoSection undo( document, handleUndo); // bundle remove/add entities in one undoCycle
     deselectOriginals( remove);
     addNewEntities(addList);
-    container->updateInserts();
+    // no block has changed, only the exploded inserts need an update
+    for (RS_Entity* e: addList) {
+        if (e->rtti() == RS2::EntityInsert) {
+            static_cast<RS_Insert*>(e)->update();
+        } else if (e->isContainer() && e->rtti() != RS2::EntityHatch) {
+            static_cast<RS_EntityContainer*>(e)->updateInserts();
+        }
+    }
 
     return true;
 }
@@ -3425,19 +3768,17 @@ bool RS_Modification::explodeTextIntoLetters() {
 
 	std::vector<RS_Entity*> addList;
 
-	for(auto e: *container){
-        if (e && e->isSelected()) {
-            if (e->rtti()==RS2::EntityMText) {
-                // add letters of text:
-                RS_MText* text = (RS_MText*)e;
-                explodeTextIntoLetters(text, addList);
-            } else if (e->rtti()==RS2::EntityText) {
-                // add letters of text:
-                RS_Text* text = (RS_Text*)e;
-                explodeTextIntoLetters(text, addList);
-            } else {
-                e->setSelected(false);
-            }
+	for(auto e: getSelectedEntities()){
+        if (e->rtti()==RS2::EntityMText) {
+            // add letters of text:
+            RS_MText* text = (RS_MText*)e;
+            explodeTextIntoLetters(text, addList);
+        } else if (e->rtti()==RS2::EntityText) {
+            // add letters of text:
+            RS_Text* text = (RS_Text*)e;
+            explodeTextIntoLetters(text, addList);
+        } else {
+            e->setSelected(false);
         }
     }
 
@@ -3570,15 +3911,13 @@ bool RS_Modification::moveRef(RS_MoveRefData& data) {
 	std::vector<RS_Entity*> addList;
 
     // Create new entities
-	for(auto e: *container){
-		if (e && e->isSelected()) {
-            RS_Entity* ec = e->clone();
+	for(auto e: getSelectedEntities()){
+        RS_Entity* ec = e->clone();
 
-            ec->moveRef(data.ref, data.offset);
-            // since 2.0.4.0: keep it selected
-            ec->setSelected(true);
-			addList.push_back(ec);
-        }
+        ec->moveRef(data.ref, data.offset);
+        // since 2.0.4.0: keep it selected
+        ec->setSelected(true);
+		addList.push_back(ec);
     }
 
     LC_UndoSection undo( document, handleUndo); // bundle remove/add entities in one undoCycle
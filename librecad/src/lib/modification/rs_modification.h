@@ -27,7 +27,11 @@
 #ifndef RS_MODIFICATION_H
 #define RS_MODIFICATION_H
 
+#include <functional>
+#include <vector>
+
 #include <QHash>
+#include "lc_geometrycleanup.h"
 #include "rs_pen.h"
 #include "rs_vector.h"
 
@@ -38,6 +42,7 @@ class RS_MText;
 class RS_Text;
 class RS_Line;
 class RS_Polyline;
+class RS_Layer;
 class RS_Document;
 class RS_Graphic;
 class RS_GraphicView;
@@ -246,6 +251,9 @@ public:
                     double dist);
     bool offset(const RS_OffsetData& data);
     bool cut(const RS_Vector& cutCoord, RS_AtomicEntity* cutEntity);
+    bool breakAtIntersections();
+    LC_GeometryCleanup::Result removeDuplicates(double tolerance, bool selectedOnly);
+    size_t offsetContours(const std::vector<RS_Entity*>& contours, double distance, int number);
     bool stretch(const RS_Vector& firstCorner,
                                 const RS_Vector& secondCorner,
                                 const RS_Vector& offset);
@@ -287,14 +295,24 @@ private:
     void copyLayers(RS_Entity* e);
     void copyBlocks(RS_Entity* e);
     bool pasteLayers(RS_Graphic* source);
-    bool pasteContainer(RS_Entity* entity, RS_EntityContainer* container, QHash<QString, QString>blocksDict, RS_Vector insertionPoint);
+    bool pasteContainer(RS_Entity* entity, RS_EntityContainer* container, QHash<QString, QString>& blocksDict, RS_Vector insertionPoint);
     bool pasteEntity(RS_Entity* entity, RS_EntityContainer* container);
+    bool pasteEntities(RS_Graphic* source, const RS_Vector& insertionPoint, const RS_Vector& factor);
+    RS_Layer* pasteLayer(const RS_Layer* sourceLayer) const;
     void deselectOriginals(bool remove);
+    std::vector<RS_Entity*> getSelectedEntities() const;
+    void cloneTransformed(const std::vector<RS_Entity*>& originals, int copies,
+                          bool useCurrentLayer, bool useCurrentAttributes,
+                          bool keepSelection,
+                          const std::function<void(RS_Entity*, int)>& transform,
+                          std::vector<RS_Entity*>& addList) const;
 	void addNewEntities(std::vector<RS_Entity*>& addList);
 	bool explodeTextIntoLetters(RS_MText* text, std::vector<RS_Entity*>& addList);
 	bool explodeTextIntoLetters(RS_Text* text, std::vector<RS_Entity*>& addList);
 
     bool m_deletePolylineNodeMode = false;
+    //! layers of the paste source mapped to the layers of the graphic, see pasteLayers()
+    QHash<const RS_Layer*, RS_Layer*> m_pasteLayers;
 
 protected:
     RS_EntityContainer* container =nullptr;
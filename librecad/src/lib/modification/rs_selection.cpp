@@ -29,9 +29,11 @@
 
 #include "qg_dialogfactory.h"
 
+#include "lc_rect.h"
 #include "rs_block.h"
 #include "rs_dialogfactory.h"
 #include "rs_entity.h"
+#include "rs_graphic.h"
 #include "rs_graphicview.h"
 #include "rs_information.h"
 #include "rs_insert.h"
@@ -40,6 +42,31 @@
 #include "rs_selection.h"
 
 
+namespace {
+
+// Whether the line intersects an atomic entity within the given entity.
+// Entities and sub-containers whose borders don't touch the line are skipped
+// without intersection tests.
+bool isIntersected(const RS_Line& line, RS_Entity* entity)
+{
+    // construction lines are infinite, their borders don't tell
+    if (entity->rtti() != RS2::EntityConstructionLine) {
+        const LC_Rect box{entity->getMin(), entity->getMax()};
+        if (!box.intersects(line.getStartpoint(), line.getEndpoint(), RS_TOLERANCE))
+            return false;
+    }
+
+    if (entity->isContainer()) {
+        for (RS_Entity* e: *static_cast<RS_EntityContainer*>(entity)) {
+            if (e != nullptr && isIntersected(line, e))
+                return true;
+        }
+        return false;
+    }
+    return RS_Information::getIntersection(&line, entity, true).hasValid();
+}
+}
+
 /**
  * Default constructor.
  *
@@ -191,31 +218,8 @@ void RS_Selection::selectIntersected(const RS_Vector& v1, const RS_Vector& v2,
 
         if (e && e->isVisible()) {
 
-            inters = false;
-
             // select containers / groups:
-            if (e->isContainer()) {
-                RS_EntityContainer* ec = (RS_EntityContainer*)e;
-
-                for (RS_Entity* e2=ec->firstEntity(RS2::ResolveAll); e2;
-                        e2=ec->nextEntity(RS2::ResolveAll)) {
-
-                    RS_VectorSolutions sol =
-                        RS_Information::getIntersection(&line, e2, true);
-
-                    if (sol.hasValid()) {
-                        inters = true;
-                    }
-                }
-            } else {
-
-                RS_VectorSolutions sol =
-                    RS_Information::getIntersection(&line, e, true);
-
-                if (sol.hasValid()) {
-                    inters = true;
-                }
-            }
+            inters = isIntersected(line, e);
 
             if (inters) {
                 if (graphicView) {
@@ -345,6 +349,25 @@ void RS_Selection::selectLayer(RS_Entity* e) {
  */
 void RS_Selection::selectLayer(const QString& layerName, bool select) {
 
+    if (graphic != nullptr && container == graphic) {
+        // only visit the entities on that layer
+        RS_Layer* layer = graphic->findLayer(layerName);
+        if (layer == nullptr || layer->isLocked())
+            return;
+        for(RS_Entity* en: graphic->getLayerIndex().entities(layer)){
+            if (en->isVisible() && en->isSelected()!=select) {
+                if (graphicView) {
+                    graphicView->deleteEntity(en);
+                }
+                en->setSelected(select);
+                if (graphicView) {
+                    graphicView->drawEntity(en);
+                }
+            }
+        }
+        return;
+    }
+
 	for(auto en: *container){
 
         if (en && en->isVisible() && 
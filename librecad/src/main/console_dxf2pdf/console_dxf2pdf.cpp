@@ -36,6 +36,7 @@
 #include "main.h"
 
 #include "console_dxf2pdf.h"
+#include "lc_batchconverter.h"
 #include "pdf_print_loop.h"
 
 
@@ -48,6 +49,7 @@ int console_dxf2pdf(int argc, char* argv[])
 {
     RS_DEBUG->setLevel(RS_Debug::D_NOTHING);
 
+    LC_BatchConverter::setupHeadless();
     QApplication app(argc, argv);
     QCoreApplication::setOrganizationName("LibreCAD");
     QCoreApplication::setApplicationName("LibreCAD");
@@ -98,11 +100,11 @@ int console_dxf2pdf(int argc, char* argv[])
     parser.addOption(monoOpt);
 
     QCommandLineOption pageSizeOpt(QStringList() << "p" << "paper",
-        QObject::tr( "Paper size (Width x Height) in mm.", "WxH"));
+        QObject::tr( "Paper size (Width x Height) in mm."), "WxH");
     parser.addOption(pageSizeOpt);
 
     QCommandLineOption resOpt(QStringList() << "r" << "resolution",
-        QObject::tr( "Output resolution (DPI).", "integer"));
+        QObject::tr( "Output resolution (DPI)."), "integer");
     parser.addOption(resOpt);
 
     QCommandLineOption scaleOpt(QStringList() << "s" << "scale",
@@ -118,20 +120,35 @@ int console_dxf2pdf(int argc, char* argv[])
     parser.addOption(pagesNumOpt);
 
     QCommandLineOption outFileOpt(QStringList() << "o" << "outfile",
-        QObject::tr( "Output PDF file.", "file"));
+        QObject::tr( "Output PDF file."), "file");
     parser.addOption(outFileOpt);
 
     QCommandLineOption outDirOpt(QStringList() << "t" << "directory",
         QObject::tr( "Target output directory."), "path");
     parser.addOption(outDirOpt);
 
+    QCommandLineOption jobsOpt(QStringList() << "j" << "jobs",
+        QObject::tr( "Number of files printed in parallel to separate PDF files, "
+                     "defaults to the number of CPU cores."), "number");
+    parser.addOption(jobsOpt);
+
+    QCommandLineOption timeoutOpt(QStringList() << "timeout",
+        QObject::tr( "Give up a file after this time."), "seconds");
+    parser.addOption(timeoutOpt);
+
+    QCommandLineOption workerOpt(QStringList() << "worker",
+        QObject::tr( "Print the files read from the standard input."));
+    workerOpt.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(workerOpt);
+
     parser.addPositionalArgument(QObject::tr( "<dxf_files>"), QObject::tr( "Input DXF file(s)"));
 
     parser.process(app);
 
     const QStringList args = parser.positionalArguments();
 
-    if (args.isEmpty() || (args.size() == 1 && args[0] == "dxf2pdf"))
+    const bool worker = parser.isSet(workerOpt);
+    if (!worker && (args.isEmpty() || (args.size() == 1 && args[0] == "dxf2pdf")))
         parser.showHelp(EXIT_FAILURE);
 
     PdfPrintParams params;
@@ -165,7 +182,7 @@ int console_dxf2pdf(int argc, char* argv[])
         params.dxfFiles.append(arg);
     }
 
-    if (params.dxfFiles.isEmpty())
+    if (!worker && params.dxfFiles.isEmpty())
         parser.showHelp(EXIT_FAILURE);
 
     if (!params.outDir.isEmpty()) {
@@ -179,13 +196,30 @@ int console_dxf2pdf(int argc, char* argv[])
     RS_FONTLIST->init();
     RS_PATTERNLIST->init();
 
+    bool jobsOk = false;
+    params.jobs = parser.value(jobsOpt).toInt(&jobsOk);
+    if (!jobsOk)
+        params.jobs = LC_BatchConverter::defaultJobs();
+    params.timeout = parser.value(timeoutOpt).toInt();
+    params.workerArguments << "dxf2pdf" << "--worker"
+                           << LC_BatchConverter::forwardOptions(parser, {
+                                  fitOpt, centerOpt, grayOpt, monoOpt, pageSizeOpt,
+                                  resOpt, scaleOpt, marginsOpt, pagesNumOpt, outDirOpt});
+
     PdfPrintLoop *loop = new PdfPrintLoop(params, &app);
 
+    if (worker) {
+        return LC_BatchConverter::runWorker([loop](const QString& dxfFile, QString& error) {
+            return loop->printOneDxfToOnePdf(dxfFile, error);
+        });
+    }
+
     QObject::connect(loop, SIGNAL(finished()), &app, SLOT(quit()));
 
     QTimer::singleShot(0, loop, SLOT(run()));
 
-    return app.exec();
+    const int ret = app.exec();
+    return ret == 0 && loop->succeeded() ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
 
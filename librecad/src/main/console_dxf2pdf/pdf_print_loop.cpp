@@ -31,6 +31,8 @@
 #include "rs_staticgraphicview.h"
 #include "rs_units.h"
 
+#include "lc_batchconverter.h"
+#include "lc_imageloader.h"
 #include "pdf_print_loop.h"
 
 
@@ -42,9 +44,13 @@ static void drawPage(RS_Graphic*, QPrinter&, RS_PainterQt&);
 void PdfPrintLoop::run()
 {
     if (params.outFile.isEmpty()) {
-        for (auto &&f : params.dxfFiles) {
-            printOneDxfToOnePdf(f);
-        }
+        LC_BatchConverter converter(params.workerArguments, params.jobs);
+        converter.setTimeout(params.timeout);
+        auto results = converter.run(params.dxfFiles,
+                                     [this](const QString& dxfFile, QString& error) {
+            return printOneDxfToOnePdf(dxfFile, error);
+        });
+        success = LC_BatchConverter::printReport(results);
     } else {
         printManyDxfToOnePdf();
     }
@@ -53,7 +59,7 @@ void PdfPrintLoop::run()
 }
 
 
-void PdfPrintLoop::printOneDxfToOnePdf(const QString& dxfFile) {
+bool PdfPrintLoop::printOneDxfToOnePdf(const QString& dxfFile, QString& error) {
 
     // Main code logic and flow for this method is originally stolen from
     // QC_ApplicationWindow::slotFilePrint(bool printPDF) method.
@@ -67,11 +73,15 @@ void PdfPrintLoop::printOneDxfToOnePdf(const QString& dxfFile) {
     RS_Document *doc;
     RS_Graphic *graphic;
 
-    if (!openDocAndSetGraphic(&doc, &graphic, dxfFile))
-        return;
+    if (!openDocAndSetGraphic(&doc, &graphic, dxfFile)) {
+        error = "Failed to open document";
+        return false;
+    }
 
     qDebug() << "Printing" << dxfFile << "to" << params.outFile << ">>>>";
 
+    // images are loaded in the background, they must be complete to be drawn
+    LC_ImageLoader::instance()->waitForAll();
     touchGraphic(graphic, params);
 
     QPrinter printer(QPrinter::HighResolution);
@@ -85,11 +95,14 @@ void PdfPrintLoop::printOneDxfToOnePdf(const QString& dxfFile) {
 
     drawPage(graphic, printer, painter);
 
-    painter.end();
+    const bool ok = painter.end();
 
-    qDebug() << "Printing" << dxfFile << "to" << params.outFile << "DONE";
+    qDebug() << "Printing" << dxfFile << "to" << params.outFile << (ok ? "DONE" : "FAILED");
 
     delete doc;
+    if (!ok)
+        error = "Failed to write " + params.outFile;
+    return ok;
 }
 
 
@@ -126,6 +139,8 @@ void PdfPrintLoop::printManyDxfToOnePdf() {
 
         qDebug() << "Opened" << dxfFile;
 
+        LC_ImageLoader::instance()->waitForAll();
+
         touchGraphic(page.graphic, params);
 
         pages.append(page);
@@ -49,6 +49,9 @@ struct PdfPrintParams {
         } margins;           // If margin < 0.0, use value from dxf file.
         int pagesH = 0;      // If number of pages < 1,
         int pagesV = 0;      // use value from dxf file.
+        int jobs = 1;        // Number of worker processes for one pdf per dxf.
+        int timeout = 0;     // Seconds per file, 0 for no limit.
+        QStringList workerArguments;
 };
 
 
@@ -64,6 +67,15 @@ public:
     {
     }
 
+    bool printOneDxfToOnePdf(const QString& dxfFile, QString& error);
+
+    /**
+     * @return false if any file failed
+     */
+    bool succeeded() const {
+        return success;
+    }
+
 public slots:
 
     void run();
@@ -74,8 +86,8 @@ signals:
 
 private:
     PdfPrintParams params{};
+    bool success = true;
 
-    void printOneDxfToOnePdf(const QString&);
     void printManyDxfToOnePdf();
 };
 
@@ -37,6 +37,8 @@
 #include "qg_dialogfactory.h"
 
 #include "lc_actionfileexportmakercam.h"
+#include "lc_batchconverter.h"
+#include "lc_imageloader.h"
 #include "rs.h"
 #include "rs_debug.h"
 #include "rs_document.h"
@@ -61,6 +63,9 @@ static void touchGraphic(RS_Graphic*);
 
 static QSize parsePngSizeArg(QString);
 
+static bool convertFile(const QString& dxfFile, const QString& outFile, QSize pngSize,
+                        QString& error);
+
 bool slotFileExport(RS_Graphic* graphic,
                     const QString& name,
                     const QString& format,
@@ -96,6 +101,7 @@ int console_dxf2png(int argc, char* argv[])
 {
     RS_DEBUG->setLevel(RS_Debug::D_NOTHING);
 
+    LC_BatchConverter::setupHeadless();
     QApplication app(argc, argv);
     QCoreApplication::setOrganizationName("LibreCAD");
     QCoreApplication::setApplicationName("LibreCAD");
@@ -112,38 +118,58 @@ int console_dxf2png(int argc, char* argv[])
     QString appDesc;
     QString librecad;
     std::set<QString> allowed = {"dxf2png", "dxf2svg"};
-    if (allowed.count(prgInfo.baseName()) == 0) {
+    // the tool name is either the executable name or the first argument
+    QString tool = prgInfo.baseName();
+    if (allowed.count(tool) == 0) {
+        tool = QString(argv[1]);
         librecad = prgInfo.filePath();
         for (const auto& prog: allowed)
             appDesc += "\n" + prog + " usage: " + prgInfo.filePath()
             + " " + prog +" [options] <dxf_files>\n";
     }
-    appDesc += "\nPrint a DXF file to a PNG/SVG file.";
+    appDesc += "\nPrint DXF files to PNG/SVG files.";
     appDesc += "\n\n";
     appDesc += "Examples:\n\n";
     appDesc += "  " + librecad + " dxf2png *.dxf";
-    appDesc += "    -- print a dxf file to a png file with the same name.\n";
+    appDesc += "    -- print all dxf files to png files with the same names.\n";
+    appDesc += "  " + librecad + " dxf2png -j 8 -t thumbs -r 256x256 *.dxf";
+    appDesc += "    -- print all dxf files with 8 worker processes to the directory 'thumbs'.\n";
     parser.setApplicationDescription(appDesc);
 
     parser.addHelpOption();
     parser.addVersionOption();
 
     QCommandLineOption outFileOpt(QStringList() << "o" << "outfile",
-        "Output PNG file.", "file");
+        "Output PNG file, only used for a single input file.", "file");
     parser.addOption(outFileOpt);
 
     QCommandLineOption pngSizeOpt(QStringList() << "r" << "resolution",
         "Output PNG size (Width x Height) in pixels.", "WxH");
     parser.addOption(pngSizeOpt);
 
-    parser.addPositionalArgument("<dxf_files>", "Input DXF file");
+    QCommandLineOption outDirOpt(QStringList() << "t" << "directory",
+        "Target output directory.", "path");
+    parser.addOption(outDirOpt);
+
+    QCommandLineOption jobsOpt(QStringList() << "j" << "jobs",
+        "Number of files converted in parallel, defaults to the number of CPU cores.", "number");
+    parser.addOption(jobsOpt);
+
+    QCommandLineOption timeoutOpt(QStringList() << "timeout",
+        "Give up a file after this time.", "seconds");
+    parser.addOption(timeoutOpt);
+
+    QCommandLineOption workerOpt(QStringList() << "worker",
+        "Convert the files read from the standard input.");
+    workerOpt.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(workerOpt);
+
+    parser.addPositionalArgument("<dxf_files>", "Input DXF files");
 
     parser.process(app);
 
     const QStringList args = parser.positionalArguments();
 
-    if (args.isEmpty() || (args.size() == 1 && (args[0] == "dxf2png" || args[0] == "dxf2svg")))
-        parser.showHelp(EXIT_FAILURE);
     // Set PNG size from user input
     QSize pngSize = parsePngSizeArg(parser.value(pngSizeOpt)); // If nothing, use default values.
 
@@ -156,33 +182,77 @@ int console_dxf2png(int argc, char* argv[])
         dxfFiles.append(arg);
     }
 
-    if (dxfFiles.isEmpty())
+    const bool worker = parser.isSet(workerOpt);
+    if (!worker && dxfFiles.isEmpty())
         parser.showHelp(EXIT_FAILURE);
 
     // Output setup
 
-    QString& dxfFile = dxfFiles[0];
-
-    QFileInfo dxfFileInfo(dxfFile);
-    QString fn = dxfFileInfo.completeBaseName(); // original DXF file name
-    if(fn.isEmpty())
-        fn = "unnamed";
-
-    // Set output filename from user input if present
     QString outFile = parser.value(outFileOpt);
-    if (outFile.isEmpty()) {
-        outFile = dxfFileInfo.path() + "/" + fn + "." + args[0].mid(args[0].size()-3);
-    } else {
-        outFile = dxfFileInfo.path() + "/" + outFile;
+    if (!outFile.isEmpty() && dxfFiles.size() > 1) {
+        qDebug() << "WARNING: Ignoring output file for multiple input files:" << outFile;
+        outFile.clear();
+    }
+
+    QString outDir = parser.value(outDirOpt);
+    if (!outDir.isEmpty() && !QDir().mkpath(outDir)) {
+        qDebug() << "ERROR: Cannot create directory" << outDir;
+        return EXIT_FAILURE;
     }
 
+    RS_FONTLIST->init();
+    RS_PATTERNLIST->init();
+
+    auto convert = [&](const QString& dxfFile, QString& error) {
+        QFileInfo dxfFileInfo(dxfFile);
+        QString fn = dxfFileInfo.completeBaseName(); // original DXF file name
+        if(fn.isEmpty())
+            fn = "unnamed";
+
+        // Set output filename from user input if present
+        QString outPath;
+        if (!outFile.isEmpty()) {
+            outPath = dxfFileInfo.path() + "/" + outFile;
+        } else {
+            outPath = (outDir.isEmpty() ? dxfFileInfo.path() : outDir)
+                    + "/" + fn + "." + tool.right(3);
+        }
+        return convertFile(dxfFile, outPath, pngSize, error);
+    };
+
+    if (worker)
+        return LC_BatchConverter::runWorker(convert);
+
+    bool jobsOk = false;
+    int jobs = parser.value(jobsOpt).toInt(&jobsOk);
+    if (!jobsOk)
+        jobs = LC_BatchConverter::defaultJobs();
+
+    QStringList workerArguments;
+    workerArguments << tool << "--worker"
+                    << LC_BatchConverter::forwardOptions(parser, {pngSizeOpt, outDirOpt});
+
+    LC_BatchConverter converter(workerArguments, jobs);
+    converter.setTimeout(parser.value(timeoutOpt).toInt());
+    const bool ok = LC_BatchConverter::printReport(converter.run(dxfFiles, convert));
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+static bool convertFile(const QString& dxfFile, const QString& outFile, QSize pngSize,
+                        QString& error)
+{
     // Open the file and process the graphics
 
     std::unique_ptr<RS_Document> doc = openDocAndSetGraphic(dxfFile);
 
-    if (doc == nullptr || doc->getGraphic() == nullptr)
-        return 1;
+    if (doc == nullptr || doc->getGraphic() == nullptr) {
+        error = "Failed to open document";
+        return false;
+    }
     RS_Graphic *graphic = doc->getGraphic();
+    // images are loaded in the background, they must be complete to be drawn
+    LC_ImageLoader::instance()->waitForAll();
 
     LC_LOG << "Printing" << dxfFile << "to" << outFile << ">>>>";
 
@@ -192,18 +262,9 @@ int console_dxf2png(int argc, char* argv[])
 
     LC_LOG<< "QC_ApplicationWindow::slotFileExport()";
 
-    // read default settings:
-    auto groupGuard = RS_SETTINGS->beginGroupGuard("/Export");
-    QString defDir = dxfFileInfo.path();
-
     // find out extension:
     QString format = getFormatFromFile(outFile).toUpper();
 
-    // append extension to file:
-    if (!QFileInfo(fn).fileName().contains(".")) {
-        fn.push_back("." + format.toLower());
-    }
-
     bool ret = false;
     if (format.compare("SVG", Qt::CaseInsensitive) == 0) {
         ret = LC_ActionFileExportMakerCam::writeSvg(outFile, *graphic);
@@ -214,9 +275,11 @@ int console_dxf2png(int argc, char* argv[])
         ret = slotFileExport(graphic, outFile, format, pngSize, borders,
                        black, bw);
     }
+    if (!ret)
+        error = "Failed to write " + outFile;
 
     qDebug() << "Printing" << dxfFile << "to" << outFile << (ret ? "Done" : "Failed");
-    return 0;
+    return ret;
 }
 
 
@@ -275,7 +338,8 @@ bool slotFileExport(RS_Graphic* graphic, const QString& name,
 
     bool ret = false;
     // set vars for normal pictures and vectors (svg)
-    QPixmap* picture = new QPixmap(size);
+    // an image doesn't need a display, unlike a pixmap
+    QImage* picture = new QImage(size, QImage::Format_ARGB32_Premultiplied);
 
     QSvgGenerator* vector = new QSvgGenerator();
 
@@ -319,25 +383,24 @@ bool slotFileExport(RS_Graphic* graphic, const QString& name,
     gv.zoomAuto(false);
     gv.drawEntity(&painter, gv.getContainer());
 
+    // GraphicView deletes painter
+    painter.end();
+
     // end the picture output
     if(format.toLower() != "svg")
     {
         // RVT_PORT QImageIO iio;
         QImageWriter iio;
-        QImage img = picture->toImage();
         // RVT_PORT iio.setImage(img);
         iio.setFileName(name);
         iio.setFormat(format.toLatin1());
         // RVT_PORT if (iio.write()) {
-        if (iio.write(img)) {
+        if (iio.write(*picture)) {
             ret = true;
         }
 //        QString error=iio.errorString();
     }
     QApplication::restoreOverrideCursor();
-
-    // GraphicView deletes painter
-    painter.end();
     // delete vars
     delete picture;
     delete vector;
@@ -0,0 +1,340 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QProcess>
+#include <QThread>
+#include <QTimer>
+
+#include "lc_batchconverter.h"
+
+namespace {
+
+const char* const WorkerOk = "OK";
+const char* const WorkerFailed = "FAIL";
+
+/**
+ * A worker process and the file it is converting.
+ */
+struct Worker {
+    QProcess* process = nullptr;
+    //! index of the file in progress, -1 if idle
+    int job = -1;
+    bool timedOut = false;
+    QElapsedTimer timer;
+};
+
+QByteArray resultLine(bool ok, qint64 milliseconds, const QString& error)
+{
+    QByteArray line = QByteArray(ok ? WorkerOk : WorkerFailed) + '\t'
+            + QByteArray::number(milliseconds);
+    if (!ok)
+        line += '\t' + error.simplified().toUtf8();
+    return line + '\n';
+}
+
+/**
+ * Parses a result line written by a worker.
+ * @return false if the line isn't a result line
+ */
+bool parseResultLine(const QByteArray& line, LC_BatchConverter::Result& result)
+{
+    const QList<QByteArray> fields = line.trimmed().split('\t');
+    if (fields.size() < 2 || (fields[0] != WorkerOk && fields[0] != WorkerFailed))
+        return false;
+    result.ok = fields[0] == WorkerOk;
+    result.milliseconds = fields[1].toLongLong();
+    if (fields.size() > 2)
+        result.error = QString::fromUtf8(fields[2]);
+    return true;
+}
+}
+
+LC_BatchConverter::LC_BatchConverter(const QStringList& workerArguments, int jobs):
+    m_workerArguments(workerArguments)
+  , m_jobs(std::max(1, jobs))
+{}
+
+void LC_BatchConverter::setTimeout(int seconds)
+{
+    m_timeout = std::max(0, seconds);
+}
+
+std::vector<LC_BatchConverter::Result> LC_BatchConverter::run(const QStringList& files,
+                                                              const Convert& convert)
+{
+    if (m_jobs == 1 || files.size() <= 1)
+        return runSerial(files, convert);
+
+    std::vector<Result> results(files.size());
+    for (int i = 0; i < files.size(); ++i)
+        results[i].file = files[i];
+    std::vector<bool> handled(files.size(), false);
+    if (runParallel(files, results, handled))
+        return results;
+
+    // workers can't be started, convert the remaining files here
+    qDebug() << "WARNING: Cannot start worker processes, converting in one process";
+    QStringList remaining;
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!handled[i]) {
+            remaining << results[i].file;
+            indices.push_back(i);
+        }
+    }
+    std::vector<Result> serial = runSerial(remaining, convert);
+    for (size_t i = 0; i < serial.size(); ++i)
+        results[indices[i]] = serial[i];
+    return results;
+}
+
+std::vector<LC_BatchConverter::Result> LC_BatchConverter::runSerial(const QStringList& files,
+                                                                    const Convert& convert)
+{
+    std::vector<Result> results;
+    results.reserve(files.size());
+    for (const QString& file: files) {
+        Result result;
+        result.file = file;
+        QElapsedTimer timer;
+        timer.start();
+        result.ok = convert(file, result.error);
+        result.milliseconds = timer.elapsed();
+        results.push_back(result);
+    }
+    return results;
+}
+
+/**
+ * Distributes the files over the worker processes.
+ * @return false if a worker couldn't be started, handled tells which
+ * files have a result then.
+ */
+bool LC_BatchConverter::runParallel(const QStringList& files, std::vector<Result>& results,
+                                    std::vector<bool>& handled)
+{
+    const int count = files.size();
+    int next = 0;
+    int finished = 0;
+    bool startFailed = false;
+
+    QEventLoop loop;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // hands the next file to a worker, or lets it exit if there are none left
+    auto dispatch = [&](Worker& worker) {
+        worker.job = -1;
+        if (next >= count) {
+            worker.process->closeWriteChannel();
+            return;
+        }
+        worker.job = next++;
+        worker.timedOut = false;
+        worker.timer.start();
+        worker.process->write(files[worker.job].toUtf8() + '\n');
+    };
+
+    auto finish = [&](Worker& worker, const Result& result) {
+        results[worker.job].ok = result.ok;
+        results[worker.job].milliseconds = result.milliseconds;
+        results[worker.job].error = result.error;
+        handled[worker.job] = true;
+        if (++finished == count)
+            loop.quit();
+    };
+
+    std::function<void(Worker*)> start = [&](Worker* worker) {
+        QProcess* process = new QProcess();
+        worker->process = process;
+        worker->job = -1;
+        process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+
+        QObject::connect(process, &QProcess::readyReadStandardOutput, [&, worker, process]() {
+            if (worker->process != process)
+                return;
+            while (process->canReadLine()) {
+                Result result;
+                if (!parseResultLine(process->readLine(), result) || worker->job < 0)
+                    continue;
+                finish(*worker, result);
+                dispatch(*worker);
+            }
+        });
+        QObject::connect(process,
+                         QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                         [&, worker, process](int, QProcess::ExitStatus) {
+            process->deleteLater();
+            if (worker->process != process)
+                return;
+            worker->process = nullptr;
+            if (worker->job < 0)
+                return;
+
+            // the worker crashed or was killed on its file
+            Result result;
+            result.milliseconds = worker->timer.elapsed();
+            result.error = worker->timedOut ? QString("Timed out") : QString("Worker crashed");
+            finish(*worker, result);
+            if (next < count)
+                start(worker);
+        });
+        QObject::connect(process, &QProcess::errorOccurred,
+                         [&, worker, process](QProcess::ProcessError error) {
+            if (error != QProcess::FailedToStart || worker->process != process)
+                return;
+            process->deleteLater();
+            worker->process = nullptr;
+            startFailed = true;
+            loop.quit();
+        });
+
+        process->start(QCoreApplication::applicationFilePath(), m_workerArguments);
+        if (process->state() != QProcess::NotRunning)
+            dispatch(*worker);
+    };
+
+    QTimer watchdog;
+    if (m_timeout > 0) {
+        QObject::connect(&watchdog, &QTimer::timeout, [&]() {
+            for (auto& worker: workers) {
+                if (worker->process && worker->job >= 0
+                        && worker->timer.elapsed() > m_timeout * 1000LL) {
+                    worker->timedOut = true;
+                    worker->process->kill();
+                }
+            }
+        });
+        watchdog.start(500);
+    }
+
+    const int jobs = std::min(m_jobs, count);
+    for (int i = 0; i < jobs; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+        start(workers.back().get());
+        if (startFailed)
+            break;
+    }
+    if (!startFailed)
+        loop.exec();
+    watchdog.stop();
+
+    // let idle workers exit, stop the others
+    for (auto& worker: workers) {
+        QProcess* process = worker->process;
+        if (process == nullptr)
+            continue;
+        worker->process = nullptr;
+        process->closeWriteChannel();
+        if (!process->waitForFinished(startFailed ? 0 : 5000))
+            process->kill();
+        process->waitForFinished(1000);
+        delete process;
+    }
+    return !startFailed;
+}
+
+int LC_BatchConverter::runWorker(const Convert& convert)
+{
+    QFile input;
+    QFile output;
+    if (!input.open(stdin, QIODevice::ReadOnly) || !output.open(stdout, QIODevice::WriteOnly)) {
+        qDebug() << "ERROR: Cannot open the standard input and output";
+        return EXIT_FAILURE;
+    }
+
+    for (;;) {
+        QByteArray line = input.readLine();
+        if (line.isEmpty())
+            break;
+        while (line.endsWith('\n') || line.endsWith('\r'))
+            line.chop(1);
+        if (line.isEmpty())
+            continue;
+
+        QString error;
+        QElapsedTimer timer;
+        timer.start();
+        const bool ok = convert(QString::fromUtf8(line), error);
+        output.write(resultLine(ok, timer.elapsed(), error));
+        output.flush();
+    }
+    return EXIT_SUCCESS;
+}
+
+bool LC_BatchConverter::printReport(const std::vector<Result>& results)
+{
+    int converted = 0;
+    qint64 total = 0;
+    for (const Result& result: results) {
+        if (result.ok) {
+            ++converted;
+            qDebug().noquote() << result.file << "done in" << result.milliseconds << "ms";
+        } else {
+            qDebug().noquote() << result.file << "FAILED after" << result.milliseconds
+                               << "ms:" << result.error;
+        }
+        total += result.milliseconds;
+    }
+    qDebug().noquote() << QString("Converted %1 of %2 files, %3 ms conversion time")
+                          .arg(converted).arg(results.size()).arg(total);
+    return converted == static_cast<int>(results.size());
+}
+
+void LC_BatchConverter::setupHeadless()
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+}
+
+int LC_BatchConverter::defaultJobs()
+{
+    return std::max(1, QThread::idealThreadCount());
+}
+
+QStringList LC_BatchConverter::forwardOptions(const QCommandLineParser& parser,
+                                              const QList<QCommandLineOption>& options)
+{
+    QStringList arguments;
+    for (const QCommandLineOption& option: options) {
+        const QStringList names = option.names();
+        if (names.isEmpty() || !parser.isSet(names.last()))
+            continue;
+        arguments << (names.last().size() == 1 ? "-" : "--") + names.last();
+        if (!option.valueName().isEmpty())
+            arguments << parser.value(names.last());
+    }
+    return arguments;
+}
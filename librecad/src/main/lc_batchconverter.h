@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_BATCHCONVERTER_H
+#define LC_BATCHCONVERTER_H
+
+#include <functional>
+#include <vector>
+
+#include <QStringList>
+
+class QCommandLineOption;
+class QCommandLineParser;
+
+/**
+ * Converts a list of drawing files for the console tools
+ * (dxf2png, dxf2svg, dxf2pdf).
+ *
+ * With more than one job, the files are converted by a pool of worker
+ * processes running the same tool with the --worker option. A worker reads
+ * file names from its standard input and reports one result line per file,
+ * so a file which crashes or hangs its worker only fails that file, the
+ * worker is replaced and the batch goes on. With one job the files are
+ * converted in this process.
+ */
+class LC_BatchConverter {
+public:
+    /**
+     * Converts one file.
+     * @return false on errors, with a description in error
+     */
+    using Convert = std::function<bool(const QString& file, QString& error)>;
+
+    struct Result {
+        QString file;
+        bool ok = false;
+        //! conversion time in milliseconds
+        qint64 milliseconds = 0;
+        QString error;
+    };
+
+    /**
+     * @param workerArguments command line arguments of a worker process,
+     * without the program
+     * @param jobs number of files converted concurrently
+     */
+    LC_BatchConverter(const QStringList& workerArguments, int jobs);
+
+    /** Kills workers which need more than the given time for one file. */
+    void setTimeout(int seconds);
+
+    std::vector<Result> run(const QStringList& files, const Convert& convert);
+
+    /**
+     * Main loop of a worker process.
+     */
+    static int runWorker(const Convert& convert);
+
+    /**
+     * Prints the time of each file and a summary.
+     * @return true if all files were converted
+     */
+    static bool printReport(const std::vector<Result>& results);
+
+    /**
+     * Lets console tools run without a display server, unless a platform
+     * is chosen explicitly. Must be called before the application is created.
+     */
+    static void setupHeadless();
+    static int defaultJobs();
+    /**
+     * @return the given options in the form expected by the parser, to pass
+     * them on to worker processes
+     */
+    static QStringList forwardOptions(const QCommandLineParser& parser,
+                                      const QList<QCommandLineOption>& options);
+
+private:
+    std::vector<Result> runSerial(const QStringList& files, const Convert& convert);
+    bool runParallel(const QStringList& files, std::vector<Result>& results,
+                     std::vector<bool>& handled);
+
+    QStringList m_workerArguments;
+    int m_jobs = 1;
+    int m_timeout = 0;
+};
+
+#endif // LC_BATCHCONVERTER_H
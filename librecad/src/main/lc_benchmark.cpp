@@ -0,0 +1,646 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <numeric>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include "main.h"
+
+#include "lc_batchconverter.h"
+#include "lc_benchmark.h"
+#include "rs_arc.h"
+#include "rs_block.h"
+#include "rs_circle.h"
+#include "rs_debug.h"
+#include "rs_fontlist.h"
+#include "rs_graphic.h"
+#include "rs_hatch.h"
+#include "rs_information.h"
+#include "rs_insert.h"
+#include "rs_layer.h"
+#include "rs_line.h"
+#include "rs_math.h"
+#include "rs_modification.h"
+#include "rs_painterqt.h"
+#include "rs_patternlist.h"
+#include "rs_pen.h"
+#include "rs_polyline.h"
+#include "rs_selection.h"
+#include "rs_settings.h"
+#include "rs_staticgraphicview.h"
+#include "rs_system.h"
+#include "rs_text.h"
+
+namespace {
+
+const char* const BlockName = "benchmark";
+const int LayerCount = 3;
+//! size of the block compared to the drawing
+const double BlockExtent = 10.;
+
+QString layerName(int index)
+{
+    return QString("layer%1").arg(index % LayerCount + 1);
+}
+
+/**
+ * Timings of one benchmark, in milliseconds.
+ */
+struct Measurement {
+    QString name;
+    //! number of operations per sample
+    int operations = 1;
+    std::vector<double> samples;
+
+    double minimum() const {
+        return *std::min_element(samples.begin(), samples.end());
+    }
+    double maximum() const {
+        return *std::max_element(samples.begin(), samples.end());
+    }
+    double mean() const {
+        return std::accumulate(samples.begin(), samples.end(), 0.) / samples.size();
+    }
+    double median() const {
+        std::vector<double> sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        const size_t middle = sorted.size() / 2;
+        return sorted.size() % 2 ? sorted[middle] : 0.5 * (sorted[middle - 1] + sorted[middle]);
+    }
+};
+
+class BenchmarkRunner {
+public:
+    BenchmarkRunner(int repeat, const QString& filter):
+        repeat(std::max(1, repeat))
+      , filter(filter)
+    {}
+
+    bool isEnabled(const QString& name) const {
+        return filter.pattern().isEmpty() || filter.match(name).hasMatch();
+    }
+
+    /**
+     * Times run() repeatedly, setup() is called untimed before each run.
+     */
+    void measure(const QString& name, int operations, const std::function<void()>& run,
+                 const std::function<void()>& setup = {})
+    {
+        if (!isEnabled(name))
+            return;
+        qDebug().noquote() << "Running" << name;
+        Measurement measurement;
+        measurement.name = name;
+        measurement.operations = std::max(1, operations);
+        for (int i = 0; i < repeat; ++i) {
+            if (setup)
+                setup();
+            QElapsedTimer timer;
+            timer.start();
+            run();
+            measurement.samples.push_back(timer.nsecsElapsed() * 1.0e-6);
+        }
+        measurements.push_back(measurement);
+    }
+
+    const std::vector<Measurement>& getMeasurements() const {
+        return measurements;
+    }
+
+private:
+    int repeat = 1;
+    QRegularExpression filter;
+    std::vector<Measurement> measurements;
+};
+
+QByteArray toJson(const std::vector<Measurement>& measurements, const QJsonObject& header)
+{
+    QJsonArray benchmarks;
+    for (const Measurement& measurement: measurements) {
+        QJsonArray samples;
+        for (double sample: measurement.samples)
+            samples.append(sample);
+        QJsonObject benchmark;
+        benchmark["name"] = measurement.name;
+        benchmark["operations"] = measurement.operations;
+        benchmark["min_ms"] = measurement.minimum();
+        benchmark["median_ms"] = measurement.median();
+        benchmark["mean_ms"] = measurement.mean();
+        benchmark["max_ms"] = measurement.maximum();
+        benchmark["samples_ms"] = samples;
+        benchmarks.append(benchmark);
+    }
+    QJsonObject root = header;
+    root["benchmarks"] = benchmarks;
+    return QJsonDocument(root).toJson();
+}
+
+QByteArray toCsv(const std::vector<Measurement>& measurements)
+{
+    QByteArray csv = "name,operations,min_ms,median_ms,mean_ms,max_ms\n";
+    for (const Measurement& measurement: measurements) {
+        csv += QString("%1,%2,%3,%4,%5,%6\n")
+                .arg(measurement.name)
+                .arg(measurement.operations)
+                .arg(measurement.minimum(), 0, 'f', 4)
+                .arg(measurement.median(), 0, 'f', 4)
+                .arg(measurement.mean(), 0, 'f', 4)
+                .arg(measurement.maximum(), 0, 'f', 4).toUtf8();
+    }
+    return csv;
+}
+}
+
+LC_BenchmarkDrawing::LC_BenchmarkDrawing(unsigned seed, int entityCount):
+    generator(seed)
+  , size(std::max(1, entityCount))
+  , extent(10. * std::sqrt(static_cast<double>(std::max(1, entityCount))))
+{}
+
+/**
+ * std::uniform_real_distribution is implementation defined, the raw
+ * output of the generator is the same everywhere.
+ */
+double LC_BenchmarkDrawing::random(double min, double max)
+{
+    return min + (max - min) * (generator() / 4294967296.);
+}
+
+RS_Vector LC_BenchmarkDrawing::randomPoint()
+{
+    return {random(0., extent), random(0., extent)};
+}
+
+void LC_BenchmarkDrawing::create(RS_Graphic& graphic)
+{
+    inserts.clear();
+    hatches.clear();
+    for (int i = 0; i < LayerCount; ++i)
+        graphic.addLayer(new RS_Layer(layerName(i)));
+
+    createBlock(graphic);
+    addBasicEntities(graphic, size);
+
+    const int insertCount = std::max(1, size / 20);
+    for (int i = 0; i < insertCount; ++i) {
+        const double scale = random(0.5, 2.);
+        RS_InsertData data(BlockName, randomPoint(), RS_Vector(scale, scale),
+                           random(0., 2. * M_PI), 1, 1, RS_Vector(0., 0.),
+                           nullptr, RS2::NoUpdate);
+        // every tenth insert is a small array
+        if (i % 10 == 0) {
+            data.cols = 3;
+            data.rows = 2;
+            data.spacing = RS_Vector(BlockExtent * 1.5, BlockExtent * 1.5);
+        }
+        auto insert = new RS_Insert(&graphic, data);
+        insert->setLayer(layerName(i));
+        graphic.addEntity(insert);
+        insert->update();
+        inserts.push_back(insert);
+    }
+
+    const int hatchCount = std::max(1, size / 100);
+    for (int i = 0; i < hatchCount; ++i)
+        addHatch(graphic, i % 4 == 0);
+
+    graphic.calculateBorders();
+}
+
+void LC_BenchmarkDrawing::createBlock(RS_Graphic& graphic)
+{
+    auto block = new RS_Block(&graphic, RS_BlockData(BlockName, RS_Vector(0., 0.), false));
+    const double savedExtent = extent;
+    extent = BlockExtent;
+    addBasicEntities(*block, 32);
+    extent = savedExtent;
+    graphic.addBlock(block);
+}
+
+void LC_BenchmarkDrawing::addBasicEntities(RS_EntityContainer& container, int count)
+{
+    const bool inBlock = container.rtti() == RS2::EntityBlock;
+    const double length = std::max(BlockExtent, extent / 50.);
+    for (int i = 0; i < count; ++i) {
+        const RS_Vector start = randomPoint();
+        RS_Entity* entity = nullptr;
+        switch (i % 16) {
+        case 8:
+        case 9:
+        case 10:
+            entity = new RS_Arc(&container, RS_ArcData(start, random(0.1, 0.5) * length,
+                                                       random(0., 2. * M_PI),
+                                                       random(0., 2. * M_PI), i % 2 == 0));
+            break;
+        case 11:
+        case 12:
+            entity = new RS_Circle(&container, {start, random(0.1, 0.5) * length});
+            break;
+        case 13:
+        case 14: {
+            auto polyline = new RS_Polyline(&container,
+                                            RS_PolylineData(RS_Vector(false), RS_Vector(false),
+                                                            i % 3 == 0));
+            RS_Vector vertex = start;
+            for (int j = 0; j < 6; ++j) {
+                polyline->addVertex(vertex, j % 2 ? random(-0.5, 0.5) : 0.);
+                vertex += RS_Vector::polar(random(0.1, 0.3) * length, random(0., 2. * M_PI));
+            }
+            entity = polyline;
+            break;
+        }
+        case 15: {
+            auto text = new RS_Text(&container,
+                                    RS_TextData(start, start, random(0.02, 0.1) * length, 1.,
+                                                RS_TextData::VABaseline, RS_TextData::HALeft,
+                                                RS_TextData::None,
+                                                QString("LibreCAD %1").arg(i),
+                                                "standard", random(0., 2. * M_PI),
+                                                RS2::NoUpdate));
+            text->update();
+            entity = text;
+            break;
+        }
+        default:
+            entity = new RS_Line(&container, start,
+                                 start + RS_Vector::polar(random(0.1, 1.) * length,
+                                                          random(0., 2. * M_PI)));
+            break;
+        }
+        if (!inBlock)
+            entity->setLayer(layerName(i));
+        container.addEntity(entity);
+    }
+}
+
+void LC_BenchmarkDrawing::addHatch(RS_Graphic& graphic, bool solid)
+{
+    auto hatch = new RS_Hatch(&graphic, RS_HatchData(solid, 1., random(0., M_PI),
+                                                     solid ? "SOLID" : "ANSI31"));
+    hatch->setLayer(layerName(static_cast<int>(hatches.size())));
+
+    const RS_Vector corner = randomPoint();
+    const RS_Vector size{random(10., 50.), random(10., 50.)};
+    auto loop = new RS_EntityContainer(hatch);
+    loop->setPen(RS_Pen(RS2::FlagInvalid));
+    const RS_Vector corners[] = {corner, corner + RS_Vector(size.x, 0.),
+                                 corner + size, corner + RS_Vector(0., size.y)};
+    for (int i = 0; i < 4; ++i)
+        loop->addEntity(new RS_Line(loop, corners[i], corners[(i + 1) % 4]));
+    hatch->addEntity(loop);
+
+    // every third hatch has an island
+    if (hatches.size() % 3 == 0) {
+        auto island = new RS_EntityContainer(hatch);
+        island->setPen(RS_Pen(RS2::FlagInvalid));
+        island->addEntity(new RS_Circle(island, {corner + size * 0.5,
+                                                 0.25 * std::min(size.x, size.y)}));
+        hatch->addEntity(island);
+    }
+
+    graphic.addEntity(hatch);
+    hatch->update();
+    hatches.push_back(hatch);
+}
+
+int console_benchmark(int argc, char* argv[])
+{
+    RS_DEBUG->setLevel(RS_Debug::D_NOTHING);
+
+    LC_BatchConverter::setupHeadless();
+    QApplication app(argc, argv);
+    QCoreApplication::setOrganizationName("LibreCAD");
+    QCoreApplication::setApplicationName("LibreCAD");
+    QCoreApplication::setApplicationVersion(XSTR(LC_VERSION));
+
+    QFileInfo prgInfo(QFile::decodeName(argv[0]));
+    QString prgDir(prgInfo.absolutePath());
+    RS_SETTINGS->init(app.organizationName(), app.applicationName());
+    RS_SYSTEM->init(app.applicationName(), app.applicationVersion(),
+        XSTR(QC_APPDIR), prgDir.toLatin1().data());
+
+    QCommandLineParser parser;
+    QString librecad;
+    if (prgInfo.baseName() != "benchmark")
+        librecad = prgInfo.filePath() + " benchmark";
+    parser.setApplicationDescription(
+        "\nTimes core operations on a generated drawing and writes the results "
+        "as JSON or CSV.\n"
+        "Drawing files given as arguments are timed while loading.\n\n"
+        "Examples:\n\n"
+        "  " + librecad + " -o results.json\n"
+        "  " + librecad + " -n 100000 -f 'update|redraw' --csv\n");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption sizeOpt(QStringList() << "n" << "size",
+        "Number of entities of the generated drawing, 20000 by default.", "number");
+    parser.addOption(sizeOpt);
+    QCommandLineOption seedOpt(QStringList() << "s" << "seed",
+        "Seed of the generated drawing.", "number");
+    parser.addOption(seedOpt);
+    QCommandLineOption repeatOpt(QStringList() << "r" << "repeat",
+        "Number of samples per benchmark, 5 by default.", "number");
+    parser.addOption(repeatOpt);
+    QCommandLineOption filterOpt(QStringList() << "f" << "filter",
+        "Only run benchmarks with names matching this regular expression.", "regexp");
+    parser.addOption(filterOpt);
+    QCommandLineOption csvOpt(QStringList() << "csv",
+        "Write CSV instead of JSON.");
+    parser.addOption(csvOpt);
+    QCommandLineOption outFileOpt(QStringList() << "o" << "outfile",
+        "Output file, standard output by default.", "file");
+    parser.addOption(outFileOpt);
+    parser.addPositionalArgument("[files]", "DXF or DWG files to load");
+
+    parser.process(app);
+
+    QStringList files = parser.positionalArguments();
+    files.removeAll("benchmark");
+
+    bool ok = false;
+    int size = parser.value(sizeOpt).toInt(&ok);
+    if (!ok || size <= 0)
+        size = 20000;
+    unsigned seed = parser.value(seedOpt).toUInt(&ok);
+    if (!ok)
+        seed = 1;
+    int repeat = parser.value(repeatOpt).toInt(&ok);
+    if (!ok || repeat <= 0)
+        repeat = 5;
+
+    RS_FONTLIST->init();
+    RS_PATTERNLIST->init();
+
+    BenchmarkRunner runner(repeat, parser.value(filterOpt));
+
+    // creating the drawing, including the updates of texts, inserts and hatches
+    std::unique_ptr<RS_Graphic> scratch;
+    runner.measure("generate", size, [&]() {
+        scratch = std::make_unique<RS_Graphic>();
+        LC_BenchmarkDrawing(seed, size).create(*scratch);
+    }, [&]() {
+        scratch.reset();
+    });
+    scratch.reset();
+
+    RS_Graphic graphic;
+    LC_BenchmarkDrawing drawing(seed, size);
+    drawing.create(graphic);
+
+    QTemporaryDir directory;
+    const QString dxfFile = directory.path() + "/benchmark.dxf";
+    if (runner.isEnabled("save_dxf") || runner.isEnabled("load_dxf")) {
+        runner.measure("save_dxf", 1, [&]() {
+            if (!graphic.saveAs(dxfFile, RS2::FormatDXFRW, true))
+                qDebug() << "ERROR: Cannot save" << dxfFile;
+        });
+        std::unique_ptr<RS_Graphic> loaded;
+        runner.measure("load_dxf", 1, [&]() {
+            loaded = std::make_unique<RS_Graphic>();
+            if (!loaded->open(dxfFile, RS2::FormatUnknown))
+                qDebug() << "ERROR: Cannot load" << dxfFile;
+        }, [&]() {
+            loaded.reset();
+        });
+    }
+
+    for (const QString& file: files) {
+        std::unique_ptr<RS_Graphic> loaded;
+        runner.measure("load:" + QFileInfo(file).fileName(), 1, [&]() {
+            loaded = std::make_unique<RS_Graphic>();
+            if (!loaded->open(file, RS2::FormatUnknown))
+                qDebug() << "ERROR: Cannot load" << file;
+        }, [&]() {
+            loaded.reset();
+        });
+    }
+
+    const std::vector<RS_Insert*>& inserts = drawing.getInserts();
+    runner.measure("insert_update", static_cast<int>(inserts.size()), [&]() {
+        for (RS_Insert* insert: inserts)
+            insert->update();
+    });
+
+    const std::vector<RS_Hatch*>& hatches = drawing.getHatches();
+    runner.measure("hatch_update", static_cast<int>(hatches.size()), [&]() {
+        for (RS_Hatch* hatch: hatches)
+            hatch->update();
+    });
+
+    // queries at the same random points for every sample
+    std::vector<RS_Vector> points(1000);
+    for (RS_Vector& point: points)
+        point = drawing.randomPoint();
+    double distance = 0.;
+    runner.measure("nearest_entity", static_cast<int>(points.size()), [&]() {
+        for (const RS_Vector& point: points)
+            graphic.getNearestEntity(point, &distance, RS2::ResolveNone);
+    });
+    runner.measure("snap_endpoint", static_cast<int>(points.size()), [&]() {
+        for (const RS_Vector& point: points)
+            graphic.getNearestEndpoint(point, &distance);
+    });
+    runner.measure("snap_on_entity", static_cast<int>(points.size()), [&]() {
+        for (const RS_Vector& point: points)
+            graphic.getNearestPointOnEntity(point, true, &distance);
+    });
+
+    // removing entities one by one keeps the borders up to date
+    std::vector<RS_Entity*> removed;
+    for (int i = 0; i < 1000 && graphic.count() > 0; ++i)
+        removed.push_back(graphic.entityAt(RS_Math::round(drawing.random(0., graphic.count() - 1.))));
+    RS_EntityContainer removals{nullptr, false};
+    runner.measure("remove_entity", static_cast<int>(removed.size()), [&]() {
+        for (RS_Entity* entity: removed)
+            removals.removeEntity(entity);
+    }, [&]() {
+        removals.clear();
+        for (RS_Entity* entity: graphic)
+            removals.appendEntity(entity);
+    });
+    removals.clear();
+
+    // the selection widget is updated after every selection change
+    for (RS_Entity* entity: removed)
+        entity->setSelected(true);
+    const int selectionUpdates = 100;
+    double selectedLength = 0.;
+    runner.measure("selection_count", selectionUpdates, [&]() {
+        for (int i = 0; i < selectionUpdates; ++i)
+            selectedLength += graphic.countSelected() + graphic.totalSelectedLength();
+    });
+    for (RS_Entity* entity: removed)
+        entity->setSelected(false);
+    qDebug() << "Selected length:" << selectedLength;
+
+    // crossing windows and fences of a few entity sizes
+    std::vector<std::pair<RS_Vector, RS_Vector>> windows(100);
+    for (auto& window: windows) {
+        window.first = drawing.randomPoint();
+        window.second = window.first + RS_Vector{drawing.random(-50., 50.), drawing.random(-50., 50.)};
+    }
+    RS_Selection selection{graphic};
+    runner.measure("select_crossing", static_cast<int>(windows.size()), [&]() {
+        for (const auto& window: windows)
+            graphic.selectWindow(RS2::EntityUnknown, window.first, window.second, true, true);
+    }, [&]() {
+        graphic.setSelected(false);
+    });
+    runner.measure("select_fence", static_cast<int>(windows.size()), [&]() {
+        for (const auto& window: windows)
+            selection.selectIntersected(window.first, window.second);
+    }, [&]() {
+        graphic.setSelected(false);
+    });
+    graphic.setSelected(false);
+
+    // pasting the whole drawing into a new one, including its layers and blocks
+    std::unique_ptr<RS_Graphic> pasted;
+    runner.measure("paste", static_cast<int>(graphic.count()), [&]() {
+        pasted = std::make_unique<RS_Graphic>();
+        RS_Modification{*pasted, nullptr, false}.paste(RS_PasteData{RS_Vector{0., 0.}, 1., 0., false, QString{}},
+                                                       &graphic);
+    }, [&]() {
+        pasted.reset();
+    });
+    pasted.reset();
+
+    std::vector<RS_Entity*> curves;
+    for (RS_Entity* entity: graphic) {
+        switch (entity->rtti()) {
+        case RS2::EntityLine:
+        case RS2::EntityArc:
+        case RS2::EntityCircle:
+            curves.push_back(entity);
+            break;
+        default:
+            break;
+        }
+    }
+    std::vector<std::pair<RS_Entity*, RS_Entity*>> pairs;
+    if (curves.size() > 1) {
+        pairs.resize(20000);
+        for (auto& pair: pairs) {
+            const double last = curves.size() - 1;
+            pair.first = curves[RS_Math::round(drawing.random(0., last))];
+            pair.second = curves[RS_Math::round(drawing.random(0., last))];
+        }
+    }
+    size_t intersections = 0;
+    runner.measure("intersection_pairs", static_cast<int>(pairs.size()), [&]() {
+        for (const auto& pair: pairs)
+            intersections += RS_Information::getIntersection(pair.first, pair.second, true).size();
+    });
+    if (!pairs.empty())
+        qDebug() << "Intersections found:" << static_cast<qulonglong>(intersections);
+
+    if (runner.isEnabled("redraw")) {
+        const QSize viewSize(1920, 1080);
+        QImage image(viewSize, QImage::Format_ARGB32_Premultiplied);
+        RS_PainterQt painter(&image);
+        RS_StaticGraphicView view(viewSize.width(), viewSize.height(), &painter);
+        view.setBackground(Qt::white);
+        view.setContainer(&graphic);
+        view.zoomAuto(false);
+        runner.measure("redraw", 1, [&]() {
+            view.drawEntity(&painter, &graphic);
+        }, [&]() {
+            painter.fillRect(0, 0, viewSize.width(), viewSize.height(), RS_Color(Qt::white));
+        });
+        painter.end();
+    }
+
+    if (runner.isEnabled("undo_redo")) {
+        // moves of a few lines per cycle, like the move action
+        std::vector<RS_Entity*> lines;
+        for (RS_Entity* entity: graphic) {
+            if (entity->rtti() == RS2::EntityLine)
+                lines.push_back(entity);
+        }
+        const int perCycle = 50;
+        const int cycles = std::min<int>(100, static_cast<int>(lines.size()) / perCycle);
+        const RS_Vector offset(1., 1.);
+        for (int i = 0; i < cycles; ++i) {
+            graphic.startUndoCycle();
+            for (int j = i * perCycle; j < (i + 1) * perCycle; ++j) {
+                RS_Entity* moved = lines[j]->clone();
+                moved->move(offset);
+                graphic.addEntity(moved);
+                graphic.addUndoable(moved);
+                lines[j]->setUndoState(true);
+                graphic.addUndoable(lines[j]);
+            }
+            graphic.endUndoCycle();
+        }
+        runner.measure("undo_redo", 2 * cycles, [&]() {
+            while (graphic.undo()) {}
+            while (graphic.redo()) {}
+        });
+    }
+
+    QJsonObject header;
+    header["version"] = QString(XSTR(LC_VERSION));
+    header["qt"] = QString(qVersion());
+    header["size"] = size;
+    header["seed"] = static_cast<qint64>(seed);
+    header["repeat"] = repeat;
+    header["threads"] = QThread::idealThreadCount();
+    header["time"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+
+    const QByteArray output = parser.isSet(csvOpt) ? toCsv(runner.getMeasurements())
+                                                   : toJson(runner.getMeasurements(), header);
+    QFile outFile;
+    const QString outFileName = parser.value(outFileOpt);
+    bool opened = false;
+    if (outFileName.isEmpty()) {
+        opened = outFile.open(stdout, QIODevice::WriteOnly);
+    } else {
+        outFile.setFileName(outFileName);
+        opened = outFile.open(QIODevice::WriteOnly);
+    }
+    if (!opened || outFile.write(output) != output.size()) {
+        qDebug() << "ERROR: Cannot write the results to" << outFileName;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
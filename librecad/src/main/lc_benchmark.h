@@ -0,0 +1,83 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+#ifndef LC_BENCHMARK_H
+#define LC_BENCHMARK_H
+
+#include <random>
+#include <vector>
+
+#include "rs_vector.h"
+
+class RS_EntityContainer;
+class RS_Graphic;
+class RS_Hatch;
+class RS_Insert;
+
+/**
+ * Reproducible synthetic drawings for benchmarks.
+ *
+ * The same seed and size always create the same entities: lines, arcs,
+ * circles, polylines with bulges, texts, inserts of a block and hatches
+ * with pattern and solid fill, spread over a few layers.
+ */
+class LC_BenchmarkDrawing {
+public:
+    LC_BenchmarkDrawing(unsigned seed, int size);
+
+    /** Adds the entities to the given (empty) drawing. */
+    void create(RS_Graphic& graphic);
+
+    const std::vector<RS_Insert*>& getInserts() const {
+        return inserts;
+    }
+    const std::vector<RS_Hatch*>& getHatches() const {
+        return hatches;
+    }
+
+    /** @return a random point within the extent of the drawing */
+    RS_Vector randomPoint();
+    double random(double min, double max);
+
+private:
+    void createBlock(RS_Graphic& graphic);
+    void addBasicEntities(RS_EntityContainer& container, int count);
+    void addHatch(RS_Graphic& graphic, bool solid);
+
+    std::mt19937 generator;
+    int size = 0;
+    //! width and height of the area covered by entities
+    double extent = 0.;
+    std::vector<RS_Insert*> inserts;
+    std::vector<RS_Hatch*> hatches;
+};
+
+/**
+ * Runs the benchmark console tool:
+ *     librecad benchmark [options] [drawing files]
+ */
+int console_benchmark(int argc, char* argv[]);
+
+#endif // LC_BENCHMARK_H
@@ -49,6 +49,7 @@
 
 #include "console_dxf2pdf.h"
 #include "console_dxf2png.h"
+#include "lc_benchmark.h"
 
 namespace
 {
@@ -82,6 +83,9 @@ int main(int argc, char** argv)
         if (arg.compare("dxf2png") == 0 || arg == "dxf2svg") {
             return console_dxf2png(argc, argv);
         }
+        if (arg == "benchmark") {
+            return console_benchmark(argc, argv);
+        }
     }
 
     RS_DEBUG->setLevel(RS_Debug::D_WARNING);
@@ -121,6 +125,7 @@ int main(int argc, char** argv)
             qDebug()<<"  dxf2pdf\tRun librecad as console dxf2pdf tool. Use -h for help.";
             qDebug()<<"  dxf2png\tRun librecad as console dxf2png tool. Use -h for help.";
             qDebug()<<"  dxf2svg\tRun librecad as console dxf2svg tool. Use -h for help.";
+            qDebug()<<"  benchmark\tTime core operations on a generated drawing. Use -h for help.";
             qDebug()<<"";
             qDebug()<<"Options:";
             qDebug()<<"";
@@ -66,6 +66,7 @@
 #include "rs_debug.h"
 #include "rs_dialogfactory.h"
 #include "rs_document.h"
+#include "rs_grid.h"
 #include "rs_painterqt.h"
 #include "rs_pen.h"
 #include "rs_settings.h"
@@ -77,6 +78,7 @@
 #include "lc_actionfactory.h"
 #include "lc_actiongroupmanager.h"
 #include "lc_centralwidget.h"
+#include "lc_profiler.h"
 #include "lc_penwizard.h"
 #include "lc_printing.h"
 #include "lc_widgetfactory.h"
@@ -2921,6 +2923,40 @@ void QC_ApplicationWindow::slotViewStatusBar(bool toggle) {
     statusBar()->setVisible(toggle);
 }
 
+void QC_ApplicationWindow::slotViewProfilerOverlay(bool toggle) {
+    RS_DEBUG->print("QC_ApplicationWindow::slotViewProfilerOverlay()");
+
+    LC_Profiler* profiler = LC_Profiler::instance();
+    profiler->resetStatistics();
+    profiler->setStatisticsEnabled(toggle);
+    redrawAll();
+}
+
+void QC_ApplicationWindow::slotRecordTrace(bool toggle) {
+    RS_DEBUG->print("QC_ApplicationWindow::slotRecordTrace()");
+
+    LC_Profiler* profiler = LC_Profiler::instance();
+    if (toggle) {
+        profiler->startTrace();
+        RS_DIALOGFACTORY->commandMessage(tr("Recording a performance trace"));
+        return;
+    }
+    if (!profiler->isTracing())
+        return;
+
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Save Performance Trace"),
+                                                    QDir::homePath() + "/librecad-trace.json",
+                                                    tr("Chrome trace (*.json)"));
+    if (!fileName.isEmpty() && !fileName.endsWith(".json", Qt::CaseInsensitive))
+        fileName += ".json";
+    if (!profiler->stopTrace(fileName)) {
+        QMessageBox::warning(this, tr("Save Performance Trace"),
+                             tr("Cannot write the trace file %1").arg(fileName));
+    } else if (!fileName.isEmpty()) {
+        RS_DIALOGFACTORY->commandMessage(tr("Performance trace saved to %1").arg(fileName));
+    }
+}
+
 /**
  * Shows the dialog for general application preferences.
  */
@@ -2963,6 +2999,7 @@ void QC_ApplicationWindow::slotOptionsGeneral() {
                 gv->setRelativeZeroColor(relativeZeroColor);
                 gv->setRelativeZeroHiddenState(hideRelativeZero);
                 gv->setAntialiasing(antialiasing);
+                gv->getGrid()->loadSettings();
                 gv->redraw(RS2::RedrawGrid);
             }
         }
@@ -194,6 +194,10 @@ public slots:
     void slotViewDraft(bool toggle);
     /** toggle the statusbar */
     void slotViewStatusBar(bool toggle);
+    /** toggle the frame time overlay of the drawings */
+    void slotViewProfilerOverlay(bool toggle);
+    /** starts recording a performance trace, or saves it when toggled off */
+    void slotRecordTrace(bool toggle);
 
     void slotOptionsGeneral();
 
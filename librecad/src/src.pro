@@ -137,8 +137,10 @@ HEADERS += \
     actions/lc_actiondrawstar.h \
     actions/lc_actioninfopickcoordinates.h \
     actions/lc_actioninfoproperties.h \
+    actions/lc_actionmodifybreakatintersections.h \
     actions/lc_actionmodifybreakdivide.h \
     actions/lc_actionmodifyduplicate.h \
+    actions/lc_actionmodifyremoveduplicates.h \
     actions/lc_actionmodifylinegap.h \
     actions/lc_actionpenapply.h \
     actions/lc_actionpenpick.h \
@@ -157,8 +159,16 @@ HEADERS += \
     lib/actions/rs_previewactioninterface.h \
     lib/actions/rs_snapper.h \
     lib/creation/rs_creation.h \
+    lib/debug/lc_profiler.h \
     lib/debug/rs_debug.h \
+    lib/engine/lc_bulkgeometry.h \
+    lib/engine/lc_containertraverser.h \
+    lib/engine/lc_entitypool.h \
+    lib/engine/lc_layerindex.h \
+    lib/engine/lc_imagepyramid.h \
+    lib/engine/lc_imageloader.h \
     lib/engine/lc_looputils.h \
+    lib/engine/lc_parallel.h \
     lib/engine/lc_parabola.h \
     lib/engine/rs.h \
     lib/engine/rs_arc.h \
@@ -240,13 +250,21 @@ HEADERS += \
     lib/information/rs_locale.h \
     lib/information/rs_information.h \
     lib/information/rs_infoarea.h \
+    lib/information/lc_intersectionfinder.h \
+    lib/math/lc_affinetransform.h \
+    lib/math/lc_expressioncache.h \
     lib/math/lc_linemath.h \
+    lib/modification/lc_contouroffset.h \
+    lib/modification/lc_geometrycleanup.h \
     lib/modification/rs_modification.h \
     lib/modification/rs_selection.h \
     lib/math/rs_math.h \
     lib/math/lc_quadratic.h \
+    lib/math/lc_segmentdistance.h \
     actions/lc_actiondrawcircle2pr.h \
     main/console_dxf2png.h \
+    main/lc_batchconverter.h \
+    main/lc_benchmark.h \
     test/lc_simpletests.h \
     lib/generators/lc_makercamsvg.h \
     lib/generators/lc_xmlwriterinterface.h \
@@ -314,8 +332,10 @@ SOURCES += \
     actions/lc_actiondrawstar.cpp \
     actions/lc_actioninfopickcoordinates.cpp \
     actions/lc_actioninfoproperties.cpp \
+    actions/lc_actionmodifybreakatintersections.cpp \
     actions/lc_actionmodifybreakdivide.cpp \
     actions/lc_actionmodifyduplicate.cpp \
+    actions/lc_actionmodifyremoveduplicates.cpp \
     actions/lc_actionmodifylinegap.cpp \
     actions/lc_actionpenapply.cpp \
     actions/lc_actionpenpick.cpp \
@@ -326,7 +346,14 @@ SOURCES += \
     lib/actions/rs_previewactioninterface.cpp \
     lib/actions/rs_snapper.cpp \
     lib/creation/rs_creation.cpp \
+    lib/debug/lc_profiler.cpp \
     lib/debug/rs_debug.cpp \
+    lib/engine/lc_bulkgeometry.cpp \
+    lib/engine/lc_containertraverser.cpp \
+    lib/engine/lc_entitypool.cpp \
+    lib/engine/lc_layerindex.cpp \
+    lib/engine/lc_imagepyramid.cpp \
+    lib/engine/lc_imageloader.cpp \
     lib/engine/lc_looputils.cpp \
     lib/engine/lc_parabola.cpp \
     lib/engine/rs_arc.cpp \
@@ -393,15 +420,23 @@ SOURCES += \
     lib/information/rs_locale.cpp \
     lib/information/rs_information.cpp \
     lib/information/rs_infoarea.cpp \
+    lib/information/lc_intersectionfinder.cpp \
+    lib/math/lc_affinetransform.cpp \
+    lib/math/lc_expressioncache.cpp \
     lib/math/lc_linemath.cpp \
     lib/math/rs_math.cpp \
     lib/math/lc_quadratic.cpp \
+    lib/math/lc_segmentdistance.cpp \
+    lib/modification/lc_contouroffset.cpp \
+    lib/modification/lc_geometrycleanup.cpp \
     lib/modification/rs_modification.cpp \
     lib/modification/rs_selection.cpp \
     lib/engine/rs_color.cpp \
     lib/engine/rs_pen.cpp \
     actions/lc_actiondrawcircle2pr.cpp \
     main/console_dxf2png.cpp \
+    main/lc_batchconverter.cpp \
+    main/lc_benchmark.cpp \
     test/lc_simpletests.cpp \
     lib/generators/lc_xmlwriterqxmlstreamwriter.cpp \
     lib/generators/lc_makercamsvg.cpp \
@@ -64,22 +64,27 @@ void QG_PolylineEquidistantOptions::setAction(RS_ActionInterface* a, bool update
 
         QString sd;
         QString sn;
+        QString sr;
 
         // settings from action:
         if (update) {
             sd = QString("%1").arg(action->getDist());
             sn = QString("%1").arg(action->getNumber());
+            sr = QString("%1").arg((int)action->isRoundCorners());
         }
         // settings from config file:
         else {
             RS_SETTINGS->beginGroup("/Draw");
             sd = RS_SETTINGS->readEntry("/PolylineEquidistantDist", "10.0");
             sn = RS_SETTINGS->readEntry("/PolylineEquidistantCopies", "1");
+            sr = RS_SETTINGS->readEntry("/PolylineEquidistantRound", "0");
             RS_SETTINGS->endGroup();
         }
 
 		ui->leDist->setText(sd);
 		ui->leNumber->setText(sn);
+		ui->cbRoundCorners->setChecked(sr=="1");
+		action->setRoundCorners(sr=="1");
     } else {
         RS_DEBUG->print(RS_Debug::D_ERROR,
                         "QG_PolylineEquidistantOptions::setAction: wrong action type");
@@ -92,6 +97,7 @@ void QG_PolylineEquidistantOptions::saveOptions() {
 //    std::cout<<"QG_PolylineEquidistantOptions::saveOptions(): saving /PolylineEquidistantDist="<<qPrintable(leDist->text())<<std::endl;
 	RS_SETTINGS->writeEntry("/PolylineEquidistantDist", ui->leDist->text());
 	RS_SETTINGS->writeEntry("/PolylineEquidistantCopies", ui->leNumber->text());
+	RS_SETTINGS->writeEntry("/PolylineEquidistantRound", (int)ui->cbRoundCorners->isChecked());
     RS_SETTINGS->endGroup();
 }
 
@@ -120,3 +126,9 @@ void QG_PolylineEquidistantOptions::updateNumber() {
 		action->setNumber(i);
 	}
 }
+
+void QG_PolylineEquidistantOptions::updateRoundCorners(bool round) {
+	if (action) {
+		action->setRoundCorners(round);
+	}
+}
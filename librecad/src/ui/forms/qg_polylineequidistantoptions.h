@@ -50,6 +50,7 @@ public slots:
 	virtual void setAction(RS_ActionInterface * a, bool update);
 	virtual void updateDist();
 	virtual void updateNumber();
+	virtual void updateRoundCorners(bool round);
 
 protected:
     RS_ActionPolylineEquidistant* action;
@@ -829,6 +829,21 @@ void LC_ActionFactory::fillActionContainer(QMap<QString, QAction*>& a_map, LC_Ac
     action->setData("divide, cut, div");
     a_map["ModifyCut"] = action;
 
+    action = new QAction(tr("Break at &Intersections"), agm->modify);
+    action->setIcon(QIcon(":/icons/break_out_trim.svg"));
+    connect(action, SIGNAL(triggered()),
+    action_handler, SLOT(slotModifyBreakAtIntersections()));
+    action->setObjectName("ModifyBreakAtIntersections");
+    action->setData("breakall, bri");
+    a_map["ModifyBreakAtIntersections"] = action;
+
+    action = new QAction(tr("Remove D&uplicates"), agm->modify);
+    connect(action, SIGNAL(triggered()),
+    action_handler, SLOT(slotModifyRemoveDuplicates()));
+    action->setObjectName("ModifyRemoveDuplicates");
+    action->setData("overkill, removeduplicates");
+    a_map["ModifyRemoveDuplicates"] = action;
+
     action = new QAction(tr("&Stretch"), agm->modify);
     action->setIcon(QIcon(":/icons/stretch.svg"));
     connect(action, SIGNAL(triggered()),
@@ -1340,6 +1355,20 @@ void LC_ActionFactory::fillActionContainer(QMap<QString, QAction*>& a_map, LC_Ac
     action->setObjectName("ViewStatusBar");
     a_map["ViewStatusBar"] = action;
 
+    action = new QAction(tr("&Profiler Overlay"), agm->view);
+    action->setCheckable(true);
+    action->setStatusTip(tr("Shows frame time and drawn entities on the drawing"));
+    connect(action, SIGNAL(toggled(bool)), main_window, SLOT(slotViewProfilerOverlay(bool)));
+    action->setObjectName("ViewProfilerOverlay");
+    a_map["ViewProfilerOverlay"] = action;
+
+    action = new QAction(tr("Record Performance &Trace"), agm->view);
+    action->setCheckable(true);
+    action->setStatusTip(tr("Records the time spent in drawing, snapping and loading to a trace file"));
+    connect(action, SIGNAL(toggled(bool)), main_window, SLOT(slotRecordTrace(bool)));
+    action->setObjectName("RecordTrace");
+    a_map["RecordTrace"] = action;
+
     action = new QAction(tr("Focus on &Command Line"), agm->view);
     action->setIcon(QIcon(":/main/editclear.png"));
     QList<QKeySequence> commandLineShortcuts;
@@ -928,24 +928,17 @@ void LC_LayerTreeWidget::noPrintAllLayers(){
  */
 void LC_LayerTreeWidget::removeEmptyLayers(){
 
-    // first we inspect all entities ao collect found layers in set
-    QSet<RS_Layer*> foundLayers;
-    for (auto en: *document) {
-        RS_Layer *l = en->getLayer(true);
-        if (l != nullptr){
-            foundLayers.insert(l);
-        }
+    // find layers without entities using the layer index of the graphic
+    RS_Graphic* graphic = document->getGraphic();
+    if (graphic == nullptr){
+        return;
     }
-
-    // compare layers provided by layers list with set of found layers
+    const LC_LayerIndex& layerIndex = graphic->getLayerIndex();
     QList<RS_Layer*> layersWithNoEntities;
     unsigned int layersCount = layerList->count();
     for (unsigned int i = 0; i< layersCount; i++){
         RS_Layer* l = layerList->at(i);
-        if (foundLayers.contains(l)){
-            // do nothing, some entities are found on this layer
-        }
-        else{
+        if (layerIndex.isEmpty(l)){
             layersWithNoEntities << l;
         }
     }
@@ -1439,9 +1432,11 @@ QList<RS_Layer *> LC_LayerTreeWidget::collectLayersForSelectedItem(){
 void LC_LayerTreeWidget::deselectEntitiesOnLockedLayer(RS_Layer *layer){
     if (!layer) return;
     if (!layer->isLocked()) return;
+    RS_Graphic* graphic = document->getGraphic();
+    if (graphic == nullptr) return;
 
-    for (auto e: *document) {
-        if (e && e->isVisible() && e->getLayer() == layer){
+    for (auto e: graphic->getLayerIndex().entities(layer)) {
+        if (e->isVisible()){
             if (view){
                 view->deleteEntity(e);
             }
@@ -1458,9 +1453,11 @@ void LC_LayerTreeWidget::deselectEntitiesOnLockedLayer(RS_Layer *layer){
  */
 void LC_LayerTreeWidget::deselectEntities(RS_Layer *layer){
     if (!layer) return;
+    RS_Graphic* graphic = document->getGraphic();
+    if (graphic == nullptr) return;
 
-    for (auto e: *document) {
-        if (e && e->isVisible() && e->getLayer() == layer){
+    for (auto e: graphic->getLayerIndex().entities(layer)) {
+        if (e->isVisible()){
             if (view){
                 view->deleteEntity(e);
             }
@@ -1572,16 +1569,22 @@ void LC_LayerTreeWidget::doSelectLayersEntities(QList<RS_Layer *> &layers){
     // NOTE:  actually, the more correct location for this logic is RS_Selection class or something like that...
     // yet leave it for now here to reduce amount of codebase modifications.
 
-    for (auto en: *document) {
-        if (en && en->isVisible() && !en->isSelected() && (!(en->getLayer() && en->getLayer()->isLocked()))){
-            RS_Layer *l = en->getLayer(true);
-            if (l != nullptr && layers.contains(l)){
-                if (view){
-                    view->deleteEntity(en);
-                }
-                en->setSelected(true);
-                if (view){
-                    view->drawEntity(en);
+    RS_Graphic* graphic = document->getGraphic();
+    if (graphic != nullptr){
+        // visit only the entities on the given layers
+        for (RS_Layer* layer: layers) {
+            if (layer == nullptr || layer->isLocked()){
+                continue;
+            }
+            for (auto en: graphic->getLayerIndex().entities(layer)) {
+                if (en->isVisible() && !en->isSelected()){
+                    if (view){
+                        view->deleteEntity(en);
+                    }
+                    en->setSelected(true);
+                    if (view){
+                        view->drawEntity(en);
+                    }
                 }
             }
         }
@@ -193,6 +193,8 @@ LC_WidgetFactory::LC_WidgetFactory(QC_ApplicationWindow* main_win,
             << a_map["ModifyBevel"]
             << a_map["ModifyRound"]
             << a_map["ModifyCut"]
+            << a_map["ModifyBreakAtIntersections"]
+            << a_map["ModifyRemoveDuplicates"]
             << a_map["ModifyStretch"]
             << a_map["ModifyEntity"]
             << a_map["ModifyAttributes"]
@@ -761,6 +763,9 @@ void LC_WidgetFactory::createMenus(QMenuBar* menu_bar)
     view_menu->addAction(a_map["ViewGrid"]);
     view_menu->addAction(a_map["ViewDraft"]);
     view_menu->addSeparator();
+    view_menu->addAction(a_map["ViewProfilerOverlay"]);
+    view_menu->addAction(a_map["RecordTrace"]);
+    view_menu->addSeparator();
     view_menu->addAction(a_map["ZoomRedraw"]);
     view_menu->addAction(a_map["ZoomIn"]);
     view_menu->addAction(a_map["ZoomOut"]);
@@ -194,7 +194,9 @@
 #include "lc_actiondrawlinepoints.h"
 #include "lc_actionmodifyduplicate.h"
 #include "lc_actiondrawstar.h"
+#include "lc_actionmodifybreakatintersections.h"
 #include "lc_actionmodifybreakdivide.h"
+#include "lc_actionmodifyremoveduplicates.h"
 #include "lc_actionmodifylinegap.h"
 #include "lc_actioninfoproperties.h"
 #include "lc_actioninfopickcoordinates.h"
@@ -752,6 +754,18 @@ RS_ActionInterface* QG_ActionHandler::setCurrentAction(RS2::ActionType id) {
 	case RS2::ActionModifyRevertDirectionNoSelect:
 		a = new RS_ActionModifyRevertDirection(*document, *view);
 		break;
+    case RS2::ActionModifyBreakAtIntersections:
+        if(!document->countSelected()){
+            a = new RS_ActionSelect(this, *document, *view, RS2::ActionModifyBreakAtIntersectionsNoSelect);
+            break;
+        }
+        // fall-through
+    case RS2::ActionModifyBreakAtIntersectionsNoSelect:
+        a = new LC_ActionModifyBreakAtIntersections(*document, *view);
+        break;
+    case RS2::ActionModifyRemoveDuplicates:
+        a = new LC_ActionModifyRemoveDuplicates(*document, *view);
+        break;
 	case RS2::ActionModifyRotate:
 		if(!document->countSelected()){
 			a = new RS_ActionSelect(this, *document, *view, RS2::ActionModifyRotateNoSelect);
@@ -1806,6 +1820,14 @@ void QG_ActionHandler::slotModifyRevertDirection() {
 	setCurrentAction(RS2::ActionModifyRevertDirection);
 }
 
+void QG_ActionHandler::slotModifyBreakAtIntersections() {
+    setCurrentAction(RS2::ActionModifyBreakAtIntersections);
+}
+
+void QG_ActionHandler::slotModifyRemoveDuplicates() {
+    setCurrentAction(RS2::ActionModifyRemoveDuplicates);
+}
+
 void QG_ActionHandler::slotModifyRotate() {
     setCurrentAction(RS2::ActionModifyRotate);
 }
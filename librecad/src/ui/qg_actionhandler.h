@@ -203,6 +203,8 @@ public slots:
 	void slotModifyMove();
 	void slotModifyScale();
 	void slotModifyRevertDirection();
+	void slotModifyBreakAtIntersections();
+	void slotModifyRemoveDuplicates();
 	void slotModifyRotate();
 	void slotModifyMirror();
 	void slotModifyMoveRotate();
@@ -43,6 +43,8 @@
 #include "qg_graphicview.h"
 #include "qg_scrollbar.h"
 
+#include "lc_profiler.h"
+
 #include "rs_actionblocksedit.h"
 #include "rs_actiondefault.h"
 #include "rs_actionmodifydelete.h"
@@ -434,6 +436,25 @@ void QG_GraphicView::redraw(RS2::RedrawMethod method) {
 }
 
 
+/**
+ * Redraws the drawing within the given area only, e.g. for an image
+ * which finished loading.
+ */
+void QG_GraphicView::redrawArea(const RS_Vector& v1, const RS_Vector& v2) {
+    const RS_Vector p1 = toGui(v1);
+    const RS_Vector p2 = toGui(v2);
+    // some space for line widths and selection handles
+    const int margin = 4;
+    QRect rect = QRect(QPoint(int(p1.x), int(p1.y)), QPoint(int(p2.x), int(p2.y)))
+            .normalized().adjusted(-margin, -margin, margin, margin)
+            .intersected(QRect(0, 0, getWidth(), getHeight()));
+    if (rect.isEmpty())
+        return;
+    redrawRect = redrawRect.united(rect);
+    update(rect);
+}
+
+
 void QG_GraphicView::resizeEvent(QResizeEvent* /*e*/) {
     RS_DEBUG->print("QG_GraphicView::resizeEvent begin");
     adjustOffsetControls();
@@ -1209,6 +1230,10 @@ void QG_GraphicView::layerActivated(RS_Layer *layer) {
  */
 void QG_GraphicView::paintEvent(QPaintEvent *)
 {
+    const bool profiling = LC_Profiler::isActive();
+    const std::int64_t frameStart = profiling ? LC_Profiler::now() : 0;
+    // the statistics cover all layers repainted in this pass
+    resetDrawStatistics();
 
     // Re-Create or get the layering pixmaps
     getPixmapForView(PixmapLayer1);
@@ -1218,6 +1243,7 @@ void QG_GraphicView::paintEvent(QPaintEvent *)
     // Draw Layer 1
     if (redrawMethod & RS2::RedrawGrid)
     {
+        LC_PROFILE_SCOPE("paint: grid layer");
         PixmapLayer1->fill(getBackground());
         RS_PainterQt painter1(PixmapLayer1.get());
         drawLayer1((RS_Painter*)&painter1);
@@ -1226,6 +1252,7 @@ void QG_GraphicView::paintEvent(QPaintEvent *)
 
     if (redrawMethod & RS2::RedrawDrawing)
     {
+        LC_PROFILE_SCOPE("paint: drawing layer");
         view_rect = LC_Rect(toGraph(0, 0),
                             toGraph(getWidth(), getHeight()));
         // DRaw layer 2
@@ -1242,9 +1269,35 @@ void QG_GraphicView::paintEvent(QPaintEvent *)
         drawLayer2((RS_Painter*)&painter2);
         painter2.end();
     }
+    else if (!redrawRect.isEmpty())
+    {
+        LC_PROFILE_SCOPE("paint: drawing layer (partial)");
+        // Redraw layer 2 within the redraw area only
+        partialRedrawArea = LC_Rect(toGraph(redrawRect.left(), redrawRect.bottom() + 1),
+                                    toGraph(redrawRect.right() + 1, redrawRect.top()));
+        partialRedraw = true;
+        RS_PainterQt painter2(PixmapLayer2.get());
+        painter2.setCompositionMode(QPainter::CompositionMode_Clear);
+        painter2.QPainter::fillRect(redrawRect, Qt::transparent);
+        painter2.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        painter2.setClipRect(redrawRect.x(), redrawRect.y(),
+                             redrawRect.width(), redrawRect.height());
+        if (antialiasing)
+        {
+            painter2.setRenderHint(QPainter::Antialiasing);
+        }
+        painter2.setDrawingMode(drawingMode);
+        painter2.setDrawSelectedOnly(false);
+        drawLayer2((RS_Painter*)&painter2);
+        painter2.setDrawSelectedOnly(true);
+        drawLayer2((RS_Painter*)&painter2);
+        painter2.end();
+        partialRedraw = false;
+    }
 
     if (redrawMethod & RS2::RedrawOverlay)
     {
+        LC_PROFILE_SCOPE("paint: overlay layer");
         PixmapLayer3->fill(Qt::transparent);
         RS_PainterQt painter3(PixmapLayer3.get());
         if (antialiasing)
@@ -1260,9 +1313,52 @@ void QG_GraphicView::paintEvent(QPaintEvent *)
     wPainter.drawPixmap(0,0,*PixmapLayer1);
     wPainter.drawPixmap(0,0,*PixmapLayer2);
     wPainter.drawPixmap(0,0,*PixmapLayer3);
+
+    if (profiling) {
+        LC_Profiler* profiler = LC_Profiler::instance();
+        profiler->frame(frameStart, LC_Profiler::now(),
+                        getDrawnEntities(), getCulledEntities());
+        if (profiler->isStatisticsEnabled())
+            drawProfilerOverlay(wPainter);
+    }
     wPainter.end();
 
     redrawMethod=RS2::RedrawNone;
+    redrawRect = QRect();
+}
+
+/**
+ * Shows the time of the last frame and snap, and the number of entities
+ * drawn and culled in the last redraw of the drawing.
+ */
+void QG_GraphicView::drawProfilerOverlay(QPainter& painter)
+{
+    const LC_Profiler* profiler = LC_Profiler::instance();
+    const LC_Profiler::Frame frame = profiler->getLastFrame();
+    const LC_Profiler::Statistic snap = profiler->getStatistic("RS_Snapper::snapPoint");
+    auto ms = [](std::int64_t ns) {
+        return QString::number(ns * 1e-6, 'f', 2);
+    };
+
+    const QString text = tr("Frame: %1 ms (average %2 ms)\nDrawn: %3, culled: %4\nSnap: %5 ms")
+            .arg(ms(frame.durationNs), ms(frame.averageNs))
+            .arg(frame.drawn).arg(frame.culled)
+            .arg(ms(snap.lastNs));
+
+    painter.save();
+    painter.resetTransform();
+    painter.setClipping(false);
+    QFont font = painter.font();
+    font.setStyleHint(QFont::Monospace);
+    font.setFamily("monospace");
+    painter.setFont(font);
+    const QRect bounds = painter.fontMetrics().boundingRect(QRect(0, 0, width(), height()),
+                                                            Qt::AlignLeft | Qt::AlignTop, text);
+    const QRect box = bounds.translated(8, 8).adjusted(-4, -4, 4, 4);
+    painter.fillRect(box, QColor(0, 0, 0, 160));
+    painter.setPen(Qt::white);
+    painter.drawText(box.adjusted(4, 4, -4, -4), Qt::AlignLeft | Qt::AlignTop, text);
+    painter.restore();
 }
 
 void QG_GraphicView::setAntialiasing(bool state)
@@ -59,6 +59,7 @@ public:
 	int getWidth() const override;
 	int getHeight() const override;
 	void redraw(RS2::RedrawMethod method=RS2::RedrawAll) override;
+	void redrawArea(const RS_Vector& v1, const RS_Vector& v2) override;
 	void adjustOffsetControls() override;
 	void adjustZoomControls() override;
 	void setBackground(const RS_Color& bg) override;
@@ -153,6 +154,8 @@ protected:
     std::unique_ptr<QPixmap> PixmapLayer3;  // Used for crosshair and actionitems
 	
 	RS2::RedrawMethod redrawMethod;
+	//! screen area of the drawing to redraw, if not the whole drawing
+	QRect redrawRect;
 		
     //! Keep tracks of if we are currently doing a high-resolution scrolling
     bool isSmoothScrolling;
@@ -161,6 +164,7 @@ protected:
 
 private:
     void addEditEntityEntry(QMouseEvent* event, QMenu& menu);
+    void drawProfilerOverlay(QPainter& painter);
     bool antialiasing{false};
     bool scrollbars{false};
     bool cursor_hiding{false};
@@ -8,6 +8,7 @@
 #include "document_interface.h"
 #include "plot.h"
 #include "plotdialog.h"
+#include <vector>
 #include <muParser.h>
 #include <QDebug>
 
@@ -73,27 +74,39 @@ void plot::execComm([[maybe_unused]] Document_Interface *doc, QWidget *parent, [
             p.SetExpr(toMUPString(endValue));
             endVal = p.Eval();
 
-            p.SetExpr(toMUPString(equation1));
-
             for(equationVariable = startVal; equationVariable <= endVal; equationVariable += stepSize)
-            {//calculate the values of the first equation
                 xValues.append(equationVariable);
-                yValues1.append(p.Eval());
+
+            // the equations are compiled once and evaluated in bulk mode
+            // with x and t bound to the array of all x values
+            std::vector<double> variables(xValues.cbegin(), xValues.cend());
+            std::vector<double> results(variables.size());
+            p.DefineVar(_T("x"), variables.data());
+            p.DefineVar(_T("t"), variables.data());
+
+            if (!variables.empty())
+            {//calculate the values of the first equation
+                p.SetExpr(toMUPString(equation1));
+                p.Eval(results.data(), static_cast<int>(results.size()));
+                for (double y: results)
+                    yValues1.append(y);
             }
 
-            if(!equation2.isEmpty())
+            if(!equation2.isEmpty() && !variables.empty())
             {//calculate the values of the second equation
                 p.SetExpr(toMUPString(equation2));
-                for(int i = 0; i < xValues.size(); ++i)
-                {
-                    equationVariable = xValues.at(i);
-                    yValues2.append(p.Eval());
-                }
+                p.Eval(results.data(), static_cast<int>(results.size()));
+                for (double y: results)
+                    yValues2.append(y);
             }
         }
         catch (mu::Parser::exception_type &e)
         {
             mu::console() << e.GetMsg() << std::endl;
+            // don't plot partial results
+            xValues.clear();
+            yValues1.clear();
+            yValues2.clear();
         }
 
         QList<double> const& xpoints=(equation2.isEmpty())?xValues:yValues1;